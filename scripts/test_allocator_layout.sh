@@ -0,0 +1,65 @@
+#!/bin/bash
+# Script para conferir que os alocadores de memória física (buddy,
+# first-fit e best-fit) não mudam o resultado dos programas: os
+# registradores finais de cada processo devem ser os da disposição fixa
+
+set -e
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+BUILD_DIR="${BUILD_DIR:-$PROJECT_ROOT/build}"
+SIMULADOR="$BUILD_DIR/simulador"
+OUTPUT_DIR="$BUILD_DIR/output/allocator"
+
+SCHEDULERS="${SCHEDULERS:-FCFS SJN PRIORITY RR}"
+ALLOCATORS="${ALLOCATORS:-buddy first-fit best-fit}"
+
+echo "========================================"
+echo "  TESTE DOS ALOCADORES DE MEMÓRIA"
+echo "  $ALLOCATORS"
+echo "========================================"
+echo
+
+# Verificar se o simulador existe
+if [ ! -f "$SIMULADOR" ]; then
+    echo "Erro: Simulador não encontrado em $SIMULADOR"
+    echo "Execute 'make' no diretório build primeiro."
+    exit 1
+fi
+
+# Registradores finais de cada processo, com o nome do processo; pc e mar
+# guardam endereços e mudam com a base escolhida pelo alocador
+final_registers() {
+    awk '/=== PROCESSO/ { name = $0 } /^[a-z][a-z0-9]* *: 0x/ && $1 != "pc" && $1 != "mar" { print name, $0 }' "$1"
+}
+
+cd "$BUILD_DIR"
+failures=0
+for scheduler in $SCHEDULERS; do
+    fixed="$OUTPUT_DIR/fixed_$scheduler"
+    mkdir -p "$fixed"
+    ./simulador --scheduler "$scheduler" --output "$fixed" > "$fixed/log.txt" 2>&1
+    for allocator in $ALLOCATORS; do
+        for segmentation in "" "--segmentation"; do
+            out="$OUTPUT_DIR/${allocator}${segmentation:+_seg}_$scheduler"
+            mkdir -p "$out"
+            ./simulador --scheduler "$scheduler" --allocator "$allocator" $segmentation \
+                --output "$out" > "$out/log.txt" 2>&1
+            label="$scheduler / $allocator${segmentation:+ (segmentação)}"
+            if diff <(final_registers "$fixed/resultados_$scheduler.dat") \
+                    <(final_registers "$out/resultados_$scheduler.dat") > "$out/registers.diff"; then
+                echo "  OK     $label"
+            else
+                echo "  FALHA  $label: registradores diferentes (${out#$PROJECT_ROOT/}/registers.diff)"
+                failures=$((failures + 1))
+            fi
+        done
+    done
+done
+
+echo
+if [ "$failures" -gt 0 ]; then
+    echo "$failures combinação(ões) com registradores diferentes da disposição fixa"
+    exit 1
+fi
+echo "Todos os alocadores reproduzem os registradores da disposição fixa!"
@@ -1,5 +1,6 @@
 #!/bin/bash
-# Script para testar e comparar políticas de cache FIFO vs LRU
+# Script para testar e comparar as políticas de substituição da cache
+# (FIFO, LRU, CLOCK, LFU, ARC, 2Q e SRRIP), com 1 e 8 cores
 
 set -e
 
@@ -10,10 +11,15 @@ SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
 PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
 BUILD_DIR="$PROJECT_ROOT/build"
 SIMULADOR="$BUILD_DIR/simulador"
+OUTPUT_DIR="$PROJECT_ROOT/build/output"
+
+# Políticas a comparar; a primeira é a referência da comparação
+POLICIES="${POLICIES:-FIFO LRU CLOCK LFU ARC 2Q SRRIP}"
+BASELINE="${POLICIES%% *}"
 
 echo "========================================"
 echo "  TESTE DE POLÍTICAS DE CACHE"
-echo "  FIFO vs LRU"
+echo "  $POLICIES"
 echo "========================================"
 echo
 
@@ -24,52 +30,57 @@ if [ ! -f "$SIMULADOR" ]; then
     exit 1
 fi
 
-# Criar diretórios de saída
-mkdir -p "$PROJECT_ROOT/build/output/fifo_1core"
-mkdir -p "$PROJECT_ROOT/build/output/lru_1core"
-mkdir -p "$PROJECT_ROOT/build/output/fifo_8cores"
-mkdir -p "$PROJECT_ROOT/build/output/lru_8cores"
+# Diretório de saída de uma política: build/output/<politica>_<n>core(s)
+output_for() {
+    local policy=$(echo "$1" | tr '[:upper:]' '[:lower:]')
+    local cores="$2"
+    if [ "$cores" -eq 1 ]; then
+        echo "$OUTPUT_DIR/${policy}_1core"
+    else
+        echo "$OUTPUT_DIR/${policy}_${cores}cores"
+    fi
+}
 
-echo "========== TESTE 1: Single-Core (1 core) =========="
-echo
+csv_for() {
+    if [ "$2" -eq 1 ]; then
+        echo "$(output_for "$1" "$2")/metrics_single.csv"
+    else
+        echo "$(output_for "$1" "$2")/metrics_multi.csv"
+    fi
+}
 
-# FIFO - 1 core
-echo "[1/4] Executando FIFO com 1 core..."
+total=$(( $(echo $POLICIES | wc -w) * 2 ))
+step=0
 cd "$BUILD_DIR"
-./simulador --cores 1 --replacement FIFO --scheduler FCFS \
-    --output "$PROJECT_ROOT/build/output/fifo_1core" \
-    > "$PROJECT_ROOT/build/output/fifo_1core/log.txt" 2>&1
-echo "      Concluído! Resultados em build/output/fifo_1core/"
-
-# LRU - 1 core
-echo "[2/4] Executando LRU com 1 core..."
-./simulador --cores 1 --replacement LRU --scheduler FCFS \
-    --output "$PROJECT_ROOT/build/output/lru_1core" \
-    > "$PROJECT_ROOT/build/output/lru_1core/log.txt" 2>&1
-echo "      Concluído! Resultados em build/output/lru_1core/"
-
-echo
-echo "========== TESTE 2: Multi-Core (8 cores) =========="
-echo
 
-# FIFO - 8 cores
-echo "[3/4] Executando FIFO com 8 cores..."
-./simulador --cores 8 --replacement FIFO --scheduler FCFS \
-    --output "$PROJECT_ROOT/build/output/fifo_8cores" \
-    > "$PROJECT_ROOT/build/output/fifo_8cores/log.txt" 2>&1
-echo "      Concluído! Resultados em build/output/fifo_8cores/"
+for cores in 1 8; do
+    if [ "$cores" -eq 1 ]; then
+        echo "========== TESTE: Single-Core (1 core) =========="
+    else
+        echo "========== TESTE: Multi-Core ($cores cores) =========="
+    fi
+    echo
 
-# LRU - 8 cores
-echo "[4/4] Executando LRU com 8 cores..."
-./simulador --cores 8 --replacement LRU --scheduler FCFS \
-    --output "$PROJECT_ROOT/build/output/lru_8cores" \
-    > "$PROJECT_ROOT/build/output/lru_8cores/log.txt" 2>&1
-echo "      Concluído! Resultados em build/output/lru_8cores/"
+    for policy in $POLICIES; do
+        step=$((step + 1))
+        out=$(output_for "$policy" "$cores")
+        mkdir -p "$out"
+        echo "[$step/$total] Executando $policy com $cores core(s)..."
+        ./simulador --cores "$cores" --replacement "$policy" --scheduler FCFS \
+            --output "$out" > "$out/log.txt" 2>&1
+        echo "      Concluído! Resultados em ${out#$PROJECT_ROOT/}/"
+    done
+    echo
+done
 
-echo
 echo "========== ANÁLISE DOS RESULTADOS =========="
 echo
 
+# Linha de dados (FCFS) do CSV, ignorando comentários e cabeçalho
+data_line() {
+    grep -v '^#' "$1" | tail -n +2 | head -n 1
+}
+
 # Função para extrair métricas do CSV
 extract_metrics() {
     local csv_file="$1"
@@ -80,8 +91,7 @@ extract_metrics() {
         return
     fi
     
-    # Pular comentários e cabeçalho, pegar linha de dados (FCFS)
-    local line=$(grep -v '^#' "$csv_file" | tail -n +2 | head -n 1)
+    local line=$(data_line "$csv_file")
     
     if [ -z "$line" ]; then
         echo "Nenhum dado encontrado em $csv_file"
@@ -95,74 +105,67 @@ extract_metrics() {
         "$policy_name" "$time" "$hit_rate" "$tput" "$cpu_util" "$ctx_sw"
 }
 
-echo "Single-Core (1 core):"
-extract_metrics "$PROJECT_ROOT/build/output/fifo_1core/metrics_single.csv" "FIFO"
-extract_metrics "$PROJECT_ROOT/build/output/lru_1core/metrics_single.csv" "LRU"
-
-echo
-echo "Multi-Core (8 cores):"
-extract_metrics "$PROJECT_ROOT/build/output/fifo_8cores/metrics_multi.csv" "FIFO"
-extract_metrics "$PROJECT_ROOT/build/output/lru_8cores/metrics_multi.csv" "LRU"
+for cores in 1 8; do
+    if [ "$cores" -eq 1 ]; then
+        echo "Single-Core (1 core):"
+    else
+        echo "Multi-Core ($cores cores):"
+    fi
+    for policy in $POLICIES; do
+        extract_metrics "$(csv_for "$policy" "$cores")" "$policy"
+    done
+    echo
+done
 
-echo
-echo "========== COMPARAÇÃO DETALHADA =========="
+echo "========== COMPARAÇÃO COM $BASELINE =========="
 echo
 
-# Calcular diferenças
+# Diferença de hit rate (pontos percentuais) e de tempo de cada política
+# em relação à referência
 calculate_improvement() {
-    local fifo_csv="$1"
-    local lru_csv="$2"
-    local cores_label="$3"
-    
-    if [ ! -f "$fifo_csv" ] || [ ! -f "$lru_csv" ]; then
+    local cores="$1"
+    local cores_label="$2"
+    local base_csv=$(csv_for "$BASELINE" "$cores")
+
+    if [ ! -f "$base_csv" ]; then
         echo "Arquivos não encontrados para comparação"
         return
     fi
-    
-    # Extrair dados (ignorar comentários)
-    local fifo_line=$(grep -v '^#' "$fifo_csv" | tail -n +2 | head -n 1)
-    local lru_line=$(grep -v '^#' "$lru_csv" | tail -n +2 | head -n 1)
-    
+
     # Extrair hit rates (campo 10) e tempos (campo 2)
-    local fifo_hit=$(echo "$fifo_line" | cut -d',' -f10)
-    local lru_hit=$(echo "$lru_line" | cut -d',' -f10)
-    
-    local fifo_time=$(echo "$fifo_line" | cut -d',' -f2)
-    local lru_time=$(echo "$lru_line" | cut -d',' -f2)
-    
-    echo "$cores_label:"
-    echo "  Cache Hit Rate:"
-    echo "    FIFO: $fifo_hit%"
-    echo "    LRU:  $lru_hit%"
-    
-    # Calcular melhoria usando bc
-    local hit_improvement=$(echo "scale=2; $lru_hit - $fifo_hit" | bc)
-    if (( $(echo "$hit_improvement > 0" | bc -l) )); then
-        echo "    → LRU é ${hit_improvement}% melhor"
-    else
-        echo "    → FIFO é $(echo "scale=2; -1 * $hit_improvement" | bc)% melhor"
-    fi
-    
-    echo "  Tempo de Execução:"
-    echo "    FIFO: ${fifo_time} ms"
-    echo "    LRU:  ${lru_time} ms"
-    
-    local time_improvement=$(echo "scale=2; (($fifo_time - $lru_time) / $fifo_time) * 100" | bc)
-    if (( $(echo "$time_improvement > 0" | bc -l) )); then
-        echo "    → LRU é ${time_improvement}% mais rápido"
-    else
-        echo "    → FIFO é $(echo "scale=2; -1 * $time_improvement" | bc)% mais rápido"
-    fi
+    local base_line=$(data_line "$base_csv")
+    local base_hit=$(echo "$base_line" | cut -d',' -f10)
+    local base_time=$(echo "$base_line" | cut -d',' -f2)
+
+    echo "$cores_label ($BASELINE: hit ${base_hit}%, ${base_time} ms):"
+    local best_policy="$BASELINE"
+    local best_hit="$base_hit"
+    for policy in $POLICIES; do
+        [ "$policy" = "$BASELINE" ] && continue
+        local csv=$(csv_for "$policy" "$cores")
+        [ -f "$csv" ] || continue
+
+        local line=$(data_line "$csv")
+        local hit=$(echo "$line" | cut -d',' -f10)
+        local time=$(echo "$line" | cut -d',' -f2)
+
+        # Calcular diferenças usando bc
+        local hit_diff=$(echo "scale=2; $hit - $base_hit" | bc)
+        local time_diff=$(echo "scale=2; (($base_time - $time) / $base_time) * 100" | bc)
+        printf "  %-6s Hit: %6.2f%% (%+6.2f) | Tempo: %10.2f ms (%+6.2f%% mais rápido)\n" \
+            "$policy" "$hit" "$hit_diff" "$time" "$time_diff"
+
+        if (( $(echo "$hit > $best_hit" | bc -l) )); then
+            best_policy="$policy"
+            best_hit="$hit"
+        fi
+    done
+    echo "  → Maior hit rate: $best_policy (${best_hit}%)"
     echo
 }
 
-calculate_improvement "$PROJECT_ROOT/build/output/fifo_1core/metrics_single.csv" \
-                     "$PROJECT_ROOT/build/output/lru_1core/metrics_single.csv" \
-                     "Single-Core (1 core)"
-
-calculate_improvement "$PROJECT_ROOT/build/output/fifo_8cores/metrics_multi.csv" \
-                     "$PROJECT_ROOT/build/output/lru_8cores/metrics_multi.csv" \
-                     "Multi-Core (8 cores)"
+calculate_improvement 1 "Single-Core (1 core)"
+calculate_improvement 8 "Multi-Core (8 cores)"
 
 echo "=========================================="
 echo "Teste concluído!"
@@ -0,0 +1,128 @@
+#ifndef BLOCK_CACHE_HPP
+#define BLOCK_CACHE_HPP
+/*
+  BlockCache.hpp
+  Cache de blocos básicos traduzidos por processo (motor de blocos do modo
+  funcional, ver BlockEngine.hpp).
+
+  - Um bloco básico começa em um PC e termina na primeira instrução de
+    controle (BEQ/BNE/BGT/J) ou no END, inclusive. Cada bloco guarda o vetor
+    compacto dos micro-ops pré-decodificados das suas instruções.
+  - Os blocos ficam num vetor e são encontrados pelo PC inicial (índice por
+    palavra da faixa de código). Cada bloco guarda ainda os blocos sucessores
+    nas arestas "desvio tomado" e "fall-through" (encadeamento), resolvidos na
+    primeira vez que a aresta é percorrida.
+  - A cache mantém uma cópia das palavras da faixa de código. Escritas nessa
+    faixa (MemoryManager::write) atualizam a cópia, invalidam os blocos que
+    contêm o endereço e desfazem todos os encadeamentos.
+*/
+#include <cstdint>
+#include <vector>
+#include "DecodeCache.hpp"
+
+struct TranslatedBlock {
+    static constexpr int32_t NO_BLOCK = -1;
+    enum Edge : uint8_t { TAKEN = 0, FALLTHROUGH = 1 };
+
+    uint32_t start = 0;              // PC da primeira instrução
+    uint32_t end = 0;                // PC logo após a última instrução
+    std::vector<MicroOp> ops;
+    int32_t next[2] = { NO_BLOCK, NO_BLOCK }; // sucessores encadeados (por Edge)
+    bool valid = false;
+};
+
+class BlockCache {
+public:
+    // Faixa de código [begin, end) e suas palavras (words[i] no PC begin + 4*i)
+    void configure(uint32_t begin, uint32_t end, const std::vector<uint32_t> &words) {
+        begin_ = begin;
+        end_ = (end > begin) ? end : begin;
+        code.assign((end_ - begin_ + 3) / 4, 0u);
+        for (size_t i = 0; i < code.size() && i < words.size(); ++i) code[i] = words[i];
+        blockAt.assign(code.size(), TranslatedBlock::NO_BLOCK);
+        blocks.clear();
+    }
+
+    // Índice do bloco válido que começa em pc, ou NO_BLOCK
+    int32_t find(uint32_t pc) const {
+        size_t idx;
+        if (!indexOf(pc, idx)) return TranslatedBlock::NO_BLOCK;
+        return blockAt[idx];
+    }
+
+    // Registra um bloco já traduzido e devolve seu índice
+    int32_t insert(TranslatedBlock &&block) {
+        size_t idx;
+        if (!indexOf(block.start, idx)) return TranslatedBlock::NO_BLOCK;
+        block.valid = true;
+        int32_t id = static_cast<int32_t>(blocks.size());
+        blocks.push_back(std::move(block));
+        blockAt[idx] = id;
+        translations_++;
+        return id;
+    }
+
+    TranslatedBlock& block(int32_t id) { return blocks[static_cast<size_t>(id)]; }
+
+    // Palavra de código atual no PC (a cópia mantida pela cache)
+    bool word(uint32_t pc, uint32_t &raw) const {
+        size_t idx;
+        if (!indexOf(pc, idx)) return false;
+        raw = code[idx];
+        return true;
+    }
+
+    // Chamado em toda escrita de memória do processo
+    void write(uint32_t address, uint32_t data) {
+        size_t idx;
+        if (!indexOf(address, idx)) return;
+        code[idx] = data;
+        bool any = false;
+        for (auto &b : blocks) {
+            if (b.valid && address >= b.start && address < b.end) {
+                b.valid = false;
+                size_t startIdx;
+                if (indexOf(b.start, startIdx)) blockAt[startIdx] = TranslatedBlock::NO_BLOCK;
+                any = true;
+            }
+        }
+        if (any) {
+            invalidations_++;
+            for (auto &b : blocks) b.next[0] = b.next[1] = TranslatedBlock::NO_BLOCK;
+        }
+    }
+
+    bool covers(uint32_t address) const { return address >= begin_ && address < end_; }
+    uint32_t begin() const { return begin_; }
+    uint32_t end() const { return end_; }
+
+    uint64_t translations() const { return translations_; }
+    uint64_t invalidations() const { return invalidations_; }
+    uint64_t chainedTransitions() const { return chained_; }
+    uint64_t executedBlocks() const { return executed_; }
+    void recordExecution(bool chained) {
+        executed_++;
+        if (chained) chained_++;
+    }
+
+private:
+    bool indexOf(uint32_t address, size_t &idx) const {
+        if (address < begin_ || address >= end_) return false;
+        uint32_t off = address - begin_;
+        if (off & 3u) return false;
+        idx = off >> 2;
+        return true;
+    }
+
+    uint32_t begin_ = 0;
+    uint32_t end_ = 0;
+    std::vector<uint32_t> code;        // cópia das palavras da faixa de código
+    std::vector<int32_t> blockAt;      // PC -> bloco que começa nele
+    std::vector<TranslatedBlock> blocks;
+    uint64_t translations_ = 0;
+    uint64_t invalidations_ = 0;
+    uint64_t chained_ = 0;
+    uint64_t executed_ = 0;
+};
+
+#endif // BLOCK_CACHE_HPP
@@ -0,0 +1,210 @@
+#include "BlockEngine.hpp"
+#include "CONTROL_UNIT.hpp"
+#include "PCB.hpp"
+#include "ULA.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
+
+#include <algorithm>
+#include <string>
+
+static const uint32_t END_SENTINEL = 0xFC000000u;
+
+static bool isEnd(const MicroOp &u) { return u.raw == END_SENTINEL; }
+
+static bool isControl(const MicroOp &u) {
+    return u.op == Opcode::BEQ || u.op == Opcode::BNE || u.op == Opcode::BGT || u.op == Opcode::J;
+}
+
+// Traduz o bloco que começa em pc (até o primeiro desvio/END ou o fim da faixa de código)
+static int32_t Translate(BlockCache &cache, uint32_t pc) {
+    TranslatedBlock block;
+    block.start = pc;
+    uint32_t at = pc;
+    uint32_t raw;
+    while (cache.word(at, raw)) {
+        MicroOp u = Control_Unit::Predecode(raw);
+        block.ops.push_back(u);
+        at += 4;
+        if (isControl(u) || isEnd(u)) break;
+    }
+    block.end = at;
+    if (block.ops.empty()) return TranslatedBlock::NO_BLOCK;
+    return cache.insert(std::move(block));
+}
+
+static int32_t LookupOrTranslate(BlockCache &cache, uint32_t pc) {
+    int32_t id = cache.find(pc);
+    return (id != TranslatedBlock::NO_BLOCK) ? id : Translate(cache, pc);
+}
+
+void DiscoverBlocks(BlockCache &cache) {
+    std::vector<bool> leader((cache.end() - cache.begin()) / 4, false);
+    auto mark = [&](uint32_t pc) {
+        if (cache.covers(pc) && ((pc - cache.begin()) & 3u) == 0) leader[(pc - cache.begin()) / 4] = true;
+    };
+
+    mark(cache.begin());
+    uint32_t raw;
+    for (uint32_t pc = cache.begin(); cache.word(pc, raw); pc += 4) {
+        MicroOp u = Control_Unit::Predecode(raw);
+        if (isControl(u)) mark(u.uimm);
+        if (isControl(u) || isEnd(u)) mark(pc + 4);
+    }
+
+    for (size_t i = 0; i < leader.size(); ++i) {
+        uint32_t pc = cache.begin() + static_cast<uint32_t>(i) * 4u;
+        if (leader[i] && cache.find(pc) == TranslatedBlock::NO_BLOCK) Translate(cache, pc);
+    }
+}
+
+int RunBlocks(MemoryManager &memoryManager, PCB &process, std::vector<std::unique_ptr<IORequest>> &ioRequests,
+              bool printLock, int clock, uint64_t stopAtInstruction, bool stopAtPc, uint32_t stopPc, bool &halted) {
+    BlockCache &cache = process.block_cache;
+    hw::REGISTER_BANK &registers = process.regBank;
+
+    halted = false;
+    uint32_t pc = registers.pc.read();
+    int32_t id = LookupOrTranslate(cache, pc);
+    bool chained = false;
+    bool executedAny = false;
+    uint32_t lastPc = 0;
+    uint32_t lastRaw = 0;
+
+    while (id != TranslatedBlock::NO_BLOCK && clock < process.quantum) {
+        uint64_t count = static_cast<uint64_t>(process.instruction_count);
+        if (count >= stopAtInstruction) break;
+        if (stopAtPc && pc == stopPc) break;
+
+        TranslatedBlock *block = &cache.block(id);
+        size_t limit = block->ops.size();
+        limit = std::min<size_t>(limit, static_cast<size_t>(process.quantum - clock));
+        limit = std::min<uint64_t>(limit, stopAtInstruction - count);
+        if (stopAtPc && stopPc > pc && stopPc < block->end) {
+            limit = std::min<size_t>(limit, (stopPc - pc) / 4);
+        }
+        cache.recordExecution(chained);
+
+        size_t n = 0;
+        uint32_t next = 0;
+        bool redirected = false;    // PC definido pela própria instrução (desvio tomado ou END)
+        bool selfModified = false;  // SW escreveu no próprio bloco
+        int edge = TranslatedBlock::FALLTHROUGH;
+
+        while (n < limit) {
+            const MicroOp &u = block->ops[n];
+            const uint32_t at = pc + 4u * static_cast<uint32_t>(n);
+            n++;
+            lastPc = at;
+            lastRaw = u.raw;
+
+            if (isEnd(u)) {
+                // Mesmo efeito do Fetch do END: conta a instrução e não avança o PC
+                process.state = State::Finished;
+                halted = true;
+                redirected = true;
+                next = at;
+                break;
+            }
+
+            switch (u.op) {
+                case Opcode::ADD: case Opcode::SUB: case Opcode::MULT: case Opcode::DIV: {
+                    ALU alu;
+                    alu.A = registers.read(u.rs);
+                    alu.B = registers.read(u.rt);
+                    alu.op = (u.op == Opcode::ADD) ? ADD : (u.op == Opcode::SUB) ? SUB
+                           : (u.op == Opcode::MULT) ? MUL : DIV;
+                    alu.calculate();
+                    registers.write(u.rd, alu.result);
+                    break;
+                }
+                case Opcode::ADDI: case Opcode::ADDIU:
+                    // Soma de 32 bits com wrap, como a ULA
+                    registers.write(u.rt, registers.read(u.rs) + static_cast<uint32_t>(u.imm));
+                    break;
+                case Opcode::SLTI:
+                    registers.write(u.rt, (static_cast<int32_t>(registers.read(u.rs)) < u.imm) ? 1u : 0u);
+                    break;
+                case Opcode::LUI:
+                    registers.write(u.rt, (u.uimm & 0xFFFFu) << 16);
+                    break;
+                case Opcode::LW:
+                    registers.write(u.rt, memoryManager.read(u.uimm, process, at));
+                    break;
+                case Opcode::SW:
+                    memoryManager.write(u.uimm, registers.read(u.rt), process, at);
+                    if (!block->valid) selfModified = true;
+                    break;
+                case Opcode::PRINT:
+                    if (u.has(FIELD_RT)) {
+                        auto req = std::make_unique<IORequest>();
+                        req->msg = std::to_string(static_cast<int>(registers.read(u.rt)));
+                        req->process = &process;
+                        ioRequests.push_back(std::move(req));
+                        if (printLock) {
+                            process.state = State::Blocked;
+                            halted = true;
+                        }
+                    }
+                    break;
+                case Opcode::BEQ: case Opcode::BNE: case Opcode::BGT: {
+                    ALU alu;
+                    alu.A = registers.read(u.rs);
+                    alu.B = registers.read(u.rt);
+                    alu.op = (u.op == Opcode::BEQ) ? BEQ : (u.op == Opcode::BNE) ? BNE : BGT;
+                    alu.calculate();
+                    if (alu.result == 1) {
+                        redirected = true;
+                        next = u.uimm;
+                        edge = TranslatedBlock::TAKEN;
+                    }
+                    break;
+                }
+                case Opcode::J:
+                    redirected = true;
+                    next = u.uimm;
+                    edge = TranslatedBlock::TAKEN;
+                    break;
+                default:
+                    break; // sem efeito, como no pipeline
+            }
+            if (halted || selfModified) break;
+        }
+
+        if (!redirected) next = pc + 4u * static_cast<uint32_t>(n);
+        bool complete = (n == block->ops.size());
+
+        process.instruction_count += static_cast<int>(n);
+        process.functional_instructions += n;
+        process.pipeline_cycles.fetch_add(n);
+        clock += static_cast<int>(n);
+        executedAny = executedAny || n > 0;
+        pc = next;
+
+        if (halted) break;
+        if (selfModified) {
+            id = LookupOrTranslate(cache, pc);
+            chained = false;
+            continue;
+        }
+        if (!complete) break; // parou no meio do bloco (quantum ou ponto de parada)
+
+        // Encadeamento: segue direto para o sucessor já resolvido nesta aresta
+        int32_t successor = block->next[edge];
+        if (successor != TranslatedBlock::NO_BLOCK) {
+            chained = true;
+        } else {
+            successor = LookupOrTranslate(cache, pc); // pode realocar o vetor de blocos
+            if (successor != TranslatedBlock::NO_BLOCK) cache.block(id).next[edge] = successor;
+            chained = false;
+        }
+        id = successor;
+    }
+
+    registers.pc.write(pc);
+    if (executedAny) {
+        registers.mar.write(lastPc);
+        registers.ir.write(lastRaw);
+    }
+    return clock;
+}
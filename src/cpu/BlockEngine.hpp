@@ -0,0 +1,38 @@
+#ifndef BLOCK_ENGINE_HPP
+#define BLOCK_ENGINE_HPP
+/*
+  BlockEngine.hpp
+  Motor de execução por blocos básicos para o modo funcional do Core
+  (alternativa ao passo a passo Fetch/Decode de RunFunctional).
+
+  - DiscoverBlocks traduz, na carga do programa, os blocos que começam nos
+    líderes (início do código, alvos de desvio e instrução seguinte a cada
+    desvio). Blocos que começam em outros PCs (ex.: retomada no meio de um
+    bloco após o fim do quantum) são traduzidos sob demanda.
+  - RunBlocks executa os micro-ops de cada bloco em sequência e segue os
+    encadeamentos entre blocos sem consultar a tabela por PC.
+  - As instruções não são buscadas da memória: só LW/SW acessam o
+    MemoryManager. Os contadores de instruções e de ciclos (1 por instrução)
+    continuam iguais aos do passo a passo, mas as estatísticas de memória
+    deixam de incluir as buscas de instrução.
+*/
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BlockCache.hpp"
+
+class MemoryManager;
+struct PCB;
+struct IORequest;
+
+// Traduz os blocos a partir dos líderes do programa carregado na block_cache
+void DiscoverBlocks(BlockCache &cache);
+
+// Executa o processo bloco a bloco a partir do ciclo `clock` do quantum. Para
+// no fim do quantum, no fim do programa/bloqueio em PRINT (halted), antes da
+// instrução de número stopAtInstruction ou, se stopAtPc, antes de executar a
+// instrução no PC stopPc. Retorna o ciclo em que parou.
+int RunBlocks(MemoryManager &memoryManager, PCB &process, std::vector<std::unique_ptr<IORequest>> &ioRequests,
+              bool printLock, int clock, uint64_t stopAtInstruction, bool stopAtPc, uint32_t stopPc, bool &halted);
+
+#endif // BLOCK_ENGINE_HPP
@@ -6,8 +6,8 @@
 #include "PCB.hpp"
 #include "../IO/IOManager.hpp"
 #include "../memory/MemoryUsageTracker.hpp"
+#include "BlockEngine.hpp"
 
-#include <bitset>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
@@ -16,20 +16,12 @@
 #include <vector>
 #include <fstream>
 #include <mutex>
+#include <array>
+#include <chrono>
 
 using namespace std;
 
 // Helpers
-static uint32_t binaryStringToUint(const std::string &bin) {
-    uint32_t value = 0;
-    for (char c : bin) {
-        value <<= 1;
-        if (c == '1') value |= 1u;
-        else if (c != '0') throw std::invalid_argument("binaryStringToUint: char nao binario");
-    }
-    return value;
-}
-
 static int32_t signExtend16(uint16_t v) {
     if (v & 0x8000)
         return (int32_t)(0xFFFF0000u | v);
@@ -37,46 +29,36 @@ static int32_t signExtend16(uint16_t v) {
         return (int32_t)(v & 0x0000FFFFu);
 }
 
-static std::string regIndexToBitString(uint32_t idx) {
-    std::string s(5, '0');
-    for (int i = 4; i >= 0; --i) {
-        s[4 - i] = ((idx >> i) & 1) ? '1' : '0';
-    }
-    return s;
-}
-
-static std::string toBinStr(uint32_t v, int width) {
-    std::string s(width, '0');
-    for (int i = 0; i < width; ++i)
-        s[width - 1 - i] = ((v >> i) & 1) ? '1' : '0';
-    return s;
+// Instrumentação do pipeline. Com a política TraceFast as chamadas abaixo
+// somem em tempo de compilação (if constexpr), sem custo no laço do Core.
+template <typename Trace>
+static inline void account_stage(PCB &p) {
+    if constexpr (Trace::enabled) p.stage_invocations.fetch_add(1);
 }
-
 static inline void account_pipeline_cycle(PCB &p) { p.pipeline_cycles.fetch_add(1); }
-static inline void account_stage(PCB &p) { p.stage_invocations.fetch_add(1); }
-
-string Control_Unit::Get_immediate(const uint32_t instruction) {
-    uint16_t imm = static_cast<uint16_t>(instruction & 0xFFFFu);
-    return std::bitset<16>(imm).to_string();
-}
-
-string Control_Unit::Get_destination_Register(const uint32_t instruction) {
-    uint32_t rd = (instruction >> 11) & 0x1Fu;
-    return regIndexToBitString(rd);
-}
 
-string Control_Unit::Get_target_Register(const uint32_t instruction) {
-    uint32_t rt = (instruction >> 16) & 0x1Fu;
-    return regIndexToBitString(rt);
+// Grava um evento no trace binário do processo (formatado só no relatório)
+template <typename Trace>
+static inline void trace(PCB &p, TraceRecord &r) {
+    if constexpr (Trace::enabled) {
+        r.cycle = p.pipeline_cycles.load(std::memory_order_relaxed);
+        p.execution_trace.record(r);
+    }
 }
 
-string Control_Unit::Get_source_Register(const uint32_t instruction) {
-    uint32_t rs = (instruction >> 21) & 0x1Fu;
-    return regIndexToBitString(rs);
+// Registro base com os campos da instrução em execução
+static inline TraceRecord traceOf(TraceKind kind, const Instruction_Data &data) {
+    TraceRecord r;
+    r.kind = kind;
+    r.raw = data.rawInstruction;
+    r.op = data.uop.op;
+    r.rs = data.uop.rs;
+    r.rt = data.uop.rt;
+    r.rd = data.uop.rd;
+    return r;
 }
 
-string Control_Unit::Identificacao_instrucao(uint32_t instruction, hw::REGISTER_BANK &registers) {
-    (void)registers; // evita warning
+Opcode Control_Unit::Decode_opcode(uint32_t instruction) {
     uint32_t opcode = (instruction >> 26) & 0x3Fu;
     
     // Tratamento por opcode numérico (MIPS-like / convenções comuns)
@@ -84,53 +66,108 @@ string Control_Unit::Identificacao_instrucao(uint32_t instruction, hw::REGISTER_
     switch (opcode) {
         case 0x00: { // R-type: usa funct
             uint32_t funct = instruction & 0x3Fu;
-            if (funct == 0x20) return "ADD";
-            if (funct == 0x22) return "SUB";
-            if (funct == 0x18) return "MULT";
-            if (funct == 0x1A) return "DIV";
+            if (funct == 0x20) return Opcode::ADD;
+            if (funct == 0x22) return Opcode::SUB;
+            if (funct == 0x18) return Opcode::MULT;
+            if (funct == 0x1A) return Opcode::DIV;
             // não reconhecido -> vazio
-            return "";
+            return Opcode::INVALID;
         }
-        case 0x02: return "J";        // jump
-        case 0x03: return "JAL";
-        case 0x04: return "BEQ";
-        case 0x05: return "BNE";
-        case 0x07: return "BGT";      // 000111 (custom)
-        case 0x08: return "ADDI";     // 001000
-        case 0x09: return "ADDIU";    // 001001 (ou BLT custom)
-        case 0x0A: return "SLTI";     // 001010
-        case 0x0C: return "ANDI";     // 001100
-        case 0x0F: return "LUI";      // 001111
-        case 0x20: return "ADDI";     // 100000 (MIPS padrão para ADDI)
-        case 0x21: return "ADDIU";    // 100001 (MIPS padrão para ADDIU)
-        case 0x23: return "LW";       // 100011
-        case 0x2B: return "SW";       // 101011
-        case 0x3E: return "PRINT";    // 111110 (custom PRINT)
-        case 0x3F: return "END";      // 111111 (custom END)
+        case 0x02: return Opcode::J;        // jump
+        case 0x03: return Opcode::JAL;
+        case 0x04: return Opcode::BEQ;
+        case 0x05: return Opcode::BNE;
+        case 0x07: return Opcode::BGT;      // 000111 (custom)
+        case 0x08: return Opcode::ADDI;     // 001000
+        case 0x09: return Opcode::ADDIU;    // 001001 (ou BLT custom)
+        case 0x0A: return Opcode::SLTI;     // 001010
+        case 0x0C: return Opcode::ANDI;     // 001100
+        case 0x0F: return Opcode::LUI;      // 001111
+        case 0x20: return Opcode::ADDI;     // 100000 (MIPS padrão para ADDI)
+        case 0x21: return Opcode::ADDIU;    // 100001 (MIPS padrão para ADDIU)
+        case 0x23: return Opcode::LW;       // 100011
+        case 0x2B: return Opcode::SW;       // 101011
+        case 0x3E: return Opcode::PRINT;    // 111110 (custom PRINT)
+        case 0x3F: return Opcode::END;      // 111111 (custom END)
         default:
-            return ""; // desconhecido
+            return Opcode::INVALID; // desconhecido
     }
 }
 
+MicroOp Control_Unit::Predecode(uint32_t instruction) {
+    MicroOp uop;
+    uop.raw = instruction;
+    uop.op = Decode_opcode(instruction);
+
+    const uint8_t rs = static_cast<uint8_t>((instruction >> 21) & 0x1Fu);
+    const uint8_t rt = static_cast<uint8_t>((instruction >> 16) & 0x1Fu);
+    const uint8_t rd = static_cast<uint8_t>((instruction >> 11) & 0x1Fu);
+    const uint16_t imm16 = static_cast<uint16_t>(instruction & 0xFFFFu);
+
+    switch (uop.op) {
+        // R-type
+        case Opcode::ADD: case Opcode::SUB: case Opcode::MULT: case Opcode::DIV:
+            uop.rs = rs; uop.rt = rt; uop.rd = rd;
+            uop.fields = FIELD_RS | FIELD_RT | FIELD_RD;
+            break;
+
+        // I-type: ADDI, ADDIU, LW, SW, branches / custom immediates
+        case Opcode::ADDI: case Opcode::ADDIU: case Opcode::SLTI: case Opcode::LUI:
+        case Opcode::LW: case Opcode::SW:
+        case Opcode::BEQ: case Opcode::BNE: case Opcode::BGT:
+            uop.rs = rs;   // rs
+            uop.rt = rt;   // rt (destino para ADDI/LW)
+            uop.uimm = imm16;
+            uop.imm = signExtend16(imm16);
+            uop.fields = FIELD_RS | FIELD_RT | FIELD_IMM;
+            break;
+
+        case Opcode::J: {
+            uint32_t instr26 = instruction & 0x03FFFFFFu;
+            uop.uimm = instr26;
+            uop.imm = static_cast<int32_t>(instr26);
+            uop.fields = FIELD_IMM;
+            break;
+        }
+
+        case Opcode::PRINT:
+            uop.rt = rt;
+            uop.fields = FIELD_RT;
+            if (imm16 != 0) {
+                uop.uimm = imm16;
+                uop.imm = signExtend16(imm16);
+                uop.fields |= FIELD_IMM;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return uop;
+}
+
+template <typename Trace>
 void Control_Unit::Fetch(ControlContext &context) {
-    account_stage(context.process);
+    account_stage<Trace>(context.process);
     // MAR <- PC
     context.registers.mar.write(context.registers.pc.value);
     // Read memory at MAR (endereçamento em bytes presunção: PC em bytes)
-    uint32_t instr = context.memManager.read(context.registers.mar.read(), context.process);
+    uint32_t instr = context.memManager.fetch(context.registers.mar.read(), context.process);
     context.registers.ir.write(instr);
     // Conta que uma instrução foi buscada/executada (ajuda a detectar progresso)
     context.process.instruction_count++;
 
-    std::ostringstream oss;
-    oss << "[FETCH] PC=" << context.registers.pc.value
-        << " MAR=" << context.registers.mar.read()
-        << " INSTR=0x" << std::hex << instr << std::dec
-        << " (" << toBinStr(instr, 32) << ")";
-    context.process.execution_log.push_back(oss.str());
+    if constexpr (Trace::enabled) {
+        TraceRecord rec;
+        rec.kind = TraceKind::FETCH;
+        rec.pc = context.registers.mar.read();
+        rec.raw = instr;
+        trace<Trace>(context.process, rec);
+    }
 
     const uint32_t END_SENTINEL = 0b11111100000000000000000000000000u;
-    if (instr == END_SENTINEL) {
+    // END, ou busca negada pelo segmento de código: o processo termina aqui
+    if (instr == END_SENTINEL || (instr == MEMORY_ACCESS_ERROR && context.process.segment_fault)) {
         context.endProgram = true;
         context.endExecution = true;
         context.counterForEnd = 0;  // Força pipeline a parar imediatamente
@@ -140,287 +177,307 @@ void Control_Unit::Fetch(ControlContext &context) {
     // PC <- PC + 4 (endereçamento por byte)
     context.registers.pc.write(context.registers.pc.value + 4);
 }
+
+template <typename Trace>
 void Control_Unit::Decode(ControlContext &context, Instruction_Data &data) {
     uint32_t instruction = context.registers.ir.read();
-    data.rawInstruction = instruction;
-    data.op = Identificacao_instrucao(instruction, context.registers);
-
-    // R-type
-    if (data.op == "ADD" || data.op == "SUB" || data.op == "MULT" || data.op == "DIV") {
-        data.source_register = Get_source_Register(instruction);
-        data.target_register = Get_target_Register(instruction);
-        data.destination_register = Get_destination_Register(instruction);
-
-    // I-type: ADDI, ADDIU, LI, LW, LA, SW, and branches / custom immediates
-    } else if (data.op == "ADDI" || data.op == "ADDIU" ||
-               data.op == "LI" || data.op == "LW" || data.op == "LA" || data.op == "SW" ||
-               data.op == "BGTI" || data.op == "BLTI" || data.op == "BEQ" || data.op == "BNE" ||
-               data.op == "BGT"  || data.op == "BLT" || data.op == "SLTI" || data.op == "LUI") {
-
-        data.source_register = Get_source_Register(instruction);   // rs
-        data.target_register = Get_target_Register(instruction);   // rt (destino para ADDI/LW)
-        data.addressRAMResult = Get_immediate(instruction);
-        uint16_t imm16 = static_cast<uint16_t>(instruction & 0xFFFFu);
-        data.immediate = signExtend16(imm16);
-
-    } else if (data.op == "J") {
-        uint32_t instr26 = instruction & 0x03FFFFFFu;
-        data.addressRAMResult = std::bitset<26>(instr26).to_string();
-        data.immediate = static_cast<int32_t>(instr26);
-    } else if (data.op == "PRINT") {
-        data.target_register = Get_target_Register(instruction);
-        std::string imm = Get_immediate(instruction);
-        bool allZero = true;    
-        for (char c : imm) if (c != '0') { allZero = false; break; }
-        if (!allZero) {
-            data.addressRAMResult = imm;
-            uint16_t imm16 = static_cast<uint16_t>(binaryStringToUint(imm));
-            data.immediate = signExtend16(imm16);
-        } else {
-            data.addressRAMResult.clear();
-            data.immediate = 0;
-        }
-    }
-
-    std::ostringstream oss;
-    oss << "[DECODE] RAW=0x" << std::hex << data.rawInstruction << std::dec
-        << " OP=" << (data.op.empty() ? "<UNKNOWN>" : data.op);
-    if (!data.source_register.empty()) {
-        oss << " rs=" << this->map.getRegisterName(binaryStringToUint(data.source_register));
-    }
-    if (!data.target_register.empty()) {
-        oss << " rt=" << this->map.getRegisterName(binaryStringToUint(data.target_register));
-    }
-    if (!data.destination_register.empty()) {
-        oss << " rd=" << this->map.getRegisterName(binaryStringToUint(data.destination_register));
+    // MAR ainda guarda o endereço de onde IR foi buscado (PC da instrução)
+    uint32_t pc = context.registers.mar.read();
+
+    const MicroOp *cached = context.process.decode_cache.lookup(pc, instruction);
+    if (cached) {
+        data.uop = *cached;
+    } else {
+        data.uop = Predecode(instruction);
+        context.process.decode_cache.insert(pc, data.uop);
     }
-    if (!data.addressRAMResult.empty()) {
-        oss << " imm=" << data.immediate;
+    data.rawInstruction = instruction;
+    data.immediate = data.uop.imm;
+    data.pc = pc;
+
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::DECODE, data);
+        rec.pc = pc;
+        rec.fields = data.uop.fields;
+        rec.value = data.immediate;
+        trace<Trace>(context.process, rec);
     }
-    context.process.execution_log.push_back(oss.str());
 }
 
 
-void Control_Unit::Execute_Immediate_Operation(ControlContext &context, Instruction_Data &data) {
-    hw::REGISTER_BANK &registers = context.registers;
-    std::string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
-    std::string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-
-    int32_t val_rs = registers.readRegister(name_rs);
-    int32_t imm = data.immediate; // já sign-extended
-
-    std::ostringstream ss;
-
-    // ADDI / ADDIU
-    if (data.op == "ADDI" || data.op == "ADDIU") {
-        ALU alu;
-        alu.A = val_rs;
-        alu.B = imm;
-        alu.op = ADD;
-        alu.calculate();
-        registers.writeRegister(name_rt, alu.result);
-
-        ss << "[IMM] " << data.op << " "
-           << name_rt << " = " << name_rs << "(" << val_rs << ") + "
-           << imm << " -> " << alu.result;
-        context.process.execution_log.push_back(ss.str());
-        return;
+// Tabelas de despacho por opcode: cada estágio faz um único salto indexado
+// por data.uop.op em vez de comparar strings a cada ciclo. Há um conjunto de
+// tabelas por política de trace, apontando para os handlers instanciados nela.
+using StageTable = std::array<Control_Unit::StageHandler, OPCODE_COUNT>;
+
+static constexpr size_t opIndex(Opcode op) { return static_cast<size_t>(op); }
+
+template <typename Trace>
+struct StageTables {
+    static StageTable makeExecute() {
+        StageTable t;
+        t.fill(&Control_Unit::Stage_Nop);
+        for (Opcode op : {Opcode::ADD, Opcode::SUB, Opcode::MULT, Opcode::DIV})
+            t[opIndex(op)] = &Control_Unit::Execute_Aritmetic_Operation<Trace>;
+        for (Opcode op : {Opcode::ADDI, Opcode::ADDIU, Opcode::SLTI, Opcode::LUI})
+            t[opIndex(op)] = &Control_Unit::Execute_Immediate_Operation<Trace>;
+        for (Opcode op : {Opcode::BEQ, Opcode::BNE, Opcode::BGT, Opcode::J})
+            t[opIndex(op)] = &Control_Unit::Execute_Loop_Operation<Trace>;
+        t[opIndex(Opcode::PRINT)] = &Control_Unit::Execute_Operation<Trace>;
+        return t;
     }
 
-    // SLTI
-    if (data.op == "SLTI") {
-        int32_t res = (val_rs < imm) ? 1 : 0;
-        registers.writeRegister(name_rt, res);
+    static StageTable makeMemory() {
+        StageTable t;
+        t.fill(&Control_Unit::Stage_Nop);
+        t[opIndex(Opcode::LW)] = &Control_Unit::Memory_Load<Trace>;
+        return t;
+    }
 
-        ss << "[IMM] SLTI " << name_rt << " = (" << name_rs << "(" << val_rs
-           << ") < " << imm << ") ? 1 : 0 -> " << res;
-        context.process.execution_log.push_back(ss.str());
-        return;
+    static StageTable makeWriteBack() {
+        StageTable t;
+        t.fill(&Control_Unit::Stage_Nop);
+        t[opIndex(Opcode::SW)] = &Control_Unit::Write_Back_Store<Trace>;
+        return t;
     }
 
-    // LUI
-    if (data.op == "LUI") {
-        uint32_t uimm = static_cast<uint32_t>(static_cast<uint16_t>(imm));
-        int32_t val = static_cast<int32_t>(uimm << 16);
-        registers.writeRegister(name_rt, val);
+    static const StageTable execute;
+    static const StageTable memory;
+    static const StageTable writeBack;
+};
 
-        ss << "[IMM] LUI " << name_rt << " = (0x" << std::hex << imm
-           << " << 16) -> 0x" << val << std::dec;
-        context.process.execution_log.push_back(ss.str());
-        return;
-    }
+template <typename Trace> const StageTable StageTables<Trace>::execute = StageTables<Trace>::makeExecute();
+template <typename Trace> const StageTable StageTables<Trace>::memory = StageTables<Trace>::makeMemory();
+template <typename Trace> const StageTable StageTables<Trace>::writeBack = StageTables<Trace>::makeWriteBack();
 
-    // LI
-    if (data.op == "LI") {
-        registers.writeRegister(name_rt, imm);
+void Control_Unit::Stage_Nop(ControlContext &, Instruction_Data &) {}
 
-        ss << "[IMM] LI " << name_rt << " = " << imm;
-        context.process.execution_log.push_back(ss.str());
-        return;
+template <typename Trace>
+void Control_Unit::Execute_Immediate_Operation(ControlContext &context, Instruction_Data &data) {
+    hw::REGISTER_BANK &registers = context.registers;
+
+    int32_t val_rs = registers.read(data.uop.rs);
+    int32_t imm = data.uop.imm; // já sign-extended
+    int32_t result = 0;
+
+    switch (data.uop.op) {
+        case Opcode::ADDI:
+        case Opcode::ADDIU: {
+            ALU alu;
+            alu.A = val_rs;
+            alu.B = imm;
+            alu.op = ADD;
+            alu.calculate();
+            result = alu.result;
+            registers.write(data.uop.rt, result);
+            break;
+        }
+        case Opcode::SLTI:
+            result = (val_rs < imm) ? 1 : 0;
+            registers.write(data.uop.rt, result);
+            break;
+        case Opcode::LUI: {
+            uint32_t uimm = static_cast<uint32_t>(static_cast<uint16_t>(imm));
+            result = static_cast<int32_t>(uimm << 16);
+            registers.write(data.uop.rt, result);
+            break;
+        }
+        default:
+            // Caso não mapeado (registrado como UNKNOWN OP)
+            break;
     }
 
-    // Caso não mapeado
-    ss << "[IMM] UNKNOWN OP: " << data.op
-       << " rs=" << name_rs << " imm=" << imm;
-    context.process.execution_log.push_back(ss.str());
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::IMM, data);
+        rec.a = val_rs;
+        rec.b = imm;
+        rec.value = result;
+        trace<Trace>(context.process, rec);
+    }
 }
 
+template <typename Trace>
 void Control_Unit::Execute_Aritmetic_Operation(ControlContext &context, Instruction_Data &data) {
     hw::REGISTER_BANK &registers = context.registers;
-    std::string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
-    std::string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-    std::string name_rd = this->map.getRegisterName(binaryStringToUint(data.destination_register));
 
-    int32_t val_rs = registers.readRegister(name_rs);
-    int32_t val_rt = registers.readRegister(name_rt);
+    int32_t val_rs = registers.read(data.uop.rs);
+    int32_t val_rt = registers.read(data.uop.rt);
 
     ALU alu;
     alu.A = val_rs;
     alu.B = val_rt;
 
-    if (data.op == "ADD") alu.op = ADD;
-    else if (data.op == "SUB") alu.op = SUB;
-    else if (data.op == "MULT") alu.op = MUL;
-    else if (data.op == "DIV") alu.op = DIV;
-    else return;
+    switch (data.uop.op) {
+        case Opcode::ADD:  alu.op = ADD; break;
+        case Opcode::SUB:  alu.op = SUB; break;
+        case Opcode::MULT: alu.op = MUL; break;
+        case Opcode::DIV:  alu.op = DIV; break;
+        default: return;
+    }
 
     alu.calculate();
-    registers.writeRegister(name_rd, alu.result);
-
-    std::ostringstream ss;
-    ss << "[ARIT] " << data.op << " " << name_rd
-       << " = " << name_rs << "(" << val_rs << ") "
-       << data.op << " " << name_rt << "(" << val_rt << ") = "
-       << alu.result;
-    context.process.execution_log.push_back(ss.str());
+    registers.write(data.uop.rd, alu.result);
+
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::ARIT, data);
+        rec.a = val_rs;
+        rec.b = val_rt;
+        rec.value = alu.result;
+        trace<Trace>(context.process, rec);
+    }
 }
 
-void Control_Unit::Execute_Operation(Instruction_Data &data, ControlContext &context) {
-    if (data.op == "PRINT") {
-        if (!data.target_register.empty()) {
-            string name = this->map.getRegisterName(binaryStringToUint(data.target_register));
-            int value = context.registers.readRegister(name);
-            auto req = std::make_unique<IORequest>();
-            req->msg = std::to_string(value);
-            req->process = &context.process;
-            context.ioRequests.push_back(std::move(req));
-
-            std::ostringstream oss;
-            oss << "[IO-REQ] PRINT REG " << name << " value=" << value
-                << " (pid=" << context.process.pid << ")";
-            context.process.execution_log.push_back(oss.str());
-
-            if (context.printLock) {
-                context.process.state = State::Blocked;
-                context.endExecution = true;
-            }
-        }
+template <typename Trace>
+void Control_Unit::Execute_Operation(ControlContext &context, Instruction_Data &data) {
+    // PRINT de registrador (o decodificador sempre preenche rt para PRINT)
+    if (!data.uop.has(FIELD_RT)) return;
+
+    int value = context.registers.read(data.uop.rt);
+    auto req = std::make_unique<IORequest>();
+    req->msg = std::to_string(value);
+    req->process = &context.process;
+    context.ioRequests.push_back(std::move(req));
+
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::PRINT_REG, data);
+        rec.value = value;
+        trace<Trace>(context.process, rec);
+    }
+
+    if (context.printLock) {
+        context.process.state = State::Blocked;
+        context.endExecution = true;
     }
 }
 
+template <typename Trace>
 void Control_Unit::Execute_Loop_Operation(ControlContext &context, Instruction_Data &data) {
     hw::REGISTER_BANK &registers = context.registers;
     MemoryManager &memManager = context.memManager;
-    string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
-    string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
 
     ALU alu;
-    alu.A = registers.readRegister(name_rs);
-    alu.B = registers.readRegister(name_rt);
+    alu.A = registers.read(data.uop.rs);
+    alu.B = registers.read(data.uop.rt);
 
     bool jump = false;
-    if (data.op == "BEQ") { alu.op = BEQ; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "BNE") { alu.op = BNE; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "J") { jump = true; }
-    else if (data.op == "BLT") { alu.op = BLT; alu.calculate(); if (alu.result == 1) jump = true; }
-    else if (data.op == "BGT") { alu.op = BGT; alu.calculate(); if (alu.result == 1) jump = true; }
+    switch (data.uop.op) {
+        case Opcode::BEQ: alu.op = BEQ; alu.calculate(); jump = (alu.result == 1); break;
+        case Opcode::BNE: alu.op = BNE; alu.calculate(); jump = (alu.result == 1); break;
+        case Opcode::BGT: alu.op = BGT; alu.calculate(); jump = (alu.result == 1); break;
+        case Opcode::J:   jump = true; break;
+        default: break;
+    }
 
     if (jump) {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        std::ostringstream oss;
-        oss << "[BRANCH] OP=" << data.op << " taken, new PC=" << addr;
-        context.process.execution_log.push_back(oss.str());
+        uint32_t addr = data.uop.uimm;
+        if constexpr (Trace::enabled) {
+            TraceRecord rec = traceOf(TraceKind::BRANCH, data);
+            rec.addr = addr;
+            trace<Trace>(context.process, rec);
+        }
 
         registers.pc.write(addr);
-        registers.ir.write(memManager.read(registers.pc.read(), context.process));
+        registers.ir.write(memManager.fetch(registers.pc.read(), context.process));
         context.counter = 0; context.counterForEnd = 5; context.endProgram = false;
     }
 }
 
+void Control_Unit::Wait_Register(ControlContext &context, uint8_t reg) {
+    uint64_t &ready = load_ready[reg & (hw::REGISTER_BANK::NUM_GPR - 1)];
+    if (ready == 0) return;
+    context.memManager.waitForLoad(context.process, ready);
+    ready = 0;
+    pending_loads--;
+}
+
+void Control_Unit::Wait_Operands(ControlContext &context, const MicroOp &uop) {
+    // Conservador: espera também o destino (um load pendente não pode
+    // sobrescrever o resultado de uma instrução posterior)
+    if (uop.has(FIELD_RS)) Wait_Register(context, uop.rs);
+    if (uop.has(FIELD_RT)) Wait_Register(context, uop.rt);
+    if (uop.has(FIELD_RD)) Wait_Register(context, uop.rd);
+}
+
+template <typename Trace>
 void Control_Unit::Execute(Instruction_Data &data, ControlContext &context) {
-    account_stage(context.process);
+    account_stage<Trace>(context.process);
+    if (pending_loads > 0) Wait_Operands(context, data.uop);
+    (this->*StageTables<Trace>::execute[opIndex(data.uop.op)])(context, data);
+}
 
-    if (data.op == "ADDI" || data.op == "ADDIU" || data.op == "SLTI" || data.op == "LUI" || data.op == "LI") {
-        Execute_Immediate_Operation(context, data);
-        return;
+template <typename Trace>
+void Control_Unit::Memory_Load(ControlContext &context, Instruction_Data &data) {
+    uint32_t addr = data.uop.uimm;
+    int value;
+    if (overlap_misses) {
+        uint64_t ready = 0;
+        value = context.memManager.readNonBlocking(addr, context.process, ready, data.pc);
+        if (ready != 0) {
+            uint64_t &slot = load_ready[data.uop.rt & (hw::REGISTER_BANK::NUM_GPR - 1)];
+            if (slot == 0) pending_loads++;
+            slot = ready;
+        }
+    } else {
+        value = context.memManager.read(addr, context.process, data.pc);
     }
+    context.registers.write(data.uop.rt, value);
 
-    if (data.op == "ADD" || data.op == "SUB" || data.op == "MULT" || data.op == "DIV") {
-        Execute_Aritmetic_Operation(context, data);
-    } else if (data.op == "BEQ" || data.op == "J" || data.op == "BNE" || data.op == "BGT" || data.op == "BGTI" || data.op == "BLT" || data.op == "BLTI") {
-        Execute_Loop_Operation(context, data);
-    } else if (data.op == "PRINT") {
-        Execute_Operation(data, context);
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::LOAD, data);
+        rec.addr = addr;
+        rec.value = value;
+        trace<Trace>(context.process, rec);
     }
 }
 
+template <typename Trace>
 void Control_Unit::Memory_Acess(Instruction_Data &data, ControlContext &context) {
-    account_stage(context.process);
-    string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-    if (data.op == "LW") {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        int value = context.memManager.read(addr, context.process);
-        context.registers.writeRegister(name_rt, value);
-
-        std::ostringstream oss;
-        oss << "[MEMORY] LW addr=" << addr << " value=" << value << " -> " << name_rt;
-        context.process.execution_log.push_back(oss.str());
-    } else if (data.op == "LA" || data.op == "LI") {
-        uint32_t val = binaryStringToUint(data.addressRAMResult);
-        context.registers.writeRegister(name_rt, static_cast<int>(val));
-
-        std::ostringstream oss;
-        oss << "[MEMORY] " << data.op << " -> " << name_rt << " value=" << static_cast<int>(val);
-        context.process.execution_log.push_back(oss.str());
-    } else if (data.op == "PRINT" && data.target_register.empty()) {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        int value = context.memManager.read(addr, context.process);
-        auto req = std::make_unique<IORequest>();
-        req->msg = std::to_string(value);
-        req->process = &context.process;
-        context.ioRequests.push_back(std::move(req));
-
-        std::ostringstream oss;
-        oss << "[IO-REQ] PRINT MEM addr=" << addr << " value=" << value
-            << " (pid=" << context.process.pid << ")";
-        context.process.execution_log.push_back(oss.str());
-
-        if (context.printLock) {
-            context.process.state = State::Blocked;
-            context.endExecution = true;
-        }
-    }
+    account_stage<Trace>(context.process);
+    (this->*StageTables<Trace>::memory[opIndex(data.uop.op)])(context, data);
 }
 
-void Control_Unit::Write_Back(Instruction_Data &data, ControlContext &context) {
-    account_stage(context.process);
-    if (data.op == "SW") {
-        uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
-        int value = context.registers.readRegister(name_rt);
-        context.memManager.write(addr, value, context.process);
+template <typename Trace>
+void Control_Unit::Write_Back_Store(ControlContext &context, Instruction_Data &data) {
+    uint32_t addr = data.uop.uimm;
+    int value = context.registers.read(data.uop.rt);
+    if (overlap_misses) {
+        context.memManager.writeNonBlocking(addr, value, context.process, data.pc);
+    } else {
+        context.memManager.write(addr, value, context.process, data.pc);
+    }
 
-        std::ostringstream oss;
-        oss << "[WRITE-BACK] SW addr=" << addr << " value=" << value << " from reg " << name_rt;
-        context.process.execution_log.push_back(oss.str());
+    if constexpr (Trace::enabled) {
+        TraceRecord rec = traceOf(TraceKind::STORE, data);
+        rec.addr = addr;
+        rec.value = value;
+        trace<Trace>(context.process, rec);
     }
 }
 
-// A função Core agora espera um ponteiro para o PCB, pois o PCB não é mais copiável
-void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock) {
-    Control_Unit UC;
-    Instruction_Data data;
-    int clock = 0;
+template <typename Trace>
+void Control_Unit::Write_Back(Instruction_Data &data, ControlContext &context) {
+    account_stage<Trace>(context.process);
+    (this->*StageTables<Trace>::writeBack[opIndex(data.uop.op)])(context, data);
+}
+
+// Instâncias dos estágios para as duas políticas de trace
+#define INSTANTIATE_STAGES(Trace)                                                        \
+    template void Control_Unit::Fetch<Trace>(ControlContext &);                          \
+    template void Control_Unit::Decode<Trace>(ControlContext &, Instruction_Data &);     \
+    template void Control_Unit::Execute<Trace>(Instruction_Data &, ControlContext &);    \
+    template void Control_Unit::Memory_Acess<Trace>(Instruction_Data &, ControlContext &); \
+    template void Control_Unit::Write_Back<Trace>(Instruction_Data &, ControlContext &);
+INSTANTIATE_STAGES(TraceFull)
+INSTANTIATE_STAGES(TraceFast)
+#undef INSTANTIATE_STAGES
+
+// Laço do pipeline, instanciado uma vez por política de trace.
+// Roda o pipeline a partir do ciclo `clock` do quantum até o fim do quantum,
+// o fim do programa/bloqueio (halted) ou até buscar a instrução stopAtInstruction
+// (as instruções em voo são drenadas). Retorna o ciclo em que parou.
+template <typename Trace>
+static int RunPipeline(Control_Unit &UC, MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+                       int clock, uint64_t stopAtInstruction, bool &halted) {
     int counterForEnd = 5;
     int counter = 0;
     bool endProgram = false;
@@ -429,7 +486,12 @@ void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IOReque
     ControlContext context{ process.regBank, memoryManager, *ioRequests, printLock, process, counter, counterForEnd, endProgram, endExecution };
 
     // Captura snapshot inicial
-    MemoryUsageTracker::recordSnapshot(process, 0, process.base_address);
+    if constexpr (Trace::enabled) {
+        MemoryUsageTracker::recordSnapshot(process, 0, process.base_address);
+    }
+
+    // Loads e stores não bloqueiam no miss (se houver MSHRs)
+    UC.overlap_misses = true;
 
     // Intervalo para capturar snapshots (a cada 10 ciclos de pipeline)
     const int SNAPSHOT_INTERVAL = 10;
@@ -437,21 +499,21 @@ void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IOReque
 
     while (context.counterForEnd > 0) {
         if (context.counter >= 4 && context.counterForEnd >= 1) {
-            UC.Write_Back(UC.data[context.counter - 4], context);
+            UC.Write_Back<Trace>(UC.latch(context.counter - 4), context);
         }
         if (context.counter >= 3 && context.counterForEnd >= 2) {
-            UC.Memory_Acess(UC.data[context.counter - 3], context);
+            UC.Memory_Acess<Trace>(UC.latch(context.counter - 3), context);
         }
         if (context.counter >= 2 && context.counterForEnd >= 3) {
-            UC.Execute(UC.data[context.counter - 2], context);
+            UC.Execute<Trace>(UC.latch(context.counter - 2), context);
         }
         if (context.counter >= 1 && context.counterForEnd >= 4) {
-            account_stage(process);
-            UC.Decode(context, UC.data[context.counter - 1]);
+            account_stage<Trace>(process);
+            UC.Decode<Trace>(context, UC.latch(context.counter - 1));
         }
         if (context.counter >= 0 && context.counterForEnd == 5 && !context.endProgram) {
-            UC.data.push_back(data);
-            UC.Fetch(context);
+            UC.latch(context.counter) = Instruction_Data{};
+            UC.Fetch<Trace>(context);
         }
 
         context.counter += 1;
@@ -459,16 +521,19 @@ void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IOReque
         account_pipeline_cycle(process);
 
         // Capturar snapshot periodicamente
-        snapshot_counter++;
-        if (snapshot_counter >= SNAPSHOT_INTERVAL) {
-            // Estimar uso de cache (aproximação: hits + misses em uso)
-            uint64_t cache_usage = (process.cache_hits.load() + process.cache_misses.load()) * 4; // 4 bytes por entrada
-            uint64_t ram_usage = process.primary_mem_accesses.load() * 4; // 4 bytes por acesso
-            MemoryUsageTracker::recordSnapshot(process, cache_usage, ram_usage);
-            snapshot_counter = 0;
+        if constexpr (Trace::enabled) {
+            snapshot_counter++;
+            if (snapshot_counter >= SNAPSHOT_INTERVAL) {
+                // Estimar uso de cache (aproximação: hits + misses em uso)
+                uint64_t cache_usage = (process.cache_hits.load() + process.cache_misses.load()) * 4; // 4 bytes por entrada
+                uint64_t ram_usage = process.primary_mem_accesses.load() * 4; // 4 bytes por acesso
+                MemoryUsageTracker::recordSnapshot(process, cache_usage, ram_usage);
+                snapshot_counter = 0;
+            }
         }
 
-        if (clock >= process.quantum || context.endProgram == true) {
+        if (clock >= process.quantum || context.endProgram == true ||
+            static_cast<uint64_t>(process.instruction_count) >= stopAtInstruction) {
             context.endExecution = true;
         }
         if (context.endExecution == true) {
@@ -476,14 +541,275 @@ void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IOReque
         }
     }
 
+    // Fim do trecho detalhado: os misses em andamento terminam antes da troca
+    UC.overlap_misses = false;
+    UC.load_ready.fill(0);
+    UC.pending_loads = 0;
+    memoryManager.drainMisses(process);
+
     // Captura snapshot final
-    uint64_t final_cache_usage = (process.cache_hits.load() + process.cache_misses.load()) * 4;
-    uint64_t final_ram_usage = process.primary_mem_accesses.load() * 4;
-    MemoryUsageTracker::recordSnapshot(process, final_cache_usage, final_ram_usage);
+    if constexpr (Trace::enabled) {
+        uint64_t final_cache_usage = (process.cache_hits.load() + process.cache_misses.load()) * 4;
+        uint64_t final_ram_usage = process.primary_mem_accesses.load() * 4;
+        MemoryUsageTracker::recordSnapshot(process, final_cache_usage, final_ram_usage);
+    }
 
     if (context.endProgram) {
         process.state = State::Finished;
     }
+    halted = context.endProgram || process.state == State::Blocked;
+    return clock;
+}
+
+// Verifica se o processo chegou ao ponto de troca fast-forward -> pipeline
+static bool reachedFastForwardPoint(const PCB &process, const CoreOptions &options) {
+    if (options.ff_instructions > 0 &&
+        static_cast<uint64_t>(process.instruction_count) >= options.ff_instructions) {
+        return true;
+    }
+    if (options.ff_to_pc && process.regBank.pc.read() == process.base_address + options.ff_pc) {
+        return true;
+    }
+    return false;
+}
+
+// Verifica se as `length` instruções a partir do PC atual cabem no passo
+// funcional sem atravessar o fim do quantum, stopAtInstruction ou o ponto de
+// troca do fast-forward (que é testado antes de cada instrução)
+static bool fusedFits(const PCB &process, int clock, uint64_t stopAtInstruction,
+                      const CoreOptions *ffOptions, uint32_t length) {
+    uint64_t executed = static_cast<uint64_t>(process.instruction_count);
+    if (clock + static_cast<int>(length) > process.quantum) return false;
+    if (executed + length > stopAtInstruction) return false;
+    if (!ffOptions) return true;
+    if (ffOptions->ff_instructions > 0 && executed + length > ffOptions->ff_instructions) return false;
+    if (ffOptions->ff_to_pc) {
+        uint32_t target = static_cast<uint32_t>(process.base_address) + ffOptions->ff_pc;
+        uint32_t pc = process.regBank.pc.read();
+        if (target > pc && target < pc + 4u * length) return false;
+    }
+    return true;
+}
+
+// Efeito das `count` primeiras instruções da superinstrução nos registradores
+static void ApplyFused(ControlContext &context, const FusedOp &f, uint32_t count) {
+    hw::REGISTER_BANK &registers = context.registers;
+    if (count == 0) return;
+    switch (f.kind) {
+        case FusedKind::ADD_CHAIN: {
+            // rd += count * rt (aritmética de 32 bits com wrap, como a ULA)
+            uint32_t rd = registers.read(f.first.rd);
+            uint32_t rt = registers.read(f.first.rt);
+            registers.write(f.first.rd, rd + count * rt);
+            break;
+        }
+        case FusedKind::LI_LI:
+            registers.write(f.first.rt, static_cast<uint32_t>(f.first.imm));
+            if (count >= 2) registers.write(f.second.rt, static_cast<uint32_t>(f.second.imm));
+            break;
+        case FusedKind::ADDI_BRANCH: {
+            uint32_t rs = registers.read(f.first.rs);
+            registers.write(f.first.rt, rs + static_cast<uint32_t>(f.first.imm));
+            if (count < 2) break;
+
+            ALU alu;
+            alu.A = registers.read(f.second.rs);
+            alu.B = registers.read(f.second.rt);
+            alu.op = (f.second.op == Opcode::BEQ) ? BEQ : (f.second.op == Opcode::BNE) ? BNE : BGT;
+            alu.calculate();
+            if (alu.result == 1) {
+                // Mesmo efeito do desvio em Execute_Loop_Operation (inclusive a leitura do IR)
+                registers.pc.write(f.second.uimm);
+                registers.ir.write(context.memManager.fetch(registers.pc.read(), context.process));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Executa uma superinstrução. Cada instrução coberta passa pelo Fetch normal e
+// conta um ciclo; se a palavra buscada divergir da analisada (ou for END), só
+// o prefixo já buscado é aplicado e a instrução divergente segue pelo caminho
+// comum de Decode/EX/MEM/WB. Retorna o número de instruções executadas.
+static uint32_t RunFused(Control_Unit &UC, ControlContext &context, const FusedOp &f, Instruction_Data &data) {
+    PCB &process = context.process;
+    uint32_t fetched = 0;
+    for (uint8_t i = 0; i < f.length; ++i) {
+        UC.Fetch<TraceFast>(context);
+        fetched++;
+        if (context.endProgram) {
+            ApplyFused(context, f, i);
+            break;
+        }
+        if (context.registers.ir.read() != f.rawAt(i)) {
+            ApplyFused(context, f, i);
+            data = Instruction_Data{};
+            UC.Decode<TraceFast>(context, data);
+            UC.Execute<TraceFast>(data, context);
+            UC.Memory_Acess<TraceFast>(data, context);
+            UC.Write_Back<TraceFast>(data, context);
+            break;
+        }
+        if (i + 1 == f.length) {
+            ApplyFused(context, f, f.length);
+            process.fusion_table.recordExecution(f.length);
+        }
+    }
+    process.functional_instructions += fetched;
+    process.pipeline_cycles.fetch_add(fetched);
+    return fetched;
+}
+
+// Fast-forward funcional: executa uma instrução completa por passo chamando os
+// handlers de FETCH/DECODE/EX/MEM/WB em sequência (instância TraceFast), sem
+// latches, trace ou contagem por estágio. Cada instrução conta como um ciclo do
+// quantum. Com `fuse`, sequências reconhecidas na FusionTable executam como uma
+// superinstrução. Para no fim do quantum, no fim do programa/bloqueio (halted),
+// antes da instrução stopAtInstruction ou, se ffOptions não for nulo, ao atingir
+// o ponto de troca do fast-forward. Retorna o ciclo em que parou.
+static int RunFunctional(Control_Unit &UC, MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+                         int clock, uint64_t stopAtInstruction, const CoreOptions *ffOptions, bool fuse, bool &halted) {
+    int counterForEnd = 5;
+    int counter = 0;
+    bool endProgram = false;
+    bool endExecution = false;
+
+    ControlContext context{ process.regBank, memoryManager, *ioRequests, printLock, process, counter, counterForEnd, endProgram, endExecution };
+    Instruction_Data &data = UC.latch(0);
+
+    halted = false;
+    while (clock < process.quantum &&
+           static_cast<uint64_t>(process.instruction_count) < stopAtInstruction) {
+        if (ffOptions && reachedFastForwardPoint(process, *ffOptions)) {
+            process.fast_forward_done = true;
+            break;
+        }
+
+        if (fuse) {
+            const FusedOp *f = process.fusion_table.lookup(process.regBank.pc.read(), process.decode_cache);
+            if (f && fusedFits(process, clock, stopAtInstruction, ffOptions, f->length)) {
+                clock += static_cast<int>(RunFused(UC, context, *f, data));
+                if (context.endProgram || context.endExecution) { halted = true; break; }
+                continue;
+            }
+        }
+
+        UC.Fetch<TraceFast>(context);
+        clock++;
+        process.functional_instructions++;
+        account_pipeline_cycle(process);
+        if (context.endProgram) { halted = true; break; } // END: Fetch já finalizou o processo
+
+        data = Instruction_Data{};
+        UC.Decode<TraceFast>(context, data);
+        UC.Execute<TraceFast>(data, context);
+        UC.Memory_Acess<TraceFast>(data, context);
+        UC.Write_Back<TraceFast>(data, context);
+
+        if (context.endExecution) { halted = true; break; } // bloqueado em PRINT
+    }
+    return clock;
+}
+
+// Modo funcional com o motor escolhido em options.engine (mesmos critérios de
+// parada de RunFunctional). No motor de blocos, um PC fora da faixa de código
+// traduzível avança uma instrução pelo caminho passo a passo.
+static int RunFunctionalEngine(Control_Unit &UC, MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+                               const CoreOptions &options, int clock, uint64_t stopAtInstruction, const CoreOptions *ffOptions, bool &halted) {
+    if (options.engine == FunctionalEngine::Step) {
+        return RunFunctional(UC, memoryManager, process, ioRequests, printLock, clock, stopAtInstruction, ffOptions, options.fusion, halted);
+    }
+
+    uint64_t limit = stopAtInstruction;
+    if (ffOptions && ffOptions->ff_instructions > 0) limit = std::min(limit, ffOptions->ff_instructions);
+    bool toPc = ffOptions && ffOptions->ff_to_pc;
+    uint32_t target = toPc ? static_cast<uint32_t>(process.base_address) + ffOptions->ff_pc : 0;
+
+    clock = RunBlocks(memoryManager, process, *ioRequests, printLock, clock, limit, toPc, target, halted);
+    uint64_t executed = static_cast<uint64_t>(process.instruction_count);
+    if (halted || clock >= process.quantum || executed >= stopAtInstruction) return clock;
+    if (ffOptions && reachedFastForwardPoint(process, *ffOptions)) {
+        process.fast_forward_done = true;
+        return clock;
+    }
+    return RunFunctional(UC, memoryManager, process, ioRequests, printLock, clock, executed + 1, ffOptions, options.fusion, halted);
+}
+
+// Contadores do processo usados nas janelas de amostragem (ordem de SampledMetric)
+static SamplingState::Counters sampledCounters(const PCB &process) {
+    SamplingState::Counters c{};
+    c[SAMPLE_PIPELINE_CYCLES] = process.pipeline_cycles.load();
+    c[SAMPLE_CACHE_HITS] = process.cache_hits.load();
+    c[SAMPLE_CACHE_MISSES] = process.cache_misses.load();
+    c[SAMPLE_MEMORY_CYCLES] = process.memory_cycles.load();
+    c[SAMPLE_MEM_ACCESSES] = process.mem_accesses_total.load();
+    return c;
+}
+
+static int RunDetailed(Control_Unit &UC, MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+                       const CoreOptions &options, int clock, uint64_t stopAtInstruction, bool &halted) {
+    if (options.trace == TraceMode::Fast) {
+        return RunPipeline<TraceFast>(UC, memoryManager, process, ioRequests, printLock, clock, stopAtInstruction, halted);
+    }
+    return RunPipeline<TraceFull>(UC, memoryManager, process, ioRequests, printLock, clock, stopAtInstruction, halted);
+}
+
+// A função Core agora espera um ponteiro para o PCB, pois o PCB não é mais copiável
+void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+           const CoreOptions &options, Control_Unit *unit) {
+    Control_Unit local;
+    Control_Unit &UC = unit ? *unit : local;
+    const auto hostStart = std::chrono::steady_clock::now();
+
+    const uint64_t NO_LIMIT = UINT64_MAX;
+    int clock = 0;
+    bool halted = false;
+
+    while (!halted && clock < process.quantum) {
+        // 1) Fast-forward funcional até o ponto de troca
+        if (options.fastForwardEnabled() && !process.fast_forward_done) {
+            clock = RunFunctionalEngine(UC, memoryManager, process, ioRequests, printLock, options, clock, NO_LIMIT, &options, halted);
+            continue;
+        }
+
+        // 2) Sem amostragem: resto do quantum no pipeline detalhado
+        if (!options.samplingEnabled()) {
+            clock = RunDetailed(UC, memoryManager, process, ioRequests, printLock, options, clock, NO_LIMIT, halted);
+            break;
+        }
+
+        // 3) Amostragem: funcional até a próxima janela, janela no pipeline detalhado
+        SamplingState &sampling = process.sampling;
+        const uint64_t gap = options.sample_period - options.sample_window;
+        uint64_t executed = static_cast<uint64_t>(process.instruction_count);
+        if (!sampling.started) {
+            sampling.started = true;
+            sampling.next_window_start = executed + gap;
+        }
+
+        if (!sampling.in_window) {
+            if (executed >= sampling.next_window_start) {
+                sampling.beginWindow(executed, sampledCounters(process), options.sample_window);
+                continue;
+            }
+            clock = RunFunctionalEngine(UC, memoryManager, process, ioRequests, printLock, options, clock,
+                                        sampling.next_window_start, nullptr, halted);
+            continue;
+        }
+
+        clock = RunDetailed(UC, memoryManager, process, ioRequests, printLock, options, clock, sampling.window_end, halted);
+        executed = static_cast<uint64_t>(process.instruction_count);
+        if (executed >= sampling.window_end || halted) {
+            // Janela encerrada pela amostragem: o esvaziamento do pipeline não
+            // aconteceria na execução detalhada contínua
+            uint64_t drain = halted ? 0 : static_cast<uint64_t>(PIPELINE_DEPTH - 1);
+            sampling.endWindow(executed, sampledCounters(process), gap, drain);
+        }
+    }
 
+    process.host_time_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - hostStart).count());
     return nullptr;
 }
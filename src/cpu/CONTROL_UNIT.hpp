@@ -3,9 +3,9 @@
 
 #include "REGISTER_BANK.hpp" // Incluído diretamente para ter a definição completa
 #include "ULA.hpp"
-#include "HASH_REGISTER.hpp"
+#include "DecodeCache.hpp"
 #include "../memory/cache.hpp"
-#include <unordered_map>
+#include <array>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -21,16 +21,56 @@ class MemoryManager;
 struct PCB;
 struct IORequest;
 
-void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock);
+// Políticas de instrumentação do pipeline (resolvidas em tempo de compilação).
+// TraceFull grava o trace de execução, os snapshots de memória e as contagens
+// por estágio; TraceFast remove tudo isso do laço do Core.
+struct TraceFull { static constexpr bool enabled = true; };
+struct TraceFast { static constexpr bool enabled = false; };
+
+// Seleção da política em tempo de execução (ex.: --trace na linha de comando)
+enum class TraceMode { Full, Fast };
+
+// Motor do modo funcional: passo a passo (Fetch/Decode por instrução, com
+// superinstruções) ou por blocos básicos traduzidos e encadeados (BlockEngine.hpp)
+enum class FunctionalEngine { Step, Block };
+
+// Opções de execução do Core, definidas pela linha de comando.
+struct CoreOptions {
+    TraceMode trace = TraceMode::Full;
+
+    // Fast-forward funcional: enquanto ativo, as instruções do processo são
+    // executadas uma por passo, sem latches nem contagem por estágio, até a
+    // instrução de número ff_instructions ou até o PC (relativo ao
+    // base_address) ff_pc. Daí em diante o processo segue no pipeline de 5 estágios.
+    uint64_t ff_instructions = 0;   // 0 = desativado
+    bool ff_to_pc = false;
+    uint32_t ff_pc = 0;
+
+    // Amostragem: a cada sample_period instruções, as últimas sample_window
+    // rodam no pipeline detalhado e o resto em modo funcional (ver Sampling.hpp).
+    uint64_t sample_period = 0;     // 0 = desativado
+    uint64_t sample_window = 0;
+
+    // Superinstruções no modo funcional (ver Superinstructions.hpp)
+    bool fusion = true;
+    FunctionalEngine engine = FunctionalEngine::Step;
+
+    bool fastForwardEnabled() const { return ff_instructions > 0 || ff_to_pc; }
+    bool samplingEnabled() const { return sample_window > 0 && sample_period > sample_window; }
+};
+
+struct Control_Unit;
+
+// Executa um quantum do processo. `unit` é a unidade de controle persistente
+// do núcleo (reaproveitada entre quanta); se nula, usa uma unidade local.
+void* Core(MemoryManager &memoryManager, PCB &process, vector<unique_ptr<IORequest>>* ioRequests, bool &printLock,
+           const CoreOptions &options = CoreOptions{}, Control_Unit *unit = nullptr);
 
 struct Instruction_Data {
-    string source_register;
-    string target_register;
-    string destination_register;
-    string op;
-    string addressRAMResult;
+    MicroOp uop;          // instrução pré-decodificada (registradores por índice)
     uint32_t rawInstruction = 0;
     int32_t immediate = 0;
+    uint32_t pc = 0;      // endereço da instrução (o PC avança antes do MEM)
 };
 
 struct ControlContext {
@@ -45,36 +85,51 @@ struct ControlContext {
     bool &endExecution;
 };
 
+constexpr size_t OPCODE_COUNT = static_cast<size_t>(Opcode::COUNT);
+constexpr int PIPELINE_DEPTH = 5;
+
 struct Control_Unit {
-    vector<Instruction_Data> data;
-    hw::Map map;
-
-    std::unordered_map<string, string> instructionMap = {
-        {"add", "000000"}, {"and", "000001"}, {"div", "000010"}, {"mult","000011"},
-        {"sub", "000100"}, {"beq", "000101"}, {"bne", "000110"}, {"bgt", "000111"},
-        {"addi","001000"}, {"blt", "001001"}, {"blti","001010"}, {"j", "001011"},
-        {"lw", "001100"},  {"sw", "001101"},  {"li", "001110"},  {"la", "001111"},
-        {"print", "010000"},{"end", "111111"}
-    };
-
-    static string Get_immediate(uint32_t instruction);
-    static string Get_destination_Register(uint32_t instruction);
-    static string Get_target_Register(uint32_t instruction);
-    static string Get_source_Register(uint32_t instruction);
-
-    // Assinatura corrigida para corresponder à implementação
-    string Identificacao_instrucao(uint32_t instruction, hw::REGISTER_BANK &registers);
-
-    void Fetch(ControlContext &context);
-    void Decode(ControlContext &context, Instruction_Data &data);
-    void Execute(Instruction_Data &data, ControlContext &context);
-    void Execute_Aritmetic_Operation(ControlContext &context, Instruction_Data &data);
-    void Execute_Immediate_Operation(ControlContext &context, Instruction_Data &data);
-    void Execute_Operation(Instruction_Data &data, ControlContext &context);
-    void Execute_Loop_Operation(ControlContext &context, Instruction_Data &data);
+    // Handler de estágio indexado por opcode (ver tabelas em CONTROL_UNIT.cpp)
+    using StageHandler = void (Control_Unit::*)(ControlContext &, Instruction_Data &);
+
+    // Latches do pipeline: a instrução buscada no ciclo c ocupa latches[c % 5]
+    // do DECODE ao WRITE-BACK. Como cada estágio lê no máximo 4 ciclos para
+    // trás, 5 posições bastam e o laço do Core não faz alocações.
+    std::array<Instruction_Data, PIPELINE_DEPTH> latches{};
+
+    Instruction_Data &latch(int cycle) { return latches[cycle % PIPELINE_DEPTH]; }
+
+    // Scoreboard dos loads não bloqueantes (só no pipeline detalhado, com
+    // MSHRs): instante, no relógio do núcleo, em que o dado de cada
+    // registrador chega (0 = disponível). O EXECUTE espera os operandos pendentes.
+    std::array<uint64_t, hw::REGISTER_BANK::NUM_GPR> load_ready{};
+    int pending_loads = 0;
+    bool overlap_misses = false;
+
+    // Espera os registradores pendentes usados pela instrução
+    void Wait_Operands(ControlContext &context, const MicroOp &uop);
+    void Wait_Register(ControlContext &context, uint8_t reg);
+
+    // Decodifica a palavra bruta em um micro-op compacto (sem strings)
+    static Opcode Decode_opcode(uint32_t instruction);
+    static MicroOp Predecode(uint32_t instruction);
+
+    // Estágios do pipeline, parametrizados pela política de trace (TraceFull/TraceFast)
+    template <typename Trace> void Fetch(ControlContext &context);
+    template <typename Trace> void Decode(ControlContext &context, Instruction_Data &data);
+    template <typename Trace> void Execute(Instruction_Data &data, ControlContext &context);
+    template <typename Trace> void Execute_Aritmetic_Operation(ControlContext &context, Instruction_Data &data);
+    template <typename Trace> void Execute_Immediate_Operation(ControlContext &context, Instruction_Data &data);
+    template <typename Trace> void Execute_Operation(ControlContext &context, Instruction_Data &data);
+    template <typename Trace> void Execute_Loop_Operation(ControlContext &context, Instruction_Data &data);
     void log_operation(const std::string &msg);
-    void Memory_Acess(Instruction_Data &data, ControlContext &context);
-    void Write_Back(Instruction_Data &data, ControlContext &context);
+    template <typename Trace> void Memory_Acess(Instruction_Data &data, ControlContext &context);
+    template <typename Trace> void Write_Back(Instruction_Data &data, ControlContext &context);
+
+    // Handlers específicos de MEM/WB e o handler vazio das tabelas de despacho
+    template <typename Trace> void Memory_Load(ControlContext &context, Instruction_Data &data);
+    template <typename Trace> void Write_Back_Store(ControlContext &context, Instruction_Data &data);
+    void Stage_Nop(ControlContext &context, Instruction_Data &data);
 };
 
 #endif // CONTROL_UNIT_HPP
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef DECODE_CACHE_HPP
+#define DECODE_CACHE_HPP
+/*
+  DecodeCache.hpp
+  Cache de instruções pré-decodificadas (micro-ops) por processo.
+
+  - MicroOp é uma estrutura POD compacta com o opcode já identificado, os
+    índices dos registradores (rs/rt/rd) e o imediato já estendido com sinal.
+    Ela substitui as strings binárias que o Decode montava a cada ciclo.
+  - DecodeCache guarda um MicroOp por endereço de instrução (PC) da faixa de
+    código do processo, preenchido no primeiro Decode daquele PC.
+  - Escritas em endereços de código (MemoryManager::write) invalidam a entrada
+    correspondente. Como proteção adicional, a palavra bruta também é comparada
+    na consulta, de modo que escritas feitas por outro caminho (ex.: loader ou
+    outro processo) nunca retornam uma decodificação desatualizada.
+*/
+#include <cstdint>
+#include <vector>
+
+// Opcodes reconhecidos pelo decodificador (ver Control_Unit::Predecode)
+enum class Opcode : uint8_t {
+    INVALID = 0,
+    ADD, SUB, MULT, DIV,
+    J, JAL,
+    BEQ, BNE, BGT,
+    ADDI, ADDIU, SLTI, ANDI, LUI,
+    LW, SW,
+    PRINT, END,
+    COUNT
+};
+
+// Mnemônico usado nos logs (string vazia para instrução desconhecida)
+inline const char* opcodeName(Opcode op) {
+    static const char* const names[] = {
+        "", "ADD", "SUB", "MULT", "DIV", "J", "JAL", "BEQ", "BNE", "BGT",
+        "ADDI", "ADDIU", "SLTI", "ANDI", "LUI", "LW", "SW", "PRINT", "END"
+    };
+    auto idx = static_cast<uint8_t>(op);
+    return idx < static_cast<uint8_t>(Opcode::COUNT) ? names[idx] : "";
+}
+
+// Campos presentes no formato da instrução (usados no log do DECODE)
+enum MicroOpField : uint8_t {
+    FIELD_RS  = 1u << 0,
+    FIELD_RT  = 1u << 1,
+    FIELD_RD  = 1u << 2,
+    FIELD_IMM = 1u << 3
+};
+
+struct MicroOp {
+    uint32_t raw = 0;      // palavra original (tag de verificação)
+    int32_t imm = 0;       // imediato estendido com sinal
+    uint32_t uimm = 0;     // campo imediato sem sinal (16 bits, ou 26 bits no J)
+    Opcode op = Opcode::INVALID;
+    uint8_t rs = 0;
+    uint8_t rt = 0;
+    uint8_t rd = 0;
+    uint8_t fields = 0;    // máscara de MicroOpField
+
+    bool has(MicroOpField f) const { return (fields & f) != 0; }
+};
+
+class DecodeCache {
+public:
+    // Define a faixa de código [begin, end) coberta pela cache (endereços de 4 em 4)
+    void configure(uint32_t begin, uint32_t end) {
+        begin_ = begin;
+        end_ = (end > begin) ? end : begin;
+        entries.assign((end_ - begin_ + 3) / 4, Entry{});
+    }
+
+    // Retorna o micro-op em cache para o PC, ou nullptr em caso de miss
+    const MicroOp* lookup(uint32_t pc, uint32_t raw) {
+        size_t idx;
+        if (indexOf(pc, idx)) {
+            const Entry &e = entries[idx];
+            if (e.valid && e.uop.raw == raw) {
+                hits_++;
+                return &e.uop;
+            }
+        }
+        misses_++;
+        return nullptr;
+    }
+
+    // Consulta sem contabilizar hit/miss (usada na análise de superinstruções)
+    const MicroOp* peek(uint32_t pc) const {
+        size_t idx;
+        if (indexOf(pc, idx) && entries[idx].valid) return &entries[idx].uop;
+        return nullptr;
+    }
+
+    void insert(uint32_t pc, const MicroOp &uop) {
+        size_t idx;
+        if (!indexOf(pc, idx)) return; // fora da faixa de código: não armazena
+        entries[idx].uop = uop;
+        entries[idx].valid = true;
+    }
+
+    // Chamado em toda escrita de memória do processo
+    void invalidate(uint32_t address) {
+        size_t idx;
+        if (indexOf(address, idx) && entries[idx].valid) {
+            entries[idx].valid = false;
+            invalidations_++;
+        }
+    }
+
+    void clear() {
+        for (auto &e : entries) e.valid = false;
+    }
+
+    bool covers(uint32_t address) const { return address >= begin_ && address < end_; }
+    uint32_t begin() const { return begin_; }
+    uint32_t end() const { return end_; }
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t invalidations() const { return invalidations_; }
+
+private:
+    struct Entry {
+        MicroOp uop;
+        bool valid = false;
+    };
+
+    bool indexOf(uint32_t address, size_t &idx) const {
+        if (address < begin_ || address >= end_) return false;
+        uint32_t off = address - begin_;
+        if (off & 3u) return false;
+        idx = off >> 2;
+        return true;
+    }
+
+    uint32_t begin_ = 0;
+    uint32_t end_ = 0;
+    std::vector<Entry> entries;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t invalidations_ = 0;
+};
+
+#endif // DECODE_CACHE_HPP
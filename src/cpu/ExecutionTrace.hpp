@@ -0,0 +1,174 @@
+#ifndef EXECUTION_TRACE_HPP
+#define EXECUTION_TRACE_HPP
+/*
+  ExecutionTrace.hpp
+  Trace binário de execução por processo.
+
+  - Cada estágio do pipeline grava um TraceRecord de tamanho fixo (ciclo, PC,
+    palavra bruta, opcode, registradores, operandos e valor) em vez de montar
+    uma std::string com ostringstream a cada ciclo.
+  - Os registros ficam em um buffer circular com capacidade fixa: quando enche,
+    os mais antigos são sobrescritos e contabilizados em dropped().
+  - A formatação em texto (format) só acontece quando o relatório é escrito
+    (print_metrics em main.cpp) e reproduz exatamente o texto do antigo
+    execution_log.
+*/
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include "DecodeCache.hpp"
+#include "REGISTER_BANK.hpp"
+
+// Tipo do evento registrado (um por linha do relatório)
+enum class TraceKind : uint8_t {
+    FETCH,      // [FETCH]      pc, raw
+    DECODE,     // [DECODE]     raw, op, rs/rt/rd, fields, value = imm
+    IMM,        // [IMM]        op, rs, rt, a = val_rs, b = imm, value = resultado
+    ARIT,       // [ARIT]       op, rs, rt, rd, a = val_rs, b = val_rt, value = resultado
+    BRANCH,     // [BRANCH]     op, addr = novo PC
+    PRINT_REG,  // [IO-REQ]     rt, value
+    LOAD,       // [MEMORY]     rt, addr, value
+    STORE       // [WRITE-BACK] rt, addr, value
+};
+
+struct TraceRecord {
+    uint64_t cycle = 0;    // ciclo de pipeline do processo no momento do registro
+    uint32_t pc = 0;
+    uint32_t raw = 0;
+    uint32_t addr = 0;
+    int32_t a = 0;
+    int32_t b = 0;
+    int32_t value = 0;
+    TraceKind kind = TraceKind::FETCH;
+    Opcode op = Opcode::INVALID;
+    uint8_t rs = 0;
+    uint8_t rt = 0;
+    uint8_t rd = 0;
+    uint8_t fields = 0;    // máscara de MicroOpField (usada no DECODE)
+};
+
+class ExecutionTrace {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit ExecutionTrace(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity ? capacity : 1) {}
+
+    // Redefine a capacidade (descarta o conteúdo atual)
+    void setCapacity(size_t capacity) {
+        capacity_ = capacity ? capacity : 1;
+        clear();
+        records.shrink_to_fit();
+    }
+
+    void record(const TraceRecord &r) {
+        if (records.size() < capacity_) {
+            // Cresce até a capacidade; a partir daí só sobrescreve (sem alocação)
+            if (records.capacity() == records.size()) {
+                records.reserve(std::min(capacity_, records.size() * 2 + 64));
+            }
+            records.push_back(r);
+        } else {
+            records[head] = r;
+            head = (head + 1) % capacity_;
+        }
+        total_++;
+    }
+
+    void clear() {
+        records.clear();
+        head = 0;
+        total_ = 0;
+    }
+
+    bool empty() const { return records.empty(); }
+    size_t size() const { return records.size(); }
+    size_t capacity() const { return capacity_; }
+    // Total de registros já gravados (inclusive os sobrescritos)
+    uint64_t total() const { return total_; }
+    uint64_t dropped() const { return total_ - records.size(); }
+
+    // Percorre os registros retidos, do mais antigo para o mais recente
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i < records.size(); ++i) {
+            fn(records[(head + i) % records.size()]);
+        }
+    }
+
+    // Converte um registro para a linha de texto do relatório
+    static std::string format(const TraceRecord &r, int pid) {
+        std::ostringstream oss;
+        const char *op = opcodeName(r.op);
+        switch (r.kind) {
+            case TraceKind::FETCH:
+                oss << "[FETCH] PC=" << r.pc << " MAR=" << r.pc
+                    << " INSTR=0x" << std::hex << r.raw << std::dec
+                    << " (" << toBinary(r.raw) << ")";
+                break;
+            case TraceKind::DECODE:
+                oss << "[DECODE] RAW=0x" << std::hex << r.raw << std::dec
+                    << " OP=" << (*op ? op : "<UNKNOWN>");
+                if (r.fields & FIELD_RS) oss << " rs=" << hw::REGISTER_BANK::gprName(r.rs);
+                if (r.fields & FIELD_RT) oss << " rt=" << hw::REGISTER_BANK::gprName(r.rt);
+                if (r.fields & FIELD_RD) oss << " rd=" << hw::REGISTER_BANK::gprName(r.rd);
+                if (r.fields & FIELD_IMM) oss << " imm=" << r.value;
+                break;
+            case TraceKind::IMM: {
+                const char *rs = hw::REGISTER_BANK::gprName(r.rs);
+                const char *rt = hw::REGISTER_BANK::gprName(r.rt);
+                if (r.op == Opcode::ADDI || r.op == Opcode::ADDIU) {
+                    oss << "[IMM] " << op << " " << rt << " = " << rs << "(" << r.a << ") + "
+                        << r.b << " -> " << r.value;
+                } else if (r.op == Opcode::SLTI) {
+                    oss << "[IMM] SLTI " << rt << " = (" << rs << "(" << r.a
+                        << ") < " << r.b << ") ? 1 : 0 -> " << r.value;
+                } else if (r.op == Opcode::LUI) {
+                    oss << "[IMM] LUI " << rt << " = (0x" << std::hex << r.b
+                        << " << 16) -> 0x" << r.value << std::dec;
+                } else {
+                    oss << "[IMM] UNKNOWN OP: " << op << " rs=" << rs << " imm=" << r.b;
+                }
+                break;
+            }
+            case TraceKind::ARIT:
+                oss << "[ARIT] " << op << " " << hw::REGISTER_BANK::gprName(r.rd)
+                    << " = " << hw::REGISTER_BANK::gprName(r.rs) << "(" << r.a << ") "
+                    << op << " " << hw::REGISTER_BANK::gprName(r.rt) << "(" << r.b << ") = "
+                    << r.value;
+                break;
+            case TraceKind::BRANCH:
+                oss << "[BRANCH] OP=" << op << " taken, new PC=" << r.addr;
+                break;
+            case TraceKind::PRINT_REG:
+                oss << "[IO-REQ] PRINT REG " << hw::REGISTER_BANK::gprName(r.rt)
+                    << " value=" << r.value << " (pid=" << pid << ")";
+                break;
+            case TraceKind::LOAD:
+                oss << "[MEMORY] LW addr=" << r.addr << " value=" << r.value
+                    << " -> " << hw::REGISTER_BANK::gprName(r.rt);
+                break;
+            case TraceKind::STORE:
+                oss << "[WRITE-BACK] SW addr=" << r.addr << " value=" << r.value
+                    << " from reg " << hw::REGISTER_BANK::gprName(r.rt);
+                break;
+        }
+        return oss.str();
+    }
+
+private:
+    static std::string toBinary(uint32_t v) {
+        std::string s(32, '0');
+        for (int i = 0; i < 32; ++i)
+            s[31 - i] = ((v >> i) & 1) ? '1' : '0';
+        return s;
+    }
+
+    size_t capacity_;
+    size_t head = 0;        // posição do registro mais antigo quando o buffer está cheio
+    uint64_t total_ = 0;
+    std::vector<TraceRecord> records;
+};
+
+#endif // EXECUTION_TRACE_HPP
@@ -11,8 +11,15 @@
 #include <cstdint>
 #include <vector>
 #include <chrono>
+#include <cmath>
 #include "memory/cache.hpp"
+#include "memory/SegmentTable.hpp"
 #include "REGISTER_BANK.hpp" // necessidade de objeto completo dentro do PCB
+#include "DecodeCache.hpp"
+#include "Superinstructions.hpp"
+#include "BlockCache.hpp"
+#include "ExecutionTrace.hpp"
+#include "Sampling.hpp"
 
 
 // Estados possíveis do processo (simplificado)
@@ -25,6 +32,8 @@ enum class State {
 
 struct MemWeights {
     uint64_t cache = 1;   // custo por acesso à memória cache
+    uint64_t victim = 2;  // custo por linha devolvida pela victim cache
+    uint64_t l2 = 3;      // custo por linha trazida da cache L2
     uint64_t primary = 5; // custo por acesso à memória primária
     uint64_t secondary = 10; // custo por acesso à memória secundária
 };
@@ -35,12 +44,39 @@ struct PCB {
     int quantum = 5; // Valor padrão para quantum (reduzido para demonstrar preempção)
     int priority = 0;
     size_t base_address = 0; // Endereço base do processo na memória
+    size_t image_size = 0;   // Endereços reservados pelo alocador (0 = faixa fixa)
+    int core_id = 0;         // Núcleo em execução (seleciona a L1 privada)
 
     State state = State::Ready;
     hw::REGISTER_BANK regBank;
     int instruction_count = 0; // Contador de instruções executadas
 
-    std::vector<std::string> execution_log; // Log de execução
+    // Fast-forward funcional (ver CoreOptions)
+    bool fast_forward_done = false;       // true após atingir o ponto de troca para o pipeline
+    uint64_t functional_instructions = 0; // instruções executadas no modo funcional
+
+    // Estado e estatísticas da simulação por amostragem (ver Sampling.hpp)
+    SamplingState sampling;
+
+    // Trace de execução (registros binários em buffer circular, formatados no relatório)
+    ExecutionTrace execution_trace;
+
+    // Micro-ops pré-decodificados da faixa de código do processo (por PC)
+    DecodeCache decode_cache;
+
+    // Superinstruções do modo funcional (mesma faixa de código da decode_cache)
+    FusionTable fusion_table;
+
+    // Blocos básicos traduzidos do motor de blocos (ver BlockEngine.hpp)
+    BlockCache block_cache;
+
+    // Segmentos do processo (código e dados), usados com --segmentation
+    SegmentTable segments;
+    std::atomic<uint64_t> segment_violations{0};  // acessos negados pela segmentação
+    bool segment_fault = false;                   // busca fora do código: processo encerrado
+
+    // Tempo real (host) gasto no Core, para a métrica ns por instrução simulada
+    uint64_t host_time_ns = 0;
 
     // Campos auxiliares para detectar estagnação (loop infinito)
     int stagnation_counter = 0;    // conta quantas vezes o processo voltou pronto sem avançar
@@ -53,6 +89,7 @@ struct PCB {
     std::atomic<uint64_t> mem_accesses_total{0};
     std::atomic<uint64_t> extra_cycles{0};
     std::atomic<uint64_t> cache_mem_accesses{0};
+    std::atomic<uint64_t> l2_mem_accesses{0};
 
     // Instrumentação detalhada
     std::atomic<uint64_t> pipeline_cycles{0};
@@ -98,4 +135,12 @@ inline void contabiliza_cache(PCB &pcb, bool hit) {
     }
 }
 
+// Ciclos de pipeline do processo: com amostragem, a estimativa extrapolada das
+// janelas detalhadas (os trechos funcionais contam só 1 ciclo por instrução).
+inline uint64_t pipeline_cycles_estimate(const PCB &pcb) {
+    if (!pcb.sampling.used()) return pcb.pipeline_cycles.load();
+    return static_cast<uint64_t>(std::llround(
+        pcb.sampling.estimate(SAMPLE_PIPELINE_CYCLES, static_cast<uint64_t>(pcb.instruction_count))));
+}
+
 #endif // PCB_HPP
\ No newline at end of file
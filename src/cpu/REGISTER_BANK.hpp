@@ -13,7 +13,13 @@ pode simplesmente pedir pelo nome ("s0"), usando os mapas que a gente criou.
 Isso deixa o código do resto do grupo muito mais fácil de ler e entender.
 
 Este arquivo .hpp é a "interface" da minha parte. Ele só diz o que a classe
-faz e quais funções ela tem. 
+faz e quais funções ela tem.
+
+Atualização: os 32 registradores de uso geral agora ficam em um array indexado
+pelo número do registrador (0..31), acessado com read(idx)/write(idx, v) no
+caminho quente da Control Unit. O acesso por nome continua disponível como uma
+camada fina de depuração, traduzindo o nome para o índice por uma tabela
+estática compartilhada (sem std::function por instância).
 */
 
 #ifndef REGISTER_BANK_HPP
@@ -24,8 +30,7 @@ faz e quais funções ela tem.
 #include <cstdint>
 #include <string>
 
-#include <unordered_map>
-#include <functional>
+#include <array>
 
 #include <stdexcept>
 #include <iostream>
@@ -37,28 +42,32 @@ using namespace std;
 // Namespace para o nosso hardware simulado. Serve para evitar que os nomes das nossas classes (como REGISTER_BANK) entrem em conflito com outras bibliotecas.
 namespace hw{
 
-    // Junta todos os registradores da CPU e fornece a interface de acesso por nome que a Control_Unit vai usar.
+    // Junta todos os registradores da CPU e fornece a interface de acesso por índice (caminho quente) e por nome (depuração).
     class REGISTER_BANK{
     public:
+        static constexpr int NUM_GPR = 32;
+
         // --- Registradores de uso específico ---
         REGISTER pc, mar, cr, epc, sr, hi, lo, ir;
 
-        // --- Registradores de uso geral (seguindo a convenção MIPS) ---
-        REGISTER zero, at;
-        REGISTER v0, v1;
-        REGISTER a0, a1, a2, a3;
-        REGISTER t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
-        REGISTER s0, s1, s2, s3, s4, s5, s6, s7;
-        REGISTER k0, k1;
-        REGISTER gp, sp, fp, ra;
-
-        // --- Mapas de acesso por nome (a interface principal para a Control_Unit) ---
-        unordered_map<string, function<uint32_t()>> acessoLeituraRegistradores;
-        unordered_map<string, function<void(uint32_t)>> acessoEscritaRegistradores;
+        // --- Registradores de uso geral (convenção MIPS: 0 = zero, 8 = t0, 16 = s0, 31 = ra) ---
+        array<uint32_t, NUM_GPR> gpr{};
 
         // Construtor: Declarado aqui, implementado no .cpp
         REGISTER_BANK();
 
+        // Leitura por índice (0..31). O registrador zero sempre vale 0.
+        inline uint32_t read(uint8_t idx) const { return gpr[idx & (NUM_GPR - 1)]; }
+
+        // Escrita por índice (0..31). Escritas no registrador zero são descartadas.
+        inline void write(uint8_t idx, uint32_t value){
+            idx &= (NUM_GPR - 1);
+            if (idx != 0) gpr[idx] = value;
+        }
+
+        // Nome MIPS do registrador de uso geral (ex.: 8 -> "t0"), usado nos logs.
+        static const char* gprName(uint8_t idx);
+
         // Leitura segura por nome.
         uint32_t readRegister(const string &name) const;
 
@@ -72,6 +81,11 @@ namespace hw{
         void print_registers() const;
         string get_registers_as_string() const;
 
+    private:
+        // Traduz um nome para o índice de gpr (0..31) ou para um registrador
+        // especial (pc, mar, ...). Retorna false se o nome não existir.
+        bool resolve(const string &name, int &gprIndex, REGISTER REGISTER_BANK::* &special) const;
+
     };
 
 } 
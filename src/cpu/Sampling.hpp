@@ -0,0 +1,113 @@
+#ifndef SAMPLING_HPP
+#define SAMPLING_HPP
+/*
+  Sampling.hpp
+  Simulação por amostragem (estilo SMARTS) por processo.
+
+  - O Core alterna intervalos de fast-forward funcional com janelas curtas no
+    pipeline detalhado: a cada sample_period instruções, as últimas
+    sample_window são executadas no pipeline de 5 estágios.
+  - Em cada janela mede-se a variação por instrução de cada métrica
+    (ciclos de pipeline, hits/misses de cache, ciclos de memória...). As médias
+    e variâncias são acumuladas com o algoritmo de Welford (RunningStat).
+  - Ao final, cada métrica é extrapolada para o total de instruções do
+    processo, com intervalo de confiança de 95% (aproximação normal).
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Métricas extrapoladas a partir das janelas detalhadas
+enum SampledMetric {
+    SAMPLE_PIPELINE_CYCLES = 0,
+    SAMPLE_CACHE_HITS,
+    SAMPLE_CACHE_MISSES,
+    SAMPLE_MEMORY_CYCLES,
+    SAMPLE_MEM_ACCESSES,
+    SAMPLE_METRIC_COUNT
+};
+
+// Rótulos do relatório, já alinhados como os demais campos de print_metrics
+inline const char* sampledMetricName(SampledMetric m) {
+    static const char* const names[SAMPLE_METRIC_COUNT] = {
+        "Pipeline Cycles: ", "Cache Hits:      ", "Cache Misses:    ",
+        "Ciclos Memória:  ", "Acessos Memória: "
+    };
+    return names[m];
+}
+
+// Média e variância incrementais (Welford)
+struct RunningStat {
+    uint64_t n = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double x) {
+        n++;
+        double delta = x - mean;
+        mean += delta / static_cast<double>(n);
+        m2 += delta * (x - mean);
+    }
+
+    double variance() const { return (n > 1) ? m2 / static_cast<double>(n - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    // Meia largura do intervalo de confiança de 95% para a média
+    double halfWidth95() const { return (n > 1) ? 1.96 * stddev() / std::sqrt(static_cast<double>(n)) : 0.0; }
+};
+
+struct SamplingState {
+    using Counters = std::array<uint64_t, SAMPLE_METRIC_COUNT>;
+
+    // Fase atual
+    bool started = false;
+    bool in_window = false;
+    uint64_t next_window_start = 0;   // instrução em que a próxima janela começa
+    uint64_t window_end = 0;          // instrução em que a janela atual termina
+
+    // Contadores no início da janela atual
+    uint64_t window_start_instr = 0;
+    Counters window_start{};
+
+    // Estatísticas por instrução de cada métrica
+    std::array<RunningStat, SAMPLE_METRIC_COUNT> per_instruction{};
+    uint64_t windows = 0;
+    uint64_t detailed_instructions = 0;
+
+    bool used() const { return windows > 0; }
+
+    void beginWindow(uint64_t instr, const Counters &now, uint64_t length) {
+        in_window = true;
+        window_start_instr = instr;
+        window_start = now;
+        window_end = instr + length;
+    }
+
+    // drainCycles: ciclos gastos só para esvaziar o pipeline ao encerrar a
+    // janela (artefato da troca para o modo funcional, descontado da medida)
+    void endWindow(uint64_t instr, const Counters &now, uint64_t gap, uint64_t drainCycles) {
+        in_window = false;
+        next_window_start = instr + gap;
+        uint64_t executed = instr - window_start_instr;
+        if (executed == 0) return;
+        for (int m = 0; m < SAMPLE_METRIC_COUNT; ++m) {
+            uint64_t delta = now[m] - window_start[m];
+            if (m == SAMPLE_PIPELINE_CYCLES) delta -= std::min(delta, drainCycles);
+            per_instruction[m].add(static_cast<double>(delta) / static_cast<double>(executed));
+        }
+        windows++;
+        detailed_instructions += executed;
+    }
+
+    // Estimativa do total da métrica para `instructions` instruções
+    double estimate(SampledMetric m, uint64_t instructions) const {
+        return per_instruction[m].mean * static_cast<double>(instructions);
+    }
+
+    // Meia largura do IC de 95% da estimativa acima
+    double errorBound(SampledMetric m, uint64_t instructions) const {
+        return per_instruction[m].halfWidth95() * static_cast<double>(instructions);
+    }
+};
+
+#endif // SAMPLING_HPP
@@ -0,0 +1,196 @@
+#ifndef SUPERINSTRUCTIONS_HPP
+#define SUPERINSTRUCTIONS_HPP
+/*
+  Superinstructions.hpp
+  Fusão de sequências frequentes de instruções (superinstruções) para o modo
+  funcional do Core (fast-forward e trechos entre janelas de amostragem).
+
+  - A análise percorre os micro-ops do programa a partir de um PC e reconhece
+    três padrões:
+      ADD_CHAIN    add rd, rd, rt repetido (rd += k * rt)
+      ADDI_BRANCH  addi/addiu seguido de beq/bne/bgt (fim de laço)
+      LI_LI        dois li (addi com rs = $zero) consecutivos
+  - O loader faz uma passada sobre o programa pré-decodificado (build). Depois
+    de uma escrita na faixa de código, as entradas afetadas voltam a UNKNOWN e
+    são reanalisadas a partir da DecodeCache, ou seja, só depois que as
+    instruções novas executarem ao menos uma vez.
+  - Cada instrução fundida continua sendo buscada da memória e contada como um
+    ciclo: a fusão elimina apenas o despacho Decode/EX/MEM/WB por instrução.
+    A palavra buscada é comparada com a analisada; se divergir, só o prefixo
+    válido é executado pela superinstrução.
+*/
+#include <cstdint>
+#include <vector>
+#include "DecodeCache.hpp"
+
+enum class FusedKind : uint8_t {
+    UNKNOWN = 0,   // ainda não analisado (ou instruções seguintes não decodificadas)
+    NONE,          // nenhum padrão começa neste PC
+    ADD_CHAIN,
+    ADDI_BRANCH,
+    LI_LI
+};
+
+inline const char* fusedKindName(FusedKind kind) {
+    switch (kind) {
+        case FusedKind::ADD_CHAIN:   return "ADD_CHAIN";
+        case FusedKind::ADDI_BRANCH: return "ADDI_BRANCH";
+        case FusedKind::LI_LI:       return "LI_LI";
+        default:                     return "";
+    }
+}
+
+struct FusedOp {
+    static constexpr uint8_t MAX_LENGTH = 16;
+
+    FusedKind kind = FusedKind::UNKNOWN;
+    uint8_t length = 0;        // instruções cobertas (>= 2)
+    MicroOp first;             // ADD da cadeia, primeiro li ou o addi
+    MicroOp second;            // segundo li ou o desvio (não usado em ADD_CHAIN)
+
+    bool fused() const { return kind >= FusedKind::ADD_CHAIN; }
+
+    // Palavra esperada na posição i da sequência
+    uint32_t rawAt(uint8_t i) const {
+        return (kind == FusedKind::ADD_CHAIN || i == 0) ? first.raw : second.raw;
+    }
+};
+
+class FusionTable {
+public:
+    // Mesma faixa de código [begin, end) da DecodeCache do processo
+    void configure(uint32_t begin, uint32_t end) {
+        begin_ = begin;
+        end_ = (end > begin) ? end : begin;
+        entries.assign((end_ - begin_ + 3) / 4, FusedOp{});
+    }
+
+    // Passada sobre o programa carregado: program[i] é o micro-op do PC begin + 4*i
+    void build(const std::vector<MicroOp> &program) {
+        auto peek = [&](uint32_t pc) -> const MicroOp* {
+            if (pc < begin_) return nullptr;
+            size_t i = (pc - begin_) / 4;
+            return i < program.size() ? &program[i] : nullptr;
+        };
+        for (size_t i = 0; i < entries.size(); ++i) {
+            entries[i] = analyze(begin_ + static_cast<uint32_t>(i) * 4u, peek);
+            if (entries[i].fused()) formed_++;
+        }
+    }
+
+    // Superinstrução que começa em pc, analisando-a se necessário.
+    // Retorna nullptr quando não há fusão possível (ainda) neste PC.
+    const FusedOp* lookup(uint32_t pc, const DecodeCache &decoded) {
+        size_t idx;
+        if (!indexOf(pc, idx)) return nullptr;
+        FusedOp &e = entries[idx];
+        if (e.kind == FusedKind::UNKNOWN) {
+            e = analyze(pc, [&decoded](uint32_t at) { return decoded.peek(at); });
+            if (e.fused()) formed_++;
+        }
+        return e.fused() ? &e : nullptr;
+    }
+
+    // Chamado em escritas na faixa de código: descarta as sequências que
+    // cobrem o endereço (elas começam no máximo MAX_LENGTH - 1 instruções antes)
+    void invalidate(uint32_t address) {
+        if (address < begin_ || address >= end_) return;
+        uint32_t span = (FusedOp::MAX_LENGTH - 1) * 4u;
+        uint32_t from = (address - begin_ > span) ? address - span : begin_;
+        for (uint32_t pc = from; pc <= address; pc += 4) {
+            size_t idx;
+            if (indexOf(pc, idx)) entries[idx] = FusedOp{};
+        }
+    }
+
+    void clear() {
+        for (auto &e : entries) e = FusedOp{};
+    }
+
+    // Estatísticas: sequências reconhecidas, execuções e instruções cobertas
+    uint64_t formed() const { return formed_; }
+    uint64_t executions() const { return executions_; }
+    uint64_t fusedInstructions() const { return fused_instructions_; }
+    void recordExecution(uint64_t instructions) {
+        executions_++;
+        fused_instructions_ += instructions;
+    }
+
+    static bool isLi(const MicroOp &u) {
+        return (u.op == Opcode::ADDI || u.op == Opcode::ADDIU) && u.rs == 0;
+    }
+    static bool isChainAdd(const MicroOp &u) {
+        return u.op == Opcode::ADD && u.rd != 0 && u.rd == u.rs && u.rt != u.rd;
+    }
+    static bool isConditionalBranch(const MicroOp &u) {
+        return u.op == Opcode::BEQ || u.op == Opcode::BNE || u.op == Opcode::BGT;
+    }
+
+private:
+    // peek(pc) devolve o micro-op já decodificado do PC, ou nullptr
+    template <typename Peek>
+    FusedOp analyze(uint32_t pc, Peek peek) const {
+        FusedOp f;
+        const MicroOp *a = peek(pc);
+        if (!a) return f; // UNKNOWN: ainda não decodificado
+
+        bool addChain = isChainAdd(*a);
+        bool addi = (a->op == Opcode::ADDI || a->op == Opcode::ADDIU);
+        if (!addChain && !addi) {
+            f.kind = FusedKind::NONE;
+            return f;
+        }
+
+        const MicroOp *b = peek(pc + 4);
+        if (!b) {
+            // Sequência possível, mas a instrução seguinte ainda não foi decodificada
+            // (ou está fora da faixa de código)
+            if (pc + 4 >= end_) f.kind = FusedKind::NONE;
+            return f;
+        }
+
+        f.first = *a;
+        if (addChain) {
+            uint8_t n = 1;
+            const MicroOp *next = b;
+            while (next && next->raw == a->raw && n < FusedOp::MAX_LENGTH) {
+                n++;
+                next = peek(pc + 4u * n);
+            }
+            if (n >= 2) {
+                f.kind = FusedKind::ADD_CHAIN;
+                f.length = n;
+            } else {
+                f.kind = FusedKind::NONE;
+            }
+        } else if (isLi(*a) && isLi(*b)) {
+            f.kind = FusedKind::LI_LI;
+            f.length = 2;
+            f.second = *b;
+        } else if (isConditionalBranch(*b)) {
+            f.kind = FusedKind::ADDI_BRANCH;
+            f.length = 2;
+            f.second = *b;
+        } else {
+            f.kind = FusedKind::NONE;
+        }
+        return f;
+    }
+
+    bool indexOf(uint32_t address, size_t &idx) const {
+        if (address < begin_ || address >= end_) return false;
+        uint32_t off = address - begin_;
+        if (off & 3u) return false;
+        idx = off >> 2;
+        return true;
+    }
+
+    uint32_t begin_ = 0;
+    uint32_t end_ = 0;
+    std::vector<FusedOp> entries;
+    uint64_t formed_ = 0;
+    uint64_t executions_ = 0;
+    uint64_t fused_instructions_ = 0;
+};
+
+#endif // SUPERINSTRUCTIONS_HPP
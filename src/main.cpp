@@ -34,9 +34,44 @@ struct CommandLineConfig {
     std::string tasks_dir = "tasks";
     std::string output_dir = "output";
     int cores = 1;
-    std::string replacement_policy = "FIFO";  // FIFO ou LRU
+    std::string replacement_policy = "FIFO";  // FIFO, LRU, CLOCK, LFU, ARC, 2Q ou SRRIP
+    long long cache_size = 256;               // Capacidade da cache em endereços
+    long long cache_ways = 0;                 // Vias por conjunto (0 = totalmente associativa)
+    long long line_size = 16;                 // Endereços por linha da cache (16, 32 ou 64)
+    long long l2_size = 4096;                 // Capacidade da L2 compartilhada em endereços
+    long long l2_ways = 8;                    // Vias por conjunto da L2 (0 = totalmente associativa)
+    long long l2_shards = 8;                  // Shards (travas) da L2 e do barramento
+    std::string prefetch = "none";            // none, next-line, stride ou stream
+    long long prefetch_degree = 2;            // Linhas buscadas por disparo do prefetcher
+    long long prefetch_distance = 1;          // Linhas à frente onde o prefetch começa
+    long long victim_cache = 0;               // Linhas da victim cache de cada L1 (0 = desligada)
+    long long write_buffer = 0;               // Entradas do buffer de escrita (0 = write-back síncrono)
+    long long mshrs = 0;                      // MSHRs de cada L1 (0 = cache bloqueante)
+    std::string switch_policy = "partial";    // Troca de contexto na L1: partial, asid ou asid-flush
+    std::string secondary_device = "flat";    // Memória secundária: flat, disk ou flash
+    long long device_latency = 0;             // Posicionamento (disk) ou latência por pedido (flash); 0 = padrão
+    long long device_bandwidth = 4;           // Palavras transferidas por ciclo pelo dispositivo
+    long long device_queue = 1;               // Pedidos atendidos ao mesmo tempo pelo dispositivo
+    std::string secondary_file;               // Arquivo mapeado como memória secundária (vazio = RAM)
+    long long secondary_size = 0;             // Palavras no arquivo (0 = tamanho atual do arquivo)
+    long long frames = 0;                     // Quadros da memória virtual paginada (0 = sem paginação)
+    long long page_size = 256;                // Endereços por página
+    long long tlb_entries = 16;               // Entradas da TLB de cada núcleo
+    std::string page_replacement = "clock";   // Substituição de páginas: clock, aging ou wsclock
+    bool segmentation = false;                // Segmentos de código e dados por processo
+    std::string allocator = "fixed";          // Imagens dos processos: fixed, buddy, first-fit ou best-fit
+    long long alloc_granule = 16;             // Menor bloco do alocador (potência de 2)
+    long long data_area = 512;                // Endereços de dados reservados após o código de cada processo
+    long long replicas = 1;                   // Cópias do conjunto de processos (exige alocador)
     std::string scheduler = "FCFS";            // FCFS, SJN, Priority, RR
     int quantum = 5;
+    std::string trace_mode = "FULL";          // FULL (diagnóstico) ou FAST (produção)
+    long long ff_instructions = 0;            // Fast-forward funcional até a instrução N (0 = desativado)
+    long long ff_pc = -1;                     // Fast-forward funcional até o PC (relativo ao base_address)
+    long long sample_period = 0;              // Amostragem: período em instruções (0 = desativado)
+    long long sample_window = 0;              // Amostragem: instruções detalhadas por período
+    bool fusion = true;                       // Superinstruções no modo funcional
+    std::string functional_engine = "STEP";   // Motor do modo funcional: STEP ou BLOCK
     bool use_threads = true;                  // Se true, usa multi-threading quando cores > 1
     bool interactive_mode = true;             // Se true, usa menu interativo
     bool help = false;
@@ -51,9 +86,67 @@ void print_help(const char* program_name) {
     std::cout << "  --output <dir>       Diretório de saída (padrão: output)\n";
     std::cout << "  --cores <n>          Número de cores 1-8 (padrão: 1)\n";
     std::cout << "  --no-threads         Desabilita multi-threading (usa sequencial mesmo com múltiplos cores)\n";
-    std::cout << "  --replacement <pol>  Política de substituição: FIFO ou LRU (padrão: FIFO)\n";
+    std::cout << "  --replacement <pol>  Política de substituição: FIFO, LRU, CLOCK,\n";
+    std::cout << "                       LFU, ARC, 2Q ou SRRIP (padrão: FIFO)\n";
+    std::cout << "  --cache-size <n>     Capacidade da cache em endereços, uma palavra cada (padrão: 256)\n";
+    std::cout << "  --cache-ways <n>     Vias por conjunto; 0 = totalmente associativa (padrão: 0)\n";
+    std::cout << "  --line-size <n>      Endereços por linha da cache, preenchida em rajada no miss\n";
+    std::cout << "                       (4 a 64, ex.: 16, 32, 64; padrão: 16)\n";
+    std::cout << "  --l2-size <n>        Capacidade da L2 compartilhada (inclusiva) em endereços (padrão: 4096)\n";
+    std::cout << "  --l2-ways <n>        Vias por conjunto da L2; 0 = totalmente associativa (padrão: 8)\n";
+    std::cout << "  --l2-shards <n>      Travas independentes da L2/barramento, por conjunto (padrão: 8)\n";
+    std::cout << "  --prefetch <tipo>    Prefetcher das L1: none, next-line, stride (RPT por PC)\n";
+    std::cout << "                       ou stream (padrão: none)\n";
+    std::cout << "  --prefetch-degree <n>   Linhas buscadas por disparo, 1 a 16 (padrão: 2)\n";
+    std::cout << "  --prefetch-distance <n> Linhas à frente do acesso, 1 a 64 (padrão: 1)\n";
+    std::cout << "  --victim-cache <n>   Linhas da victim cache de cada L1, até 64 (padrão: 0 = desligada)\n";
+    std::cout << "  --write-buffer <n>   Entradas do buffer de escrita para a memória, até 64\n";
+    std::cout << "                       (padrão: 0 = write-back síncrono)\n";
+    std::cout << "  --mshrs <n>          MSHRs de cada L1, até 64: misses não bloqueiam o pipeline\n";
+    std::cout << "                       (padrão: 0 = cache bloqueante)\n";
+    std::cout << "  --switch-policy <p>  Efeito da troca de contexto na L1: partial (invalida 30%),\n";
+    std::cout << "                       asid (linhas marcadas pelo pid, nada é invalidado) ou\n";
+    std::cout << "                       asid-flush (só as linhas do processo que sai) (padrão: partial)\n";
+    std::cout << "  --secondary-device <d> Tempo da memória secundária: flat (peso fixo por linha),\n";
+    std::cout << "                       disk (seek + rotação fora de acessos sequenciais) ou\n";
+    std::cout << "                       flash (latência por pedido) (padrão: flat)\n";
+    std::cout << "  --device-latency <n>   Ciclos de posicionamento/latência; 0 = padrão (disk 60, flash 12)\n";
+    std::cout << "  --device-bandwidth <n> Palavras transferidas por ciclo (padrão: 4)\n";
+    std::cout << "  --device-queue <n>     Pedidos atendidos ao mesmo tempo, até 64 (padrão: 1)\n";
+    std::cout << "  --secondary-file <arq> Memória secundária num arquivo mapeado (mmap): persiste\n";
+    std::cout << "                       entre execuções e é carregada sob demanda (padrão: em RAM)\n";
+    std::cout << "  --secondary-size <n>   Palavras do arquivo, até 2^30; 0 = tamanho atual (padrão: 0)\n";
+    std::cout << "  --frames <n>         Memória virtual paginada com n quadros na memória principal;\n";
+    std::cout << "                       as páginas vêm da secundária sob demanda (padrão: 0 = desligada)\n";
+    std::cout << "  --page-size <n>      Endereços por página, potência de 2 (padrão: 256)\n";
+    std::cout << "  --tlb <n>            Entradas da TLB de cada núcleo, até 256 (padrão: 16)\n";
+    std::cout << "  --page-replacement <p> Substituição de páginas: clock, aging (LRU aproximado)\n";
+    std::cout << "                       ou wsclock (padrão: clock)\n";
+    std::cout << "  --segmentation       Segmentação: loads e stores relativos ao segmento de dados do\n";
+    std::cout << "                       processo, buscas conferidas no de código (padrão: desligada)\n";
+    std::cout << "  --allocator <a>      Onde ficam os processos: fixed (faixas de 1024), buddy,\n";
+    std::cout << "                       first-fit ou best-fit (padrão: fixed)\n";
+    std::cout << "  --alloc-granule <n>  Menor bloco do alocador, potência de 2 até 4096 (padrão: 16)\n";
+    std::cout << "  --data-area <n>      Endereços de dados após o código de cada processo (padrão: 512)\n";
+    std::cout << "  --replicas <n>       Carrega o conjunto de processos n vezes; exige --allocator (padrão: 1).\n";
+    std::cout << "                       A arena é a memória principal + secundária (8192 + 16384), só a\n";
+    std::cout << "                       secundária com --frames, menos a faixa reservada; as cópias que\n";
+    std::cout << "                       não cabem esperam na fila até um processo liberar seu bloco\n";
     std::cout << "  --scheduler <alg>    Algoritmo: FCFS, SJN, Priority, RR (padrão: FCFS)\n";
     std::cout << "  --quantum <n>        Quantum para Round Robin (padrão: 5)\n";
+    std::cout << "  --trace <modo>       Instrumentação do pipeline: FULL (trace, snapshots e\n";
+    std::cout << "                       contagem por estágio) ou FAST (sem instrumentação) (padrão: FULL)\n";
+    std::cout << "  --ff <n>             Executa cada processo em modo funcional (sem pipeline) até a\n";
+    std::cout << "                       instrução n e então troca para o pipeline de 5 estágios\n";
+    std::cout << "  --ff-pc <addr>       Idem, trocando para o pipeline ao atingir o PC addr\n";
+    std::cout << "                       (relativo ao endereço base do processo)\n";
+    std::cout << "  --sample-period <n>  Amostragem: a cada n instruções, alterna fast-forward funcional\n";
+    std::cout << "  --sample-window <w>  com uma janela de w instruções no pipeline detalhado e\n";
+    std::cout << "                       extrapola as métricas com intervalo de confiança de 95%\n";
+    std::cout << "  --no-fusion          Desabilita as superinstruções do modo funcional (--ff/amostragem)\n";
+    std::cout << "  --engine <motor>     Motor do modo funcional: STEP (Fetch/Decode por instrução) ou\n";
+    std::cout << "                       BLOCK (blocos básicos traduzidos; não simula as buscas de\n";
+    std::cout << "                       instrução na memória) (padrão: STEP)\n";
     std::cout << "  --help, -h           Mostra esta ajuda\n\n";
     std::cout << "Exemplos:\n";
     std::cout << "  " << program_name << "\n";
@@ -122,6 +215,152 @@ CommandLineConfig parse_arguments(int argc, char* argv[]) {
             config.quantum = std::stoi(argv[++i]);
             config.interactive_mode = false;
         }
+        else if (arg == "--cache-size" && i + 1 < argc) {
+            config.cache_size = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--cache-ways" && i + 1 < argc) {
+            config.cache_ways = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--line-size" && i + 1 < argc) {
+            config.line_size = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--l2-size" && i + 1 < argc) {
+            config.l2_size = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--l2-ways" && i + 1 < argc) {
+            config.l2_ways = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--l2-shards" && i + 1 < argc) {
+            config.l2_shards = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--prefetch" && i + 1 < argc) {
+            config.prefetch = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--prefetch-degree" && i + 1 < argc) {
+            config.prefetch_degree = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--prefetch-distance" && i + 1 < argc) {
+            config.prefetch_distance = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--victim-cache" && i + 1 < argc) {
+            config.victim_cache = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--write-buffer" && i + 1 < argc) {
+            config.write_buffer = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--mshrs" && i + 1 < argc) {
+            config.mshrs = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--switch-policy" && i + 1 < argc) {
+            config.switch_policy = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--secondary-device" && i + 1 < argc) {
+            config.secondary_device = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--device-latency" && i + 1 < argc) {
+            config.device_latency = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--device-bandwidth" && i + 1 < argc) {
+            config.device_bandwidth = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--device-queue" && i + 1 < argc) {
+            config.device_queue = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--secondary-file" && i + 1 < argc) {
+            config.secondary_file = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--secondary-size" && i + 1 < argc) {
+            config.secondary_size = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--frames" && i + 1 < argc) {
+            config.frames = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--page-size" && i + 1 < argc) {
+            config.page_size = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--tlb" && i + 1 < argc) {
+            config.tlb_entries = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--page-replacement" && i + 1 < argc) {
+            config.page_replacement = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--segmentation") {
+            config.segmentation = true;
+            config.interactive_mode = false;
+        }
+        else if (arg == "--allocator" && i + 1 < argc) {
+            config.allocator = argv[++i];
+            config.interactive_mode = false;
+        }
+        else if (arg == "--alloc-granule" && i + 1 < argc) {
+            config.alloc_granule = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--data-area" && i + 1 < argc) {
+            config.data_area = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--replicas" && i + 1 < argc) {
+            config.replicas = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--ff" && i + 1 < argc) {
+            config.ff_instructions = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--ff-pc" && i + 1 < argc) {
+            config.ff_pc = std::stoll(argv[++i], nullptr, 0);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--sample-period" && i + 1 < argc) {
+            config.sample_period = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--sample-window" && i + 1 < argc) {
+            config.sample_window = std::stoll(argv[++i]);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--engine" && i + 1 < argc) {
+            config.functional_engine = argv[++i];
+            std::transform(config.functional_engine.begin(),
+                         config.functional_engine.end(),
+                         config.functional_engine.begin(), ::toupper);
+            config.interactive_mode = false;
+        }
+        else if (arg == "--no-fusion") {
+            config.fusion = false;
+            config.interactive_mode = false;
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            config.trace_mode = argv[++i];
+            std::transform(config.trace_mode.begin(), 
+                         config.trace_mode.end(), 
+                         config.trace_mode.begin(), ::toupper);
+            config.interactive_mode = false;
+        }
         else {
             std::cerr << "Argumento desconhecido: " << arg << "\n";
             std::cerr << "Use --help para ver a lista de opções.\n";
@@ -158,6 +397,15 @@ struct SchedulerMetrics {
     uint64_t total_memory_cycles = 0;
     double avg_memory_cycles_per_access = 0.0;
     double throughput = 0.0; // processos/segundo
+    CoherenceStats coherence;                // Tráfego da L2 e do protocolo MESI
+    PrefetchStats prefetch;                  // Prefetch das L1 (zerado se desligado)
+    BufferStats buffers;                     // Victim cache, write-backs e buffer de escrita
+    MshrStats mshr;                          // Misses não bloqueantes (zerado sem MSHRs)
+    DeviceStats device;                      // Pedidos à memória secundária (zerado com flat)
+    PagingStats paging;                      // TLB e faltas de página (zerado sem paginação)
+    SegmentStats segments;                   // Registradores de segmento (zerado sem segmentação)
+    AllocStats allocator;                    // Alocador das imagens (zerado com faixas fixas)
+    int deferred_admissions = 0;             // Processos que esperaram memória para entrar
     
     // Métricas de escalonamento (Requisitos do PDF)
     double avg_wait_time_ms = 0.0;          // Tempo médio de espera
@@ -269,7 +517,11 @@ SchedulerMetrics average_metrics(const std::vector<SchedulerMetrics>& runs) {
 // Função para imprimir as métricas de um processo (SIMPLIFICADA)
 void print_metrics(const PCB& pcb, std::ofstream& outFile) {
     outFile << "\n=== PROCESSO " << pcb.pid << ": " << pcb.name << " ===\n";
-    outFile << "Estado: " << (pcb.state == State::Finished ? "Finalizado" : "Incompleto") << "\n";
+    outFile << "Estado: " << (pcb.segment_fault ? "Encerrado (busca fora do segmento de código)"
+                              : pcb.state == State::Finished ? "Finalizado" : "Incompleto") << "\n";
+    if (pcb.segment_violations.load() > 0) {
+        outFile << "Violações de segmento: " << pcb.segment_violations.load() << "\n";
+    }
     outFile << "Prioridade: " << pcb.priority << " | Quantum: " << pcb.quantum << "\n";
     
     // Métricas de Tempo (Escalonamento)
@@ -282,6 +534,44 @@ void print_metrics(const PCB& pcb, std::ofstream& outFile) {
     outFile << "\n[CPU]\n";
     outFile << "  Pipeline Cycles: " << pcb.pipeline_cycles.load() << "\n";
     outFile << "  IO Cycles:       " << pcb.io_cycles.load() << "\n";
+    outFile << "  Decode Cache:    " << pcb.decode_cache.hits() << " hits / "
+            << pcb.decode_cache.misses() << " misses\n";
+    if (pcb.functional_instructions > 0) {
+        outFile << "  Fast-forward:    " << pcb.functional_instructions << " instruções (modo funcional)\n";
+    }
+    if (pcb.fusion_table.executions() > 0) {
+        outFile << "  Superinstruções: " << pcb.fusion_table.executions() << " execuções ("
+                << pcb.fusion_table.fusedInstructions() << " instruções fundidas)\n";
+    }
+    if (pcb.block_cache.executedBlocks() > 0) {
+        outFile << "  Blocos:          " << pcb.block_cache.executedBlocks() << " execuções ("
+                << pcb.block_cache.chainedTransitions() << " encadeadas, "
+                << pcb.block_cache.translations() << " traduções)\n";
+    }
+    if (pcb.instruction_count > 0) {
+        outFile << "  Host ns/instr:   " << std::fixed << std::setprecision(1)
+                << static_cast<double>(pcb.host_time_ns) / pcb.instruction_count << std::defaultfloat << "\n";
+    }
+
+    // Simulação por amostragem: estimativas extrapoladas das janelas detalhadas
+    if (pcb.sampling.used()) {
+        uint64_t instructions = static_cast<uint64_t>(pcb.instruction_count);
+        outFile << "\n[AMOSTRAGEM]\n";
+        outFile << "  Janelas:         " << pcb.sampling.windows << " ("
+                << pcb.sampling.detailed_instructions << " de " << instructions
+                << " instruções no pipeline detalhado)\n";
+        for (int m = 0; m < SAMPLE_METRIC_COUNT; ++m) {
+            SampledMetric metric = static_cast<SampledMetric>(m);
+            double est = pcb.sampling.estimate(metric, instructions);
+            double err = pcb.sampling.errorBound(metric, instructions);
+            outFile << "  " << sampledMetricName(metric) << std::fixed << std::setprecision(1) << est << " ± " << err;
+            if (est > 0.0) {
+                outFile << " (" << std::setprecision(1) << (100.0 * err / est) << "%)";
+            }
+            outFile << "\n";
+        }
+        outFile << std::defaultfloat;
+    }
     
     // Métricas de Memória (ESSENCIAL)
     outFile << "\n[MEMÓRIA]\n";
@@ -289,6 +579,7 @@ void print_metrics(const PCB& pcb, std::ofstream& outFile) {
     outFile << "    - Leituras:     " << pcb.mem_reads.load() << "\n";
     outFile << "    - Escritas:     " << pcb.mem_writes.load() << "\n";
     outFile << "  Cache L1:         " << pcb.cache_mem_accesses.load() << "\n";
+    outFile << "  Cache L2:         " << pcb.l2_mem_accesses.load() << "\n";
     outFile << "  RAM (Principal):  " << pcb.primary_mem_accesses.load() << "\n";
     outFile << "  Disco (Secund.):  " << pcb.secondary_mem_accesses.load() << "\n";
     outFile << "  Ciclos Memória:   " << pcb.memory_cycles.load() << "\n";
@@ -308,221 +599,385 @@ void print_metrics(const PCB& pcb, std::ofstream& outFile) {
     outFile << pcb.regBank.get_registers_as_string();
 
     outFile << "\n[INSTRUÇÕES EXECUTADAS]\n";
-    if (pcb.execution_log.empty()) {
+    if (pcb.execution_trace.empty()) {
         outFile << "  Nenhuma instrução registrada.\n";
     } else {
-        size_t idx = 1;
-        for (const auto& entry : pcb.execution_log) {
-            outFile << "  #" << std::setw(4) << idx++ << " " << entry << "\n";
+        // Registros mais antigos que não couberam no buffer circular
+        uint64_t dropped = pcb.execution_trace.dropped();
+        if (dropped > 0) {
+            outFile << "  (" << dropped << " registros mais antigos descartados pelo buffer do trace)\n";
         }
+        uint64_t idx = dropped + 1;
+        pcb.execution_trace.forEach([&](const TraceRecord& rec) {
+            outFile << "  #" << std::setw(4) << idx++ << " "
+                    << ExecutionTrace::format(rec, pcb.pid) << "\n";
+        });
     }
 
     outFile << "\n" << std::string(60, '-') << "\n";
 }
 
 
-// Função auxiliar para carregar processos
+// Endereços reservados a cada processo (os base_address vão de 1024 em 1024)
+const uint32_t PROCESS_SLOT = 1024;
+
+// Tabela de segmentos do processo carregado: CODE na faixa do programa
+// (a mesma da decode cache) e DATA do fim do código ao fim da faixa (ou do
+// bloco do alocador)
+void setup_segments(PCB& process) {
+    const uint32_t code_begin = process.decode_cache.begin();
+    const uint32_t code_end = process.decode_cache.end();
+    const size_t slot = process.image_size ? process.image_size : PROCESS_SLOT;
+    const uint32_t slot_end = static_cast<uint32_t>(process.base_address + slot);
+    process.segments = SegmentTable(process.pid);
+    process.segments.setSegment(SEG_CODE, code_begin, code_end - code_begin, true, "CODE");
+    if (code_end < slot_end) {
+        process.segments.setSegment(SEG_DATA, code_end, slot_end - code_end, false, "DATA");
+    }
+}
+
+// Devolve ao alocador o bloco do processo que terminou
+void release_image(MemoryManager& memManager, PCB& process) {
+    if (process.image_size == 0) return;
+    memManager.release(static_cast<uint32_t>(process.base_address));
+    process.image_size = 0;
+}
+
+// Processos carregados por load_processes, na ordem da fila
+struct ProcessSpec {
+    const char *label;   // nome no log de carga
+    const char *config;  // PCB em config_dir
+    const char *tasks;   // programa em tasks_dir
+};
+const ProcessSpec PROCESS_SPECS[] = {
+    {"Quick Process", "process_quick.json", "tasks_quick.json"},
+    {"Short Process", "process_short.json", "tasks_short.json"},
+    {"Medium Process", "process_medium.json", "tasks_medium.json"},
+    {"Long Process", "process_long.json", "tasks_long.json"},
+    {"CPU-Bound Process", "process_cpu_bound.json", "tasks_cpu_bound.json"},
+    {"IO-Bound Process", "process_io_bound.json", "tasks_io_bound.json"},
+    {"Memory-Intensive Process", "process_memory_intensive.json", "tasks_memory_intensive.json"},
+    {"Balanced Process", "process_balanced.json", "tasks_balanced.json"},
+    {"Loop-Heavy Process", "process_loop_heavy.json", "tasks_loop_heavy.json"},  // demonstra preempção
+};
+const int PROCESS_SPEC_COUNT = static_cast<int>(sizeof(PROCESS_SPECS) / sizeof(PROCESS_SPECS[0]));
+
+// Processo cuja imagem não coube na arena durante a carga: espera, em ordem
+// de chegada, um bloco devolvido por release_image
+struct WaitingImage {
+    std::unique_ptr<PCB> pcb;
+    std::string program;
+    size_t size = 0;
+};
+
+// Copia o programa para o bloco em `base` e monta os segmentos do processo
+void place_image(MemoryManager& memManager, PCB& pcb, const std::string& program, size_t base) {
+    pcb.execution_trace.clear(); // Limpar trace antes de carregar
+    pcb.base_address = base;  // Endereço base do processo
+    pcb.regBank.reset();  // Reset dos registradores
+    pcb.regBank.pc.write(pcb.base_address);  // PC inicia no base_address
+    loadJsonProgram(program, memManager, pcb, static_cast<int>(base));
+    // Segmentos (usados com --segmentation): o código que o carregador
+    // colocou, somente leitura, e os dados no resto da faixa
+    setup_segments(pcb);
+}
+
+// Admite os processos da fila enquanto o primeiro couber num bloco livre
+// (chamada depois de release_image). A imagem vai para o bloco pelo núcleo
+// `core`, sem cópias do dono anterior nas caches. Devolve os admitidos, que
+// passam para `process_list`.
+std::vector<PCB*> admit_waiting(MemoryManager& memManager, std::deque<WaitingImage>& waiting,
+                                std::vector<std::unique_ptr<PCB>>& process_list, int core = 0) {
+    std::vector<PCB*> admitted;
+    while (!waiting.empty()) {
+        WaitingImage& next = waiting.front();
+        long block = memManager.allocate(next.size);
+        if (block < 0) break;
+        memManager.discardLines(static_cast<uint32_t>(block), next.size);
+        next.pcb->image_size = next.size;
+        next.pcb->core_id = core;
+        place_image(memManager, *next.pcb, next.program, static_cast<size_t>(block));
+        admitted.push_back(next.pcb.get());
+        process_list.push_back(std::move(next.pcb));
+        waiting.pop_front();
+    }
+    return admitted;
+}
+
+// Função auxiliar para carregar processos. Sem alocador, o processo i fica
+// na faixa fixa i * PROCESS_SLOT; com alocador, num bloco do tamanho do
+// programa mais a área de dados. `replicas` repete o conjunto (os pids das
+// cópias são deslocados para continuarem únicos). Com `waiting`, os
+// processos que não cabem na arena vão para a fila de admissão em vez de
+// serem descartados; só fica de fora a imagem maior que a arena vazia.
 std::vector<std::unique_ptr<PCB>> load_processes(MemoryManager& memManager, 
                                                   const std::string& config_dir = "processes",
-                                                  const std::string& tasks_dir = "tasks") {
+                                                  const std::string& tasks_dir = "tasks",
+                                                  int replicas = 1,
+                                                  std::deque<WaitingImage>* waiting = nullptr) {
     std::vector<std::unique_ptr<PCB>> process_list;
     
     std::cout << "\n[LOAD_PROCESSES] Iniciando carregamento de processos...\n";
     std::cout << "   Config Dir: " << config_dir << "\n";
     std::cout << "   Tasks Dir:  " << tasks_dir << "\n\n";
     
+    const AllocConfig& alloc = memManager.getAllocConfig();
+    const AllocStats empty_arena = memManager.allocatorStats();
+    const int total = PROCESS_SPEC_COUNT * std::max(replicas, 1);
     int loaded_count = 0;
     
-    // Processo 1: Quick
-    std::cout << "   [1/9] Carregando Quick Process... ";
-    auto p1 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_quick.json", *p1)) {
-        p1->execution_log.clear(); // Limpar log antes de carregar
-        p1->base_address = 0;  // Endereço base do processo
-        p1->regBank.reset();  // Reset dos registradores
-        p1->regBank.pc.write(p1->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_quick.json", memManager, *p1, 0);
-        process_list.push_back(std::move(p1));
+    for (int index = 0; index < total; ++index) {
+        const ProcessSpec& spec = PROCESS_SPECS[index % PROCESS_SPEC_COUNT];
+        std::cout << "   [" << index + 1 << "/" << total << "] Carregando " << spec.label << "... ";
+        auto pcb = std::make_unique<PCB>();
+        if (!load_pcb_from_json(config_dir + "/" + spec.config, *pcb)) {
+            std::cout << "❌ Falhou\n";
+            continue;
+        }
+        pcb->pid += (index / PROCESS_SPEC_COUNT) * PROCESS_SPEC_COUNT;
+        const std::string program = tasks_dir + "/" + spec.tasks;
+        
+        size_t base = static_cast<size_t>(index) * PROCESS_SLOT;
+        if (alloc.enabled()) {
+            const size_t size = static_cast<size_t>(jsonProgramSize(program)) + alloc.data_area;
+            if (size > empty_arena.largest_free) {
+                std::cout << "❌ Imagem de " << size << " endereços maior que a arena ("
+                          << empty_arena.largest_free << ")\n";
+                continue;
+            }
+            long block = memManager.allocate(size);
+            if (block < 0) {
+                if (!waiting) {
+                    std::cout << "❌ Sem memória para " << size << " endereços\n";
+                    continue;
+                }
+                std::cout << "⏳ Sem memória para " << size << " endereços: aguarda um bloco liberado\n";
+                waiting->push_back(WaitingImage{std::move(pcb), program, size});
+                continue;
+            }
+            base = static_cast<size_t>(block);
+            pcb->image_size = size;
+        }
+        
+        place_image(memManager, *pcb, program, base);
+        process_list.push_back(std::move(pcb));
         std::cout << " PID: " << process_list.back()->pid << "\n";
         loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
     }
-
-    // Processo 2: Short
-    std::cout << "   [2/9] Carregando Short Process... ";
-    auto p2 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_short.json", *p2)) {
-        p2->execution_log.clear(); // Limpar log antes de carregar
-        p2->base_address = 1024;  // Endereço base do processo
-        p2->regBank.reset();  // Reset dos registradores
-        p2->regBank.pc.write(p2->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_short.json", memManager, *p2, 1024);
-        process_list.push_back(std::move(p2));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+    
+    std::cout << "\n   📦 Total: " << loaded_count << "/" << total << " processos carregados com sucesso!\n";
+    if (waiting && !waiting->empty()) {
+        // A arena não comporta todas as imagens ao mesmo tempo: as demais
+        // entram conforme os processos terminam
+        std::cout << "   ⏳ " << waiting->size() << " processos aguardam memória (arena de "
+                  << empty_arena.arena << " endereços)\n";
     }
 
-    // Processo 3: Medium
-    std::cout << "   [3/9] Carregando Medium Process... ";
-    auto p3 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_medium.json", *p3)) {
-        p3->execution_log.clear(); // Limpar log antes de carregar
-        p3->base_address = 2048;  // Endereço base do processo
-        p3->regBank.reset();  // Reset dos registradores
-        p3->regBank.pc.write(p3->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_medium.json", memManager, *p3, 2048);
-        process_list.push_back(std::move(p3));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+    // Registrar tempo de chegada de todos os processos (a espera por memória
+    // conta como espera)
+    auto arrival = std::chrono::high_resolution_clock::now();
+    for (auto& proc : process_list) {
+        proc->arrival_time = arrival;
     }
+    if (waiting) {
+        for (auto& image : *waiting) {
+            image.pcb->arrival_time = arrival;
+        }
+    }
+    
+    return process_list;
+}
 
-    // Processo 4: Long
-    std::cout << "   [4/9] Carregando Long Process... ";
-    auto p4 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_long.json", *p4)) {
-        p4->execution_log.clear(); // Limpar log antes de carregar
-        p4->base_address = 3072;  // Endereço base do processo
-        p4->regBank.reset();  // Reset dos registradores
-        p4->regBank.pc.write(p4->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_long.json", memManager, *p4, 3072);
-        process_list.push_back(std::move(p4));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+// Função para executar um escalonador e retornar suas métricas
+// Estatísticas da hierarquia de cache (L1 por núcleo, L2 e coerência) ao fim da execução
+void print_cache_hierarchy(MemoryManager& memManager, const CoherenceStats& coherence,
+                           const PrefetchStats& prefetch, const BufferStats& buffers,
+                           const MshrStats& mshr, std::ofstream& outFile) {
+    outFile << "\n=== HIERARQUIA DE CACHE ===\n";
+    for (size_t core = 0; core < memManager.numCores(); ++core) {
+        Cache& l1 = memManager.l1(core);
+        uint64_t hits = l1.get_hits();
+        uint64_t misses = l1.get_misses();
+        double rate = (hits + misses > 0) ? (100.0 * hits / (hits + misses)) : 0.0;
+        outFile << "  L1 núcleo " << core << ":     " << hits << " hits / " << misses << " misses ("
+                << std::fixed << std::setprecision(2) << rate << "%)\n" << std::defaultfloat;
     }
+    outFile << "  L2 compartilhada: " << coherence.l2_hits << " hits / " << coherence.l2_misses << " misses\n";
+    outFile << "\n[COERÊNCIA MESI]\n";
+    outFile << "  Invalidações:     " << coherence.invalidations << "\n";
+    outFile << "  Intervenções:     " << coherence.interventions << "\n";
+    outFile << "  Upgrades S->M:    " << coherence.upgrades << "\n";
+    outFile << "  Back-invalidações: " << coherence.back_invalidations << "\n";
 
-    // Processo 5: CPU-Bound
-    std::cout << "   [5/9] Carregando CPU-Bound Process... ";
-    auto p5 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_cpu_bound.json", *p5)) {
-        p5->execution_log.clear(); // Limpar log antes de carregar
-        p5->base_address = 4096;  // Endereço base do processo
-        p5->regBank.reset();  // Reset dos registradores
-        p5->regBank.pc.write(p5->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_cpu_bound.json", memManager, *p5, 4096);
-        process_list.push_back(std::move(p5));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
+    SwitchStats switching = memManager.switchStats();
+    outFile << "\n[TROCA DE CONTEXTO: " << switchPolicyName(memManager.getSwitchPolicy()) << "]\n";
+    outFile << "  Trocas:            " << switching.switches << "\n";
+    outFile << "  Linhas invalidadas: " << switching.invalidated_lines << "\n";
+
+    FlushStats flush = memManager.flushStats();
+    outFile << "\n[FLUSH DE LINHAS SUJAS]\n";
+    outFile << "  Flushes:           " << flush.flushes << "\n";
+    outFile << "  Linhas escritas:   " << flush.lines << " em " << flush.batches << " lotes\n";
+    outFile << "  Ciclos:            " << flush.cycles << " (" << flush.unbatched_cycles << " linha a linha)\n";
+
+    const BufferConfig& bc = memManager.getBufferConfig();
+    outFile << "\n[WRITE-BACK]\n";
+    outFile << "  Linhas escritas na memória: " << buffers.writebacks << "\n";
+    if (bc.write_buffer_entries == 0) {
+        outFile << "  Ciclos síncronos:  " << buffers.writeback_cycles << " (sem buffer de escrita)\n";
     } else {
-        std::cout << "❌ Falhou\n";
+        outFile << "  Buffer de escrita: " << bc.write_buffer_entries << " entradas\n";
+        outFile << "  Coalescidas:       " << buffers.coalesced << "\n";
+        outFile << "  Leituras do buffer: " << buffers.forwards << "\n";
+        outFile << "  Esperas (cheio):   " << buffers.full_stalls << " (" << buffers.stall_cycles << " ciclos)\n";
+    }
+    if (bc.victim_lines > 0) {
+        outFile << "  Victim cache:      " << bc.victim_lines << " linhas/L1, " << buffers.victim_hits
+                << " hits / " << buffers.victim_misses << " misses\n";
     }
 
-    // Processo 6: IO-Bound
-    std::cout << "   [6/9] Carregando IO-Bound Process... ";
-    auto p6 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_io_bound.json", *p6)) {
-        p6->execution_log.clear(); // Limpar log antes de carregar
-        p6->base_address = 5120;  // Endereço base do processo
-        p6->regBank.reset();  // Reset dos registradores
-        p6->regBank.pc.write(p6->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_io_bound.json", memManager, *p6, 5120);
-        process_list.push_back(std::move(p6));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+    const DeviceConfig& dev = memManager.getDeviceConfig();
+    if (!dev.backing_file.empty()) {
+        outFile << "\n[ARQUIVO SECUNDÁRIO: " << dev.backing_file << ", "
+                << memManager.getSecondaryCapacity() << " palavras, mmap]\n";
+    }
+    if (dev.timed()) {
+        DeviceStats device = memManager.deviceStats();
+        outFile << "\n[MEMÓRIA SECUNDÁRIA: " << deviceKindName(dev.kind) << ", latência " << dev.effectiveLatency()
+                << ", " << dev.bandwidth << " palavras/ciclo, fila " << dev.queue_depth << "]\n";
+        outFile << "  Pedidos:           " << device.requests << " (" << device.sequential << " sequenciais)\n";
+        outFile << "  Esperas na fila:   " << device.queued << " (" << device.queue_cycles << " ciclos)\n";
+        outFile << "  Ciclos de serviço: " << device.service_cycles << "\n";
     }
 
-    // Processo 7: Memory-Intensive
-    std::cout << "   [7/9] Carregando Memory-Intensive Process... ";
-    auto p7 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_memory_intensive.json", *p7)) {
-        p7->execution_log.clear(); // Limpar log antes de carregar
-        p7->base_address = 6144;  // Endereço base do processo
-        p7->regBank.reset();  // Reset dos registradores
-        p7->regBank.pc.write(p7->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_memory_intensive.json", memManager, *p7, 6144);
-        process_list.push_back(std::move(p7));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+    const PageConfig& pages = memManager.getPageConfig();
+    if (pages.enabled()) {
+        PagingStats paging = memManager.pagingStats();
+        outFile << "\n[PAGINAÇÃO: " << pages.frames << " quadros de " << pages.page_size << ", "
+                << pageReplacementName(pages.replacement) << "]\n";
+        outFile << "  TLB:               " << paging.tlb_hits << " hits / " << paging.tlb_misses << " misses ("
+                << pages.tlb_entries << " entradas por núcleo)\n";
+        outFile << "  Faltas de página:  " << paging.faults << "\n";
+        outFile << "  Expulsões:         " << paging.evictions << " (" << paging.dirty_writebacks << " páginas sujas gravadas)\n";
+        outFile << "  Shootdowns:        " << paging.shootdowns << "\n";
+        outFile << "  Ciclos:            " << paging.walk_cycles << " em percursos, " << paging.fault_cycles
+                << " em faltas\n";
     }
 
-    // Processo 8: Balanced
-    std::cout << "   [8/9] Carregando Balanced Process... ";
-    auto p8 = std::make_unique<PCB>();
-    if (load_pcb_from_json(config_dir + "/process_balanced.json", *p8)) {
-        p8->execution_log.clear(); // Limpar log antes de carregar
-        p8->base_address = 7168;  // Endereço base do processo
-        p8->regBank.reset();  // Reset dos registradores
-        p8->regBank.pc.write(p8->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_balanced.json", memManager, *p8, 7168);
-        process_list.push_back(std::move(p8));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+    const AllocConfig& alloc = memManager.getAllocConfig();
+    if (alloc.enabled()) {
+        AllocStats allocator = memManager.allocatorStats();
+        outFile << "\n[ALOCADOR: " << allocPolicyName(alloc.policy) << ", arena de " << allocator.arena
+                << " endereços, grânulo " << alloc.granule << "]\n";
+        outFile << "  Alocações:         " << allocator.allocations << " (" << allocator.failures << " falhas), "
+                << allocator.frees << " liberações\n";
+        outFile << "  Em uso:            " << allocator.in_use << " endereços (pico " << allocator.peak_in_use << ")\n";
+        outFile << "  Livre:             " << allocator.free_total << " endereços em " << allocator.free_blocks
+                << " blocos (maior: " << allocator.largest_free << ")\n";
+        outFile << "  Fragmentação:      " << std::fixed << std::setprecision(2)
+                << 100.0 * allocator.internalFragmentation() << "% interna, "
+                << 100.0 * allocator.externalFragmentation() << "% externa\n" << std::defaultfloat;
+        outFile << "  Divisões/uniões:   " << allocator.splits << " / " << allocator.merges << "\n";
+        outFile << "  Latência:          " << allocator.search_steps << " blocos examinados, "
+                << allocator.alloc_ns << " ns no total (máx. " << allocator.max_alloc_ns << " ns)\n";
     }
-    
-    // Processo 9: Loop-Heavy (para demonstrar preempção)
-    std::cout << "   [9/9] Carregando Loop-Heavy Process... ";
-    auto p9 = std::make_unique<PCB>();
-    bool loaded = load_pcb_from_json(config_dir + "/process_loop_heavy.json", *p9);
-    if (loaded) {
-        p9->execution_log.clear(); // Limpar log antes de carregar
-        p9->base_address = 8192;  // Endereço base do processo
-        p9->regBank.reset();  // Reset dos registradores
-        p9->regBank.pc.write(p9->base_address);  // PC inicia no base_address
-        loadJsonProgram(tasks_dir + "/tasks_loop_heavy.json", memManager, *p9, 8192);
-        process_list.push_back(std::move(p9));
-        std::cout << " PID: " << process_list.back()->pid << "\n";
-        loaded_count++;
-    } else {
-        std::cout << "❌ Falhou\n";
+
+    if (memManager.segmentationEnabled()) {
+        SegmentStats segments = memManager.segmentStats();
+        outFile << "\n[SEGMENTAÇÃO: registradores de segmento por núcleo]\n";
+        outFile << "  Acessos:           " << segments.register_hits << " pelo descritor em cache, "
+                << segments.descriptor_loads << " com recarga\n";
+        outFile << "  Ciclos de recarga: " << segments.load_cycles << "\n";
+        outFile << "  Violações:         " << segments.limit_faults << " de limite, " << segments.protection_faults
+                << " de proteção, " << segments.not_present_faults << " de segmento ausente\n";
     }
-    
-    std::cout << "\n   📦 Total: " << loaded_count << "/9 processos carregados com sucesso!\n";
-    
-    // Registrar tempo de chegada de todos os processos
-    auto arrival = std::chrono::high_resolution_clock::now();
-    for (auto& proc : process_list) {
-        proc->arrival_time = arrival;
+
+    if (memManager.getMshrEntries() > 0) {
+        outFile << "\n[MSHR: " << memManager.getMshrEntries() << " por L1]\n";
+        outFile << "  Misses primários:  " << mshr.misses << "\n";
+        outFile << "  Misses secundários: " << mshr.merged << " (juntados a um pedido em curso)\n";
+        outFile << "  Pico simultâneo:   " << mshr.peak << "\n";
+        outFile << "  Esperas por MSHR:  " << mshr.full_stalls << "\n";
+        outFile << "  Esperas por dado:  " << mshr.dependency_stalls << "\n";
+        outFile << "  Latência de miss:  " << mshr.miss_cycles << " ciclos\n";
+        outFile << "  Ciclos de espera:  " << mshr.stall_cycles << "\n";
     }
-    
-    return process_list;
+
+    const PrefetchConfig& pf = memManager.getPrefetchConfig();
+    if (!pf.enabled()) return;
+    outFile << "\n[PREFETCH: " << prefetchKindName(pf.kind) << ", grau " << pf.degree
+            << ", distância " << pf.distance << "]\n";
+    outFile << "  Emitidos:         " << prefetch.issued << "\n";
+    outFile << "  Úteis:            " << prefetch.useful << "\n";
+    outFile << "  Atrasados:        " << prefetch.late << "\n";
+    outFile << "  Não usados:       " << (prefetch.issued - std::min(prefetch.issued, prefetch.useful + prefetch.late)) << "\n";
+    outFile << "  Redundantes:      " << prefetch.redundant << " (linha já na L1)\n";
+    outFile << "  Ciclos de tráfego: " << prefetch.fill_cycles << "\n";
+    outFile << "  Ciclos economizados: " << prefetch.saved_cycles << "\n";
 }
 
-// Função para executar um escalonador e retornar suas métricas
 SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string& scheduler_name, 
                                bool save_logs = false,
                                const std::string& config_dir = "processes",
                                const std::string& tasks_dir = "tasks",
                                const std::string& output_dir = "output",
-                               const std::string& replacement_policy = "FIFO") {
+                               const std::string& replacement_policy = "FIFO",
+                               const CoreOptions& core_options = CoreOptions{},
+                               const CacheConfig& cache_config = CacheConfig{},
+                               const CacheConfig& l2_config = defaultL2Config(),
+                               const PrefetchConfig& prefetch_config = PrefetchConfig{},
+                               const BufferConfig& buffer_config = BufferConfig{},
+                               size_t mshrs = 0,
+                               SwitchPolicy switch_policy = SwitchPolicy::Partial,
+                               const DeviceConfig& device_config = DeviceConfig{},
+                               const PageConfig& page_config = PageConfig{},
+                               bool segmentation = false,
+                               const AllocConfig& alloc_config = AllocConfig{},
+                               int replicas = 1) {
     SchedulerMetrics metrics;
     metrics.name = scheduler_name;
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    MemoryManager memManager(8192, 16384);
+    MemoryManager memManager(8192, 16384, cache_config, 1, l2_config);
     // Reset cache para garantir execução limpa entre escalonadores
     memManager.resetCache();
     
     // Aplicar política de cache configurada
-    ReplacementPolicy policy = (replacement_policy == "LRU") ? 
-                               ReplacementPolicy::LRU : 
-                               ReplacementPolicy::FIFO;
+    ReplacementPolicy policy = ReplacementPolicy::FIFO;
+    parseReplacementPolicy(replacement_policy, policy);
     memManager.setCachePolicy(policy);
+    memManager.configurePrefetcher(prefetch_config);
+    memManager.configureBuffers(buffer_config);
+    memManager.configureMshrs(mshrs);
+    memManager.setSwitchPolicy(switch_policy);
+    memManager.configureDevice(device_config);
+    memManager.configurePaging(page_config);
+    memManager.configureSegmentation(segmentation);
+    memManager.configureAllocator(alloc_config);
     
     IOManager ioManager;
     Scheduler scheduler(scheduler_type);
     
-    auto process_list = load_processes(memManager, config_dir, tasks_dir);
+    std::deque<WaitingImage> waiting;
+    auto process_list = load_processes(memManager, config_dir, tasks_dir, replicas, &waiting);
     
     for (const auto& process : process_list) {
         scheduler.add_process(process.get());
     }
 
-    int total_processes = process_list.size();
+    int total_processes = process_list.size() + waiting.size();
     int finished_processes = 0;
     std::vector<PCB*> blocked_list;
+    metrics.deferred_admissions = static_cast<int>(waiting.size());
+
+    // O bloco devolvido por um processo que terminou admite os que esperam memória
+    auto release_and_admit = [&](PCB& process) {
+        release_image(memManager, process);
+        for (PCB* admitted : admit_waiting(memManager, waiting, process_list)) {
+            scheduler.add_process(admitted);
+        }
+    };
 
     mkdir(output_dir.c_str(), 0755);
     std::ofstream results_file;
@@ -536,6 +991,9 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
     // Debug: contadores por processo
     std::map<int, int> process_exec_count;
     
+    // Unidade de controle do núcleo, reaproveitada em todos os quanta
+    Control_Unit core_unit;
+
     while (finished_processes < total_processes && iteration_count < max_iterations) {
         iteration_count++;
         
@@ -577,17 +1035,18 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
         bool print_lock = false;  // Desabilitado para evitar bloqueio em PRINT
 
         int before_instr = current_process->instruction_count;
-        size_t before_log = current_process->execution_log.size();
+        uint64_t before_log = current_process->execution_trace.total();
 
         // Debug: incrementar contador
         process_exec_count[current_process->pid]++;
         
-        Core(memManager, *current_process, &io_requests, print_lock);
+        Core(memManager, *current_process, &io_requests, print_lock, core_options, &core_unit);
 
         if (current_process->state == State::Blocked) {
             ioManager.registerProcessWaitingForIO(current_process);
             blocked_list.push_back(current_process);
         } else if (current_process->state == State::Finished) {
+            release_and_admit(*current_process);
             // Registrar tempo de término
             current_process->finish_time = std::chrono::high_resolution_clock::now();
             
@@ -609,7 +1068,7 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
             }
             
             // Acumular métricas
-            metrics.total_pipeline_cycles += current_process->pipeline_cycles.load();
+            metrics.total_pipeline_cycles += pipeline_cycles_estimate(*current_process);
             metrics.total_memory_accesses += current_process->mem_accesses_total.load();
             metrics.total_cache_hits += current_process->cache_hits.load();
             metrics.total_cache_misses += current_process->cache_misses.load();
@@ -628,7 +1087,7 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
             finished_processes++;
         } else {
             bool progressed = (current_process->instruction_count > before_instr) || 
-                            (current_process->execution_log.size() > before_log);
+                            (current_process->execution_trace.total() > before_log);
             
             // Remover logging de debug excessivo
             
@@ -664,6 +1123,7 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
                     }
                     
                     current_process->state = State::Finished;
+                    release_and_admit(*current_process);
                     finished_processes++;
                     continue;
                 }
@@ -672,14 +1132,26 @@ SchedulerMetrics run_scheduler(SchedulerType scheduler_type, const std::string&
             
             // Simular cache pollution durante context switch
             // Quanto mais processos, mais a cache é "poluída"
-            memManager.simulateContextSwitch();
+            memManager.simulateContextSwitch(0, current_process->pid, current_process->memWeights);
             scheduler.increment_context_switch();
             
             scheduler.add_process(current_process);
         }
     }
 
+    // Linhas sujas ainda nas caches vão para a memória: estado final correto
+    memManager.flushCaches();
+    metrics.coherence = memManager.coherenceStats();
+    metrics.prefetch = memManager.prefetchStats();
+    metrics.buffers = memManager.bufferStats();
+    metrics.mshr = memManager.mshrStats();
+    metrics.device = memManager.deviceStats();
+    metrics.paging = memManager.pagingStats();
+    metrics.segments = memManager.segmentStats();
+    metrics.allocator = memManager.allocatorStats();
     if (save_logs && results_file.is_open()) {
+        print_cache_hierarchy(memManager, metrics.coherence, metrics.prefetch, metrics.buffers, metrics.mshr,
+                              results_file);
         results_file.close();
     }
     
@@ -732,7 +1204,19 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                                          const std::string& config_dir = "processes",
                                          const std::string& tasks_dir = "tasks",
                                          const std::string& output_dir = "output",
-                                         const std::string& replacement_policy = "FIFO") {
+                                         const std::string& replacement_policy = "FIFO",
+                                         const CoreOptions& core_options = CoreOptions{},
+                                         const CacheConfig& cache_config = CacheConfig{},
+                                         const CacheConfig& l2_config = defaultL2Config(),
+                                         const PrefetchConfig& prefetch_config = PrefetchConfig{},
+                                         const BufferConfig& buffer_config = BufferConfig{},
+                                         size_t mshrs = 0,
+                                         SwitchPolicy switch_policy = SwitchPolicy::Partial,
+                                         const DeviceConfig& device_config = DeviceConfig{},
+                                         const PageConfig& page_config = PageConfig{},
+                                         bool segmentation = false,
+                                         const AllocConfig& alloc_config = AllocConfig{},
+                                         int replicas = 1) {
     SchedulerMetrics metrics;
     metrics.name = scheduler_name;
     metrics.num_cores = num_cores;
@@ -740,32 +1224,54 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
     auto start_time = std::chrono::high_resolution_clock::now();
     
     // Gerenciadores compartilhados
-    MemoryManager memManager(8192, 16384);
+    // Uma L1 privada por núcleo e a L2 compartilhada
+    MemoryManager memManager(8192, 16384, cache_config, static_cast<size_t>(num_cores), l2_config);
     memManager.resetCache();
     
     // Aplicar política de cache configurada
-    ReplacementPolicy policy = (replacement_policy == "LRU") ? 
-                               ReplacementPolicy::LRU : 
-                               ReplacementPolicy::FIFO;
+    ReplacementPolicy policy = ReplacementPolicy::FIFO;
+    parseReplacementPolicy(replacement_policy, policy);
     memManager.setCachePolicy(policy);
+    memManager.configurePrefetcher(prefetch_config);
+    memManager.configureBuffers(buffer_config);
+    memManager.configureMshrs(mshrs);
+    memManager.setSwitchPolicy(switch_policy);
+    memManager.configureDevice(device_config);
+    memManager.configurePaging(page_config);
+    memManager.configureSegmentation(segmentation);
+    memManager.configureAllocator(alloc_config);
     
     IOManager ioManager;
     Scheduler scheduler(scheduler_type);
     
     // Carregar processos
-    auto process_list = load_processes(memManager, config_dir, tasks_dir);
+    std::deque<WaitingImage> waiting;
+    auto process_list = load_processes(memManager, config_dir, tasks_dir, replicas, &waiting);
     
     for (const auto& process : process_list) {
         scheduler.add_process(process.get());
     }
 
-    int total_processes = process_list.size();
+    int total_processes = process_list.size() + waiting.size();
     std::atomic<int> finished_processes{0};
     std::vector<PCB*> blocked_list;
     std::mutex blocked_mutex;
     std::mutex scheduler_mutex;
     std::mutex metrics_mutex;
     std::mutex memory_mutex;  // Proteger acesso ao MemoryManager
+    std::mutex admission_mutex;  // Fila de admissão e process_list
+    metrics.deferred_admissions = static_cast<int>(waiting.size());
+
+    // O bloco devolvido por um processo que terminou admite os que esperam
+    // memória; a imagem é gravada pelo núcleo que liberou o bloco
+    auto release_and_admit = [&](PCB& process, int core_id) {
+        release_image(memManager, process);
+        std::lock_guard<std::mutex> lock(admission_mutex);
+        for (PCB* admitted : admit_waiting(memManager, waiting, process_list, core_id)) {
+            std::lock_guard<std::mutex> sched_lock(scheduler_mutex);
+            scheduler.add_process(admitted);
+        }
+    };
     
     create_output_directory();
     std::ofstream results_file;
@@ -785,6 +1291,9 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
     
     // Função executada por cada núcleo
     auto core_function = [&](int core_id) {
+        // Unidade de controle persistente deste núcleo (latches reaproveitados)
+        Control_Unit core_unit;
+
         while (!should_stop.load() && finished_processes.load() < total_processes) {
             // Verificar processos bloqueados
             {
@@ -821,20 +1330,21 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                 // **IMPORTANTE**: Simular cache cold start para processos novos
                 // Cada processo novo "polui" a cache parcialmente ao carregar suas instruções/dados
                 // Em multicore, isso é menos severo pois cada core pode ter sua própria cache L1
-                memManager.simulateContextSwitchLight();  // Invalidação leve (10%)
+                memManager.simulateContextSwitchLight(core_id);  // Invalidação leve (10%)
             }
             
             current_process->state = State::Running;
+            current_process->core_id = core_id;  // acessos passam pela L1 deste núcleo
             core_metrics[core_id].busy_cycles.fetch_add(1);
             
             std::vector<std::unique_ptr<IORequest>> io_requests;
             bool print_lock = false;  // Desabilitado para evitar bloqueio em PRINT
             
             int before_instr = current_process->instruction_count;
-            size_t before_log = current_process->execution_log.size();
+            uint64_t before_log = current_process->execution_trace.total();
             
             // Executar processo
-            Core(memManager, *current_process, &io_requests, print_lock);
+            Core(memManager, *current_process, &io_requests, print_lock, core_options, &core_unit);
             
             // Processar resultado
             if (current_process->state == State::Blocked) {
@@ -842,6 +1352,7 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                 ioManager.registerProcessWaitingForIO(current_process);
                 blocked_list.push_back(current_process);
             } else if (current_process->state == State::Finished) {
+                release_and_admit(*current_process, core_id);
                 // Registrar tempo de término
                 current_process->finish_time = std::chrono::high_resolution_clock::now();
                 
@@ -865,7 +1376,7 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                         print_metrics(*current_process, results_file);
                     }
                     
-                    metrics.total_pipeline_cycles += current_process->pipeline_cycles.load();
+                    metrics.total_pipeline_cycles += pipeline_cycles_estimate(*current_process);
                     metrics.total_memory_accesses += current_process->mem_accesses_total.load();
                     metrics.total_cache_hits += current_process->cache_hits.load();
                     metrics.total_cache_misses += current_process->cache_misses.load();
@@ -884,7 +1395,7 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                 finished_processes.fetch_add(1);
             } else {
                 bool progressed = (current_process->instruction_count > before_instr) || 
-                                (current_process->execution_log.size() > before_log);
+                                (current_process->execution_trace.total() > before_log);
                 if (progressed) {
                     current_process->stagnation_counter = 0;
                 } else {
@@ -920,13 +1431,14 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
                         }
                         
                         current_process->state = State::Finished;
+                        release_and_admit(*current_process, core_id);
                         finished_processes.fetch_add(1);
                         continue;
                     }
                 }
                 
                 current_process->state = State::Ready;
-                memManager.simulateContextSwitch();
+                memManager.simulateContextSwitch(core_id, current_process->pid, current_process->memWeights);
                 
                 {
                     std::lock_guard<std::mutex> lock(scheduler_mutex);
@@ -948,7 +1460,19 @@ SchedulerMetrics run_multicore_scheduler(int num_cores, SchedulerType scheduler_
         thread.join();
     }
     
+    // Linhas sujas ainda nas caches vão para a memória: estado final correto
+    memManager.flushCaches();
+    metrics.coherence = memManager.coherenceStats();
+    metrics.prefetch = memManager.prefetchStats();
+    metrics.buffers = memManager.bufferStats();
+    metrics.mshr = memManager.mshrStats();
+    metrics.device = memManager.deviceStats();
+    metrics.paging = memManager.pagingStats();
+    metrics.segments = memManager.segmentStats();
+    metrics.allocator = memManager.allocatorStats();
     if (save_logs && results_file.is_open()) {
+        print_cache_hierarchy(memManager, metrics.coherence, metrics.prefetch, metrics.buffers, metrics.mshr,
+                              results_file);
         results_file.close();
     }
     
@@ -1393,9 +1917,171 @@ int main(int argc, char* argv[]) {
         }
         
         // Validar política de substituição
-        if (config.replacement_policy != "FIFO" && config.replacement_policy != "LRU") {
+        ReplacementPolicy parsed_policy;
+        if (!parseReplacementPolicy(config.replacement_policy, parsed_policy)) {
             std::cerr << "Política de substituição inválida: " << config.replacement_policy << "\n";
-            std::cerr << "   Use: FIFO ou LRU\n";
+            std::cerr << "   Use: FIFO, LRU, CLOCK, LFU, ARC, 2Q ou SRRIP\n";
+            return 1;
+        }
+        config.replacement_policy = replacementPolicyName(parsed_policy);
+        
+        // Validar modo de instrumentação
+        if (config.trace_mode != "FULL" && config.trace_mode != "FAST") {
+            std::cerr << "Modo de trace inválido: " << config.trace_mode << "\n";
+            std::cerr << "   Use: FULL ou FAST\n";
+            return 1;
+        }
+        if (config.functional_engine != "STEP" && config.functional_engine != "BLOCK") {
+            std::cerr << "Motor funcional inválido: " << config.functional_engine << "\n";
+            std::cerr << "   Use: STEP ou BLOCK\n";
+            return 1;
+        }
+        if (config.ff_instructions < 0) {
+            std::cerr << "Valor inválido para --ff: " << config.ff_instructions << "\n";
+            return 1;
+        }
+
+        // Período e janela vêm juntos: um sem o outro desligaria a amostragem em silêncio
+        if (config.sample_period < 0 || config.sample_window < 0 ||
+            ((config.sample_period > 0 || config.sample_window > 0) &&
+             (config.sample_window == 0 || config.sample_window >= config.sample_period))) {
+            std::cerr << "Amostragem inválida: use --sample-period e --sample-window juntos, "
+                         "com a janela menor que o período\n";
+            return 1;
+        }
+
+        CoreOptions core_options;
+        core_options.trace = (config.trace_mode == "FAST") ? TraceMode::Fast : TraceMode::Full;
+        core_options.ff_instructions = static_cast<uint64_t>(config.ff_instructions);
+        core_options.ff_to_pc = (config.ff_pc >= 0);
+        core_options.ff_pc = core_options.ff_to_pc ? static_cast<uint32_t>(config.ff_pc) : 0;
+        core_options.sample_period = static_cast<uint64_t>(config.sample_period);
+        core_options.sample_window = static_cast<uint64_t>(config.sample_window);
+        core_options.fusion = config.fusion;
+        core_options.engine = (config.functional_engine == "BLOCK") ? FunctionalEngine::Block : FunctionalEngine::Step;
+
+        CacheConfig cache_config;
+        cache_config.capacity = static_cast<size_t>(std::max(0LL, config.cache_size));
+        cache_config.ways = static_cast<size_t>(std::max(0LL, config.cache_ways));
+        cache_config.line_size = static_cast<size_t>(std::max(0LL, config.line_size));
+        if (config.cache_size <= 0 || config.cache_ways < 0 || config.line_size < 4 ||
+            !cache_config.valid()) {
+            std::cerr << "Geometria de cache inválida: " << config.cache_size << " endereços, "
+                      << config.cache_ways << " vias, linhas de " << config.line_size << " endereços\n";
+            std::cerr << "   A linha deve ter de 4 a 64 endereços e a capacidade deve ser múltipla\n"
+                      << "   do tamanho da linha e do número de vias\n";
+            return 1;
+        }
+
+        CacheConfig l2_config;
+        l2_config.capacity = static_cast<size_t>(std::max(0LL, config.l2_size));
+        l2_config.ways = static_cast<size_t>(std::max(0LL, config.l2_ways));
+        l2_config.line_size = cache_config.line_size;
+        l2_config.shards = static_cast<size_t>(std::max(1LL, config.l2_shards));
+        if (config.l2_size <= 0 || config.l2_ways < 0 || config.l2_shards < 1 || !l2_config.valid()) {
+            std::cerr << "Geometria da L2 inválida: " << config.l2_size << " endereços, "
+                      << config.l2_ways << " vias, linhas de " << l2_config.line_size << " endereços\n";
+            return 1;
+        }
+
+        PrefetchConfig prefetch_config;
+        prefetch_config.degree = static_cast<size_t>(std::max(0LL, config.prefetch_degree));
+        prefetch_config.distance = static_cast<size_t>(std::max(0LL, config.prefetch_distance));
+        if (!parsePrefetchKind(config.prefetch, prefetch_config.kind)) {
+            std::cerr << "Prefetcher inválido: " << config.prefetch << "\n";
+            std::cerr << "   Use: none, next-line, stride ou stream\n";
+            return 1;
+        }
+        if (!prefetch_config.valid()) {
+            std::cerr << "Prefetch inválido: grau " << config.prefetch_degree << ", distância "
+                      << config.prefetch_distance << "\n";
+            std::cerr << "   O grau vai de 1 a " << PrefetchConfig::MAX_DEGREE << " e a distância de 1 a "
+                      << PrefetchConfig::MAX_DISTANCE << " linhas\n";
+            return 1;
+        }
+
+        if (config.mshrs < 0 || config.mshrs > static_cast<long long>(MshrFile::MAX_ENTRIES)) {
+            std::cerr << "Número de MSHRs inválido: " << config.mshrs << " (use de 0 a "
+                      << MshrFile::MAX_ENTRIES << ")\n";
+            return 1;
+        }
+        const size_t mshrs = static_cast<size_t>(config.mshrs);
+
+        SwitchPolicy switch_policy = SwitchPolicy::Partial;
+        if (!parseSwitchPolicy(config.switch_policy, switch_policy)) {
+            std::cerr << "Política de troca de contexto inválida: " << config.switch_policy << "\n";
+            std::cerr << "   Use: partial, asid ou asid-flush\n";
+            return 1;
+        }
+
+        DeviceConfig device_config;
+        device_config.latency = static_cast<uint64_t>(std::max(0LL, config.device_latency));
+        device_config.bandwidth = static_cast<size_t>(std::max(0LL, config.device_bandwidth));
+        device_config.queue_depth = static_cast<size_t>(std::max(0LL, config.device_queue));
+        device_config.backing_file = config.secondary_file;
+        device_config.words = static_cast<size_t>(std::max(0LL, config.secondary_size));
+        if (!parseDeviceKind(config.secondary_device, device_config.kind)) {
+            std::cerr << "Dispositivo de memória secundária inválido: " << config.secondary_device << "\n";
+            std::cerr << "   Use: flat, disk ou flash\n";
+            return 1;
+        }
+        if (config.device_latency < 0 || !device_config.valid()) {
+            std::cerr << "Dispositivo inválido: latência " << config.device_latency << ", banda "
+                      << config.device_bandwidth << ", fila " << config.device_queue << "\n";
+            std::cerr << "   A banda deve ser ao menos 1 palavra/ciclo e a fila de 1 a "
+                      << DeviceConfig::MAX_QUEUE << "\n";
+            return 1;
+        }
+        PageConfig page_config;
+        page_config.frames = static_cast<size_t>(std::max(0LL, config.frames));
+        page_config.page_size = static_cast<size_t>(std::max(0LL, config.page_size));
+        page_config.tlb_entries = static_cast<size_t>(std::max(0LL, config.tlb_entries));
+        if (!parsePageReplacement(config.page_replacement, page_config.replacement)) {
+            std::cerr << "Substituição de páginas inválida: " << config.page_replacement << "\n";
+            std::cerr << "   Use: clock, aging ou wsclock\n";
+            return 1;
+        }
+        if (config.frames < 0 || !page_config.valid() || page_config.page_size % cache_config.line_size != 0) {
+            std::cerr << "Paginação inválida: " << config.frames << " quadros, páginas de " << config.page_size
+                      << ", TLB de " << config.tlb_entries << " entradas\n";
+            std::cerr << "   A página deve ser potência de 2 e múltipla da linha (" << cache_config.line_size
+                      << ") e a TLB ter de 1 a " << PageConfig::MAX_TLB << " entradas\n";
+            return 1;
+        }
+
+        AllocConfig alloc_config;
+        alloc_config.granule = static_cast<size_t>(std::max(0LL, config.alloc_granule));
+        alloc_config.data_area = static_cast<size_t>(std::max(0LL, config.data_area));
+        // Sem segmentação, lw/sw usam endereços absolutos a partir de 0: a
+        // faixa 0 da disposição fixa fica fora da arena
+        if (!config.segmentation) alloc_config.reserved = PROCESS_SLOT;
+        if (!parseAllocPolicy(config.allocator, alloc_config.policy)) {
+            std::cerr << "Alocador inválido: " << config.allocator << "\n";
+            std::cerr << "   Use: fixed, buddy, first-fit ou best-fit\n";
+            return 1;
+        }
+        if (!alloc_config.valid() || config.replicas < 1 || (config.replicas > 1 && !alloc_config.enabled())) {
+            std::cerr << "Alocação inválida: grânulo " << config.alloc_granule << ", área de dados "
+                      << config.data_area << ", " << config.replicas << " cópias\n";
+            std::cerr << "   O grânulo deve ser potência de 2 até " << AllocConfig::MAX_GRANULE
+                      << " e --replicas maior que 1 exige --allocator\n";
+            return 1;
+        }
+
+        if (config.secondary_size < 0 || device_config.words > MAX_MAPPED_SECONDARY_MEMORY_SIZE ||
+            (device_config.words > 0 && device_config.backing_file.empty())) {
+            std::cerr << "Tamanho da memória secundária inválido: " << config.secondary_size << " palavras\n";
+            std::cerr << "   --secondary-size exige --secondary-file e vai até "
+                      << MAX_MAPPED_SECONDARY_MEMORY_SIZE << " palavras\n";
+            return 1;
+        }
+
+        BufferConfig buffer_config;
+        buffer_config.victim_lines = static_cast<size_t>(std::max(0LL, config.victim_cache));
+        buffer_config.write_buffer_entries = static_cast<size_t>(std::max(0LL, config.write_buffer));
+        if (config.victim_cache < 0 || config.write_buffer < 0 || !buffer_config.valid()) {
+            std::cerr << "Victim cache/buffer de escrita inválidos: " << config.victim_cache << " / "
+                      << config.write_buffer << " linhas (use de 0 a " << BufferConfig::MAX_ENTRIES << ")\n";
             return 1;
         }
         
@@ -1409,7 +2095,67 @@ int main(int argc, char* argv[]) {
         std::cout << "   Threading:    " << (config.use_threads && num_cores > 1 ? "✓ Habilitado" : "✗ Desabilitado") << "\n";
         std::cout << "   Escalonador:  " << config.scheduler << "\n";
         std::cout << "   Quantum:      " << config.quantum << " ciclos\n";
-        std::cout << "   Cache Policy: " << config.replacement_policy << " (" << CACHE_CAPACITY << " blocos)\n";
+        std::cout << "   Cache Policy: " << config.replacement_policy << " (" << cache_config.capacity << " endereços, linhas de "
+                  << cache_config.line_size << " endereços, ";
+        if (cache_config.ways == 0) std::cout << "totalmente associativa)\n";
+        else std::cout << cache_config.sets() << " conjuntos x " << cache_config.ways << " vias)\n";
+        std::cout << "   L2:           " << l2_config.capacity << " endereços, compartilhada, inclusiva, ";
+        if (l2_config.ways == 0) std::cout << "totalmente associativa";
+        else std::cout << l2_config.sets() << " conjuntos x " << l2_config.ways << " vias";
+        int l1_count = (num_cores > 1 && config.use_threads) ? num_cores : 1;
+        std::cout << " (" << l1_count << " L1 privada" << (l1_count > 1 ? "s" : "") << ", MESI, "
+                  << std::min(l2_config.shards, l2_config.sets()) << " shards)\n";
+        if (prefetch_config.enabled()) {
+            std::cout << "   Prefetch:     " << prefetchKindName(prefetch_config.kind) << " (grau "
+                      << prefetch_config.degree << ", distância " << prefetch_config.distance << " linhas)\n";
+        }
+        if (buffer_config.victim_lines > 0) {
+            std::cout << "   Victim cache: " << buffer_config.victim_lines << " linhas por L1\n";
+        }
+        if (buffer_config.write_buffer_entries > 0) {
+            std::cout << "   Write buffer: " << buffer_config.write_buffer_entries << " entradas por núcleo\n";
+        }
+        if (mshrs > 0) {
+            std::cout << "   MSHRs:        " << mshrs << " por L1 (cache não bloqueante)\n";
+        }
+        std::cout << "   Troca de contexto: " << switchPolicyName(switch_policy) << "\n";
+        if (device_config.timed()) {
+            std::cout << "   Secundária:   " << deviceKindName(device_config.kind) << " (latência "
+                      << device_config.effectiveLatency() << " ciclos, " << device_config.bandwidth
+                      << " palavras/ciclo, fila " << device_config.queue_depth << ")\n";
+        }
+        if (!device_config.backing_file.empty()) {
+            std::cout << "   Arquivo secundário: " << device_config.backing_file << " (mmap)\n";
+        }
+        if (page_config.enabled()) {
+            std::cout << "   Paginação:    " << page_config.frames << " quadros de " << page_config.page_size
+                      << ", TLB de " << page_config.tlb_entries << " entradas, "
+                      << pageReplacementName(page_config.replacement) << "\n";
+        }
+        if (config.segmentation) {
+            std::cout << "   Segmentação:  código e dados por processo\n";
+        }
+        if (alloc_config.enabled()) {
+            std::cout << "   Alocador:     " << allocPolicyName(alloc_config.policy) << ", grânulo "
+                      << alloc_config.granule << ", " << alloc_config.data_area << " endereços de dados";
+            if (alloc_config.reserved) std::cout << ", faixa [0, " << alloc_config.reserved << ") reservada";
+            if (config.replicas > 1) std::cout << ", " << config.replicas << " cópias dos processos";
+            std::cout << "\n";
+        }
+        std::cout << "   Trace:        " << config.trace_mode << "\n";
+        if (core_options.fastForwardEnabled()) {
+            std::cout << "   Fast-forward: ";
+            if (core_options.ff_instructions > 0) std::cout << "até instrução " << core_options.ff_instructions << " ";
+            if (core_options.ff_to_pc) std::cout << "até PC base+" << core_options.ff_pc;
+            std::cout << "\n";
+        }
+        if (core_options.samplingEnabled()) {
+            std::cout << "   Amostragem:   janela de " << core_options.sample_window
+                      << " a cada " << core_options.sample_period << " instruções\n";
+        }
+        if (core_options.fastForwardEnabled() || core_options.samplingEnabled()) {
+            std::cout << "   Funcional:    motor " << config.functional_engine << "\n";
+        }
         std::cout << "   Config Dir:   " << config.config_dir << "\n";
         std::cout << "   Tasks Dir:    " << config.tasks_dir << "\n";
         std::cout << "   Output Dir:   " << config.output_dir << "\n\n";
@@ -1423,17 +2169,29 @@ int main(int argc, char* argv[]) {
         std::cout << "...\n\n";
         
         SchedulerMetrics metrics;
-        // Decidir entre multi-thread ou sequencial
-        if (num_cores > 1 && config.use_threads) {
-            metrics = run_multicore_scheduler(num_cores, scheduler_type, config.scheduler, true,
-                                             config.config_dir, config.tasks_dir, config.output_dir,
-                                             config.replacement_policy);
-        } else {
-            // Execução sequencial (mesmo com múltiplos cores logicamente)
-            metrics = run_scheduler(scheduler_type, config.scheduler, true,
-                                   config.config_dir, config.tasks_dir, config.output_dir,
-                                   config.replacement_policy);
-            metrics.num_cores = num_cores; // Registrar número de cores configurados
+        try {
+            // Decidir entre multi-thread ou sequencial
+            if (num_cores > 1 && config.use_threads) {
+                metrics = run_multicore_scheduler(num_cores, scheduler_type, config.scheduler, true,
+                                                 config.config_dir, config.tasks_dir, config.output_dir,
+                                                 config.replacement_policy, core_options, cache_config, l2_config,
+                                                 prefetch_config, buffer_config, mshrs, switch_policy,
+                                                 device_config, page_config, config.segmentation, alloc_config,
+                                                 static_cast<int>(config.replicas));
+            } else {
+                // Execução sequencial (mesmo com múltiplos cores logicamente)
+                metrics = run_scheduler(scheduler_type, config.scheduler, true,
+                                       config.config_dir, config.tasks_dir, config.output_dir,
+                                       config.replacement_policy, core_options, cache_config, l2_config,
+                                       prefetch_config, buffer_config, mshrs, switch_policy, device_config,
+                                       page_config, config.segmentation, alloc_config,
+                                       static_cast<int>(config.replicas));
+                metrics.num_cores = num_cores; // Registrar número de cores configurados
+            }
+        } catch (const std::exception& e) {
+            // Ex.: arquivo da memória secundária que não pôde ser mapeado
+            std::cerr << "\n❌ Erro durante execução: " << e.what() << "\n";
+            return 1;
         }
         
         std::cout << "\nExecução concluída!\n";
@@ -1441,7 +2199,52 @@ int main(int argc, char* argv[]) {
         std::cout << "Processos finalizados: " << metrics.processes_finished << "\n";
         std::cout << "Context switches: " << metrics.context_switches << "\n";
         std::cout << "Cache hit rate: " << std::fixed << std::setprecision(2) 
-                  << metrics.cache_hit_rate << "%\n\n";
+                  << metrics.cache_hit_rate << "%\n";
+        std::cout << "L2: " << metrics.coherence.l2_hits << " hits / " << metrics.coherence.l2_misses
+                  << " misses | MESI: " << metrics.coherence.invalidations << " invalidações, "
+                  << metrics.coherence.interventions << " intervenções, "
+                  << metrics.coherence.upgrades << " upgrades\n";
+        if (prefetch_config.enabled()) {
+            std::cout << "Prefetch: " << metrics.prefetch.issued << " emitidos, " << metrics.prefetch.useful
+                      << " úteis, " << metrics.prefetch.late << " atrasados | "
+                      << metrics.prefetch.saved_cycles << " ciclos de memória economizados\n";
+        }
+        if (buffer_config.victim_lines > 0 || buffer_config.write_buffer_entries > 0) {
+            std::cout << "Victim cache: " << metrics.buffers.victim_hits << " hits | Write-backs: "
+                      << metrics.buffers.writebacks << " (" << metrics.buffers.coalesced << " coalescidos, "
+                      << metrics.buffers.stall_cycles << " ciclos de espera)\n";
+        }
+        if (mshrs > 0) {
+            std::cout << "MSHR: " << metrics.mshr.misses << " misses, " << metrics.mshr.merged
+                      << " secundários, pico " << metrics.mshr.peak << " | espera " << metrics.mshr.stall_cycles
+                      << " de " << metrics.mshr.miss_cycles << " ciclos de miss\n";
+        }
+        if (page_config.enabled()) {
+            std::cout << "Paginação: " << metrics.paging.faults << " faltas, " << metrics.paging.evictions
+                      << " expulsões | TLB " << metrics.paging.tlb_hits << " hits / " << metrics.paging.tlb_misses
+                      << " misses | " << metrics.paging.fault_cycles << " ciclos de falta\n";
+        }
+        if (config.segmentation) {
+            const SegmentStats& seg = metrics.segments;
+            std::cout << "Segmentação: " << seg.register_hits << " acessos pelos registradores, "
+                      << seg.descriptor_loads << " recargas (" << seg.load_cycles << " ciclos) | "
+                      << seg.limit_faults + seg.protection_faults + seg.not_present_faults << " violações\n";
+        }
+        if (alloc_config.enabled()) {
+            const AllocStats& alloc = metrics.allocator;
+            std::cout << "Alocador: " << alloc.allocations << " alocações, " << alloc.failures << " falhas, pico "
+                      << alloc.peak_in_use << " de " << alloc.arena << " endereços | "
+                      << (alloc.allocations ? alloc.alloc_ns / alloc.allocations : 0) << " ns por alocação";
+            if (metrics.deferred_admissions > 0) {
+                std::cout << " | " << metrics.deferred_admissions << " admissões adiadas";
+            }
+            std::cout << "\n";
+        }
+        if (device_config.timed()) {
+            std::cout << "Secundária: " << metrics.device.requests << " pedidos (" << metrics.device.sequential
+                      << " sequenciais) | fila " << metrics.device.queue_cycles << " ciclos\n";
+        }
+        std::cout << "Ciclos de memória: " << metrics.total_memory_cycles << "\n\n";
         
         // Salvar CSV também
         std::string csv_name;
@@ -1,82 +1,636 @@
 #include "MemoryManager.hpp"
 #include "cachePolicy.hpp"
 
-MemoryManager::MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize) {
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+MemoryManager::MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize, const CacheConfig &cacheConfig,
+                             size_t numCores, const CacheConfig &l2Config) {
     mainMemory = std::make_unique<MAIN_MEMORY>(mainMemorySize);
     secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondaryMemorySize);
     // Inicializa com FIFO por padrão (pode ser mudado para LRU)
-    L1_cache = std::make_unique<Cache>(ReplacementPolicy::FIFO);
+    for (size_t core = 0; core < std::max<size_t>(numCores, 1); ++core) {
+        L1_caches.push_back(std::make_unique<Cache>(ReplacementPolicy::FIFO, cacheConfig));
+    }
+    L2_cache = std::make_unique<Cache>(ReplacementPolicy::FIFO, CacheConfig{});
+    cores.resize(L1_caches.size());
+    l1_sinks.resize(L1_caches.size());
+    for (size_t core = 0; core < L1_caches.size(); ++core) {
+        l1_sinks[core].owner = this;
+        l1_sinks[core].core = core;
+        victims.push_back(std::make_unique<VictimCache>(0, cacheConfig.line_size));
+    }
+    configureCache(cacheConfig, l2Config);
+    L2_cache->setEvictionHook([this](size_t base) { backInvalidate(base, this); });
     mainMemoryLimit = mainMemorySize;
+    memoryLimit = mainMemorySize + secondaryMemorySize;
+    secondarySize = secondaryMemorySize;
 }
 
 MemoryManager::~MemoryManager() {
     // CRÍTICO: Limpar cache ANTES de destruir as memórias
-    // para evitar write-back em memórias já destruídas
-    if (L1_cache) {
-        L1_cache->invalidate();
-        L1_cache.reset();  // Destruir cache explicitamente
+    // para evitar write-back em memórias já destruídas. Os dados sujos
+    // seguem antes para a memória, para não perder escritas
+    flushCaches();
+    for (auto &cache : L1_caches) {
+        cache->invalidate();
+    }
+    L1_caches.clear();
+    if (L2_cache) {
+        L2_cache->invalidate();
+        L2_cache.reset();  // Destruir cache explicitamente
     }
     // Agora podemos destruir as memórias com segurança
     mainMemory.reset();
     secondaryMemory.reset();
 }
 
-uint32_t MemoryManager::read(uint32_t address, PCB& process) {
+uint32_t MemoryManager::read(uint32_t address, PCB& process, uint32_t pc) {
+    uint32_t linear = address;
+    if (!segmentAddress(address, process, SEG_DATA, false, false, linear)) return MEMORY_ACCESS_ERROR;
+    PageGuard guard;
+    return load(translate(linear, process, false, guard), process, nullptr, pc);
+}
+
+uint32_t MemoryManager::fetch(uint32_t address, PCB& process) {
+    uint32_t linear = address;
+    if (!segmentAddress(address, process, SEG_CODE, false, true, linear)) {
+        process.segment_fault = true;  // o Fetch encerra o processo
+        return MEMORY_ACCESS_ERROR;
+    }
+    PageGuard guard;
+    return load(translate(linear, process, false, guard), process, nullptr, address);
+}
+
+uint32_t MemoryManager::readNonBlocking(uint32_t address, PCB &process, uint64_t &readyAt, uint32_t pc) {
+    readyAt = 0;
+    uint32_t linear = address;
+    if (!segmentAddress(address, process, SEG_DATA, false, false, linear)) return MEMORY_ACCESS_ERROR;
+    PageGuard guard;
+    return load(translate(linear, process, false, guard), process, mshr_entries > 0 ? &readyAt : nullptr, pc);
+}
+
+bool MemoryManager::segmentAddress(uint32_t address, PCB &process, int segment, bool write, bool linearCheck,
+                                   uint32_t &linear) {
+    linear = address;
+    if (!segmentation || !process.segments.isActive()) return true;
+    CoreState &unit = coreOf(process);
+    bool loaded = false;
+    SegmentFault fault = linearCheck ? unit.segments.check(process.segments, segment, address, loaded)
+                                     : unit.segments.translate(process.segments, segment, address, write, linear, loaded);
+    if (loaded) {
+        // Recarga do registrador: leitura do descritor na tabela em memória
+        process.memory_cycles.fetch_add(process.memWeights.primary);
+        unit.clock += process.memWeights.primary;
+        unit.segments.chargeLoad(process.memWeights.primary);
+    }
+    if (fault == SegmentFault::None) return true;
+    process.segment_violations.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MemoryManager::configureSegmentation(bool enabled) {
+    segmentation = enabled;
+    for (auto &core : cores) core.segments.clear();
+}
+
+void MemoryManager::configureAllocator(const AllocConfig &config) {
+    std::lock_guard<std::mutex> lock(allocator_lock);
+    allocator.configure(config, vm.enabled() ? secondaryMemory->capacity() : memoryLimit);
+}
+
+long MemoryManager::allocate(size_t size) {
+    std::lock_guard<std::mutex> lock(allocator_lock);
+    return allocator.allocate(size);
+}
+
+void MemoryManager::release(uint32_t base) {
+    std::lock_guard<std::mutex> lock(allocator_lock);
+    allocator.release(base);
+}
+
+AllocStats MemoryManager::allocatorStats() {
+    std::lock_guard<std::mutex> lock(allocator_lock);
+    return allocator.stats();
+}
+
+SegmentStats MemoryManager::segmentStats() const {
+    SegmentStats total;
+    for (const auto &core : cores) {
+        const SegmentStats &s = core.segments.getStats();
+        total.register_hits += s.register_hits;
+        total.descriptor_loads += s.descriptor_loads;
+        total.load_cycles += s.load_cycles;
+        total.limit_faults += s.limit_faults;
+        total.protection_faults += s.protection_faults;
+        total.not_present_faults += s.not_present_faults;
+    }
+    return total;
+}
+
+uint32_t MemoryManager::translate(uint32_t address, PCB &process, bool write, PageGuard &guard) {
+    if (!vm.enabled()) return address;
+    const uint32_t page = static_cast<uint32_t>(vm.config().page_size);
+    const uint32_t vpn = address / page;
+    const size_t core = static_cast<size_t>(process.core_id);
+
+    guard.shared = std::shared_lock<std::shared_mutex>(paging_lock);
+    uint32_t frame = 0;
+    VirtualMemory::Lookup found = vm.lookup(core, vpn, write, frame);
+    if (found == VirtualMemory::Lookup::Walk) {
+        // Miss na TLB: um acesso à memória para ler a entrada da tabela
+        process.memory_cycles.fetch_add(process.memWeights.primary);
+        coreOf(process).clock += process.memWeights.primary;
+        vm.chargeWalk(process.memWeights.primary);
+    }
+    if (found == VirtualMemory::Lookup::Fault) {
+        // A tabela é global: outro núcleo pode ter trazido a página entre
+        // soltar o lock compartilhado e pegar o exclusivo
+        guard.shared.unlock();
+        guard.exclusive = std::unique_lock<std::shared_mutex>(paging_lock);
+        if (!vm.refill(core, vpn, write, frame)) frame = servicePageFault(process, vpn, write);
+    }
+    return frame * page + address % page;
+}
+
+uint32_t MemoryManager::servicePageFault(PCB &process, uint32_t vpn, bool write) {
+    const uint32_t page = static_cast<uint32_t>(vm.config().page_size);
+    VirtualMemory::Eviction victim;
+    const uint32_t frame = vm.fault(static_cast<size_t>(process.core_id), vpn, write, victim);
+    const uint32_t base = frame * page;
+    CoreState &unit = coreOf(process);
+
+    uint64_t cost = 0;
+    if (victim.valid) {
+        // O quadro muda de dono: nenhuma cache pode guardar as linhas antigas
+        purgeFrame(base);
+        if (victim.dirty) {
+            for (uint32_t i = 0; i < page; ++i) {
+                secondaryMemory->WriteMem(victim.vpn * page + i, mainMemory->ReadMem(base + i));
+            }
+            cost += pageTransferCost(process, victim.vpn * page, unit.clock);
+        }
+    }
+    for (uint32_t i = 0; i < page; ++i) {
+        mainMemory->WriteMem(base + i, secondaryMemory->ReadMem(vpn * page + i));
+    }
+    cost += pageTransferCost(process, vpn * page, unit.clock + cost);
+
+    process.memory_cycles.fetch_add(cost);
+    unit.clock += cost;
+    vm.chargeFault(cost);
+    return frame;
+}
+
+void MemoryManager::purgeFrame(uint32_t base) {
+    const size_t line_size = L2_cache->config().line_size;
+    const size_t end = base + vm.config().page_size;
+    for (size_t line = base; line < end; line += line_size) {
+        std::lock_guard<std::mutex> bus(busFor(static_cast<uint32_t>(line)));
+        for (size_t core = 0; core < L1_caches.size(); ++core) {
+            snoopCore(core, line, true, &l1_sinks[core]);
+        }
+        L2_cache->snoop(line, true, this);
+    }
+}
+
+uint64_t MemoryManager::pageTransferCost(PCB &process, uint32_t address, uint64_t now) {
+    const size_t page = vm.config().page_size;
+    if (secondaryMemory->deviceConfig().timed()) return secondaryMemory->access(address, page, now);
+    // Peso fixo por linha da página
+    const size_t line_size = L2_cache->config().line_size;
+    return process.memWeights.secondary * std::max<size_t>(1, (page + line_size - 1) / line_size);
+}
+
+void MemoryManager::configurePaging(const PageConfig &config) {
+    const size_t line_size = L2_cache->config().line_size;
+    if (config.enabled() && (!config.valid() || config.page_size % line_size != 0 ||
+                             config.frames * config.page_size > mainMemoryLimit)) {
+        throw std::invalid_argument("Paginação inválida: " + std::to_string(config.frames) + " quadros de " +
+                                    std::to_string(config.page_size) + " endereços (a página deve ser potência de 2 "
+                                    "e múltipla da linha, e os quadros caber em " +
+                                    std::to_string(mainMemoryLimit) + " endereços)");
+    }
+    vm.configure(config, L1_caches.size());
+}
+
+uint32_t MemoryManager::load(uint32_t address, PCB &process, uint64_t *readyAt, uint32_t pc) {
     process.mem_accesses_total.fetch_add(1);
     process.mem_reads.fetch_add(1);
+    const bool prefetching = prefetch_config.enabled();
 
-    // 1. Tenta ler da Cache
-    size_t cache_data = L1_cache->get(address);
+    // 1. Tenta ler da L1 do núcleo (só o lock da própria L1)
+    PrefetchMark mark;
+    size_t cache_data = l1Of(process).get(address, prefetching ? &mark : nullptr);
     if (cache_data != CACHE_MISS) {
         process.cache_mem_accesses.fetch_add(1);
         process.memory_cycles.fetch_add(process.memWeights.cache);
+        coreOf(process).clock += process.memWeights.cache;
 
         contabiliza_cache(process, true);  // HIT
+        if (prefetching) {
+            if (mark.pending) consumePrefetch(process, mark);
+            runPrefetcher(address, process, pc, false, mark.pending);
+        }
+        if (mshr_entries > 0) joinMiss(process, address, readyAt);
         return cache_data;
     }
 
-    // 2. Cache Miss: busca na memória correta
+    // 2. Cache Miss: a linha vem da L2 ou da memória pelo barramento
     contabiliza_cache(process, false); // MISS
 
-    uint32_t data_from_mem;
-    if (address < mainMemoryLimit) {
-        process.primary_mem_accesses.fetch_add(1);
-        process.memory_cycles.fetch_add(process.memWeights.primary);
-        data_from_mem = mainMemory->ReadMem(address);
+    uint32_t value;
+    if (readyAt) {
+        // Miss não bloqueante: ocupa um MSHR (esperando um, se não houver livre)
+        CoreState &unit = coreOf(process);
+        while (unit.mshrs.full(unit.clock)) {
+            mshr.full_stalls.fetch_add(1, std::memory_order_relaxed);
+            stallUntil(process, unit.mshrs.earliest());
+        }
+        uint64_t cost = 0;
+        {
+            std::lock_guard<std::mutex> bus(busFor(address));
+            value = serviceMiss(address, process, false, &cost);
+        }
+        const size_t line_size = L2_cache->config().line_size;
+        *readyAt = unit.clock + cost;
+        size_t outstanding = unit.mshrs.allocate(address - address % line_size, *readyAt);
+        unit.mshr_peak = std::max<uint64_t>(unit.mshr_peak, outstanding);
+        mshr.misses.fetch_add(1, std::memory_order_relaxed);
+        mshr.miss_cycles.fetch_add(cost, std::memory_order_relaxed);
+
+        // O processo paga só a consulta à L1; o dado chega depois
+        process.memory_cycles.fetch_add(process.memWeights.cache);
+        unit.clock += process.memWeights.cache;
     } else {
-        process.secondary_mem_accesses.fetch_add(1);
-        process.memory_cycles.fetch_add(process.memWeights.secondary);
-        uint32_t secondaryAddress = address - mainMemoryLimit;
-        data_from_mem = secondaryMemory->ReadMem(secondaryAddress);
+        std::lock_guard<std::mutex> bus(busFor(address));
+        value = serviceMiss(address, process, false);
+    }
+    // Prefetch depois de liberar o barramento (as linhas previstas podem
+    // estar em outro shard)
+    if (prefetching) runPrefetcher(address, process, pc, true, false);
+    return value;
+}
+
+uint32_t MemoryManager::serviceMiss(uint32_t address, PCB &process, bool exclusive, uint64_t *deferred) {
+    const size_t line_size = L2_cache->config().line_size;
+    const uint32_t base = address - static_cast<uint32_t>(address % line_size);
+    const size_t core = static_cast<size_t>(process.core_id);
+    uint32_t burst[64];
+
+    // Victim cache: a linha expulsa há pouco volta à L1 sem passar pela L2.
+    // Uma cópia Shared não serve a um read-for-ownership (segue pelo barramento).
+    Mesi state;
+    uint64_t cost;
+    if (victims[core]->enabled() && victims[core]->take(base, burst, state) &&
+        (!exclusive || state == Mesi::Exclusive)) {
+        cost = process.memWeights.victim;
+        l1Of(process).fillLine(base, burst, line_size, &l1_sinks[core], state, nullptr,
+                               static_cast<uint32_t>(process.pid));
+    } else {
+        cost = fetchLine(base, process, exclusive, true, burst);
+    }
+
+    if (deferred) {
+        *deferred = cost;
+    } else {
+        process.memory_cycles.fetch_add(cost);
+        coreOf(process).clock += cost;
+    }
+    return burst[address - base];
+}
+
+uint64_t MemoryManager::fetchLine(uint32_t base, PCB &process, bool exclusive, bool demand, uint32_t *burst) {
+    const size_t line_size = L2_cache->config().line_size;
+    const size_t core = static_cast<size_t>(process.core_id);
+
+    // Snoop: uma cópia Modified é escrita na L2 antes da leitura; as demais
+    // viram Shared (leitura) ou são invalidadas (read-for-ownership)
+    bool shared = false;
+    victims[core]->snoop(base, true); // a cópia na própria victim cache fica obsoleta
+    for (size_t other = 0; other < L1_caches.size(); ++other) {
+        if (other == core) continue;
+        Mesi previous = snoopCore(other, base, exclusive, &l1_sinks[other]);
+        if (previous == Mesi::Invalid) continue;
+        shared = true;
+        if (previous == Mesi::Modified) coherence.interventions.fetch_add(1, std::memory_order_relaxed);
+        if (exclusive) coherence.invalidations.fetch_add(1, std::memory_order_relaxed);
     }
 
-    // 3. Após a busca, armazena o dado na cache
-    L1_cache->put(address, data_from_mem, this);
+    // A linha inteira é buscada numa única rajada (burst); o custo é por linha:
+    // uma latência do nível de origem, não uma por palavra
+    uint64_t cost;
+    if (L2_cache->readLine(base, burst)) {
+        coherence.l2_hits.fetch_add(1, std::memory_order_relaxed);
+        cost = process.memWeights.l2;
+        if (demand) process.l2_mem_accesses.fetch_add(1);
+    } else {
+        coherence.l2_misses.fetch_add(1, std::memory_order_relaxed);
+        CoreState &unit = coreOf(process);
+        if (unit.write_buffer.enabled() && unit.write_buffer.pending(base, unit.clock)) {
+            // A linha ainda está no buffer de escrita: a leitura é servida por ele
+            buffers.forwards.fetch_add(1, std::memory_order_relaxed);
+            cost = process.memWeights.l2;
+        } else if (base < mainMemoryLimit) {
+            cost = process.memWeights.primary;
+            if (demand) process.primary_mem_accesses.fetch_add(1);
+        } else {
+            cost = secondaryCost(process, base, unit.clock);
+            if (demand) process.secondary_mem_accesses.fetch_add(1);
+        }
+        for (size_t i = 0; i < line_size; ++i) {
+            burst[i] = readFromMemory(base + static_cast<uint32_t>(i));
+        }
+
+        // A vítima da L2 (e as cópias dela nas L1) é escrita na memória agora;
+        // o custo dessa escrita cai sobre este núcleo
+        WriteBackRecorder recorder;
+        recorder.owner = this;
+        recorder.line_size = line_size;
+        long evicted = -1;
+        L2_cache->fillLine(base, burst, line_size, &recorder, Mesi::Exclusive, &evicted);
+        if (evicted >= 0) backInvalidate(static_cast<size_t>(evicted), &recorder);
+        const uint64_t read_cost = cost;
+        for (uint32_t line : recorder.lines) {
+            cost += writeBackDelay(process, line, read_cost);
+        }
+    }
 
-    return data_from_mem;
+    // 3. Após a busca, armazena a linha na L1 do núcleo
+    Mesi state = (exclusive || !shared) ? Mesi::Exclusive : Mesi::Shared;
+    l1Of(process).fillLine(base, burst, line_size, &l1_sinks[core], state, nullptr,
+                           static_cast<uint32_t>(process.pid));
+    return cost;
 }
 
-void MemoryManager::write(uint32_t address, uint32_t data, PCB& process) {
+uint64_t MemoryManager::writeBackDelay(PCB &process, uint32_t base, uint64_t readCost) {
+    CoreState &unit = coreOf(process);
+    uint64_t cost = (base < mainMemoryLimit) ? process.memWeights.primary
+                                             : secondaryCost(process, base, unit.clock + readCost);
+    buffers.writebacks.fetch_add(1, std::memory_order_relaxed);
+
+    if (!unit.write_buffer.enabled()) {
+        buffers.writeback_cycles.fetch_add(cost, std::memory_order_relaxed);
+        return cost;
+    }
+    bool coalesced = false;
+    uint64_t stall = unit.write_buffer.push(base, unit.clock + readCost, cost, coalesced);
+    if (coalesced) buffers.coalesced.fetch_add(1, std::memory_order_relaxed);
+    if (stall > 0) {
+        buffers.full_stalls.fetch_add(1, std::memory_order_relaxed);
+        buffers.stall_cycles.fetch_add(stall, std::memory_order_relaxed);
+    }
+    return stall;
+}
+
+void MemoryManager::configureDevice(const DeviceConfig &config) {
+    if (config.backing_file != secondaryMemory->backingFile()) {
+        if (config.backing_file.empty()) {
+            secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondarySize);
+            memoryLimit = mainMemoryLimit + secondarySize;
+        } else {
+            secondaryMemory = std::make_unique<SECONDARY_MEMORY>(config.words, config.backing_file);
+            memoryLimit = mainMemoryLimit + secondaryMemory->capacity();
+        }
+    }
+    secondaryMemory->configureDevice(config);
+}
+
+uint64_t MemoryManager::secondaryCost(PCB &process, uint32_t base, uint64_t now) {
+    if (!secondaryMemory->deviceConfig().timed()) return process.memWeights.secondary;
+    return secondaryMemory->access(base - static_cast<uint32_t>(mainMemoryLimit), L2_cache->config().line_size, now);
+}
+
+Mesi MemoryManager::snoopCore(size_t core, size_t base, bool invalidate, CacheLowerLevel *lower) {
+    Mesi l1 = L1_caches[core]->snoop(base, invalidate, lower);
+    Mesi victim = victims[core]->snoop(base, invalidate);
+    return std::max(l1, victim);
+}
+
+void MemoryManager::joinMiss(PCB &process, uint32_t address, uint64_t *readyAt) {
+    CoreState &unit = coreOf(process);
+    const size_t line_size = L2_cache->config().line_size;
+    uint64_t at = unit.mshrs.pending(address - address % line_size, unit.clock);
+    if (at == 0) return;
+    if (readyAt) {
+        // Miss secundário: usa o pedido em curso, sem nova busca
+        mshr.merged.fetch_add(1, std::memory_order_relaxed);
+        *readyAt = at;
+    } else {
+        mshr.dependency_stalls.fetch_add(1, std::memory_order_relaxed);
+        stallUntil(process, at);
+    }
+}
+
+void MemoryManager::stallUntil(PCB &process, uint64_t at) {
+    CoreState &unit = coreOf(process);
+    if (at <= unit.clock) return;
+    uint64_t stall = at - unit.clock;
+    process.memory_cycles.fetch_add(stall);
+    unit.clock = at;
+    mshr.stall_cycles.fetch_add(stall, std::memory_order_relaxed);
+}
+
+void MemoryManager::waitForLoad(PCB &process, uint64_t readyAt) {
+    if (readyAt <= coreOf(process).clock) return;
+    mshr.dependency_stalls.fetch_add(1, std::memory_order_relaxed);
+    stallUntil(process, readyAt);
+}
+
+void MemoryManager::drainMisses(PCB &process) {
+    if (mshr_entries == 0) return;
+    CoreState &unit = coreOf(process);
+    stallUntil(process, unit.mshrs.latest());
+    unit.mshrs.reset();
+}
+
+void MemoryManager::consumePrefetch(PCB &process, const PrefetchMark &mark) {
+    CoreState &unit = coreOf(process);
+    uint64_t stall = 0;
+    if (mark.ready_at > unit.clock) {
+        // A demanda chegou antes dos dados: espera o restante da busca
+        stall = mark.ready_at - unit.clock;
+        prefetch.late.fetch_add(1, std::memory_order_relaxed);
+        process.memory_cycles.fetch_add(stall);
+        unit.clock += stall;
+    } else {
+        prefetch.useful.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Sem o prefetch a demanda pagaria o miss inteiro em vez do hit (+ stall)
+    uint64_t paid = process.memWeights.cache + stall;
+    if (mark.cost > paid) prefetch.saved_cycles.fetch_add(mark.cost - paid, std::memory_order_relaxed);
+}
+
+void MemoryManager::runPrefetcher(uint32_t address, PCB &process, uint32_t pc, bool miss, bool prefetchHit) {
+    CoreState &unit = coreOf(process);
+    uint32_t targets[PrefetchConfig::MAX_DEGREE];
+    if (pc == NO_PC) pc = process.regBank.pc.read();
+    size_t count = unit.prefetcher.observe(pc, address, miss, prefetchHit, targets);
+
+    Cache &cache = l1Of(process);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t base = targets[i];
+        if (base >= physicalLimit()) continue; // fora da memória simulada
+        if (cache.lineState(base) != Mesi::Invalid) {
+            prefetch.redundant.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        uint32_t burst[64];
+        uint64_t cost;
+        {
+            std::lock_guard<std::mutex> bus(busFor(base));
+            cost = fetchLine(base, process, false, false, burst);
+        }
+        // As buscas de um disparo correm em paralelo: todas chegam em clock + custo
+        cache.markPrefetched(base, PrefetchMark{true, unit.clock + cost, cost});
+        prefetch.issued.fetch_add(1, std::memory_order_relaxed);
+        prefetch.fill_cycles.fetch_add(cost, std::memory_order_relaxed);
+    }
+}
+
+void MemoryManager::backInvalidate(size_t base, CacheLowerLevel *lower) {
+    // Chamado depois de a L2 escrever a vítima na memória: dados Modified
+    // das L1 são mais novos e vão direto para a memória
+    for (size_t core = 0; core < L1_caches.size(); ++core) {
+        if (snoopCore(core, base, true, lower) != Mesi::Invalid) {
+            coherence.back_invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void MemoryManager::L2WriteBack::writeBack(uint32_t address, uint32_t data) {
+    if (!owner->L2_cache->writeHit(address, data)) {
+        owner->writePhysical(address, data);
+    }
+}
+
+void MemoryManager::L2WriteBack::evictLine(uint32_t base, const uint32_t *words, Mesi state) {
+    VictimCache &victim = *owner->victims[core];
+    if (victim.enabled()) victim.insert(base, words, state);
+}
+
+void MemoryManager::WriteBackRecorder::writeBack(uint32_t address, uint32_t data) {
+    owner->writePhysical(address, data);
+    uint32_t base = address - static_cast<uint32_t>(address % line_size);
+    if (std::find(lines.begin(), lines.end(), base) == lines.end()) lines.push_back(base);
+}
+
+uint32_t MemoryManager::readFromMemory(uint32_t address) {
+    if (address < mainMemoryLimit) {
+        return mainMemory->ReadMem(address);
+    }
+    return secondaryMemory->ReadMem(address - static_cast<uint32_t>(mainMemoryLimit));
+}
+
+void MemoryManager::write(uint32_t address, uint32_t data, PCB& process, uint32_t pc) {
+    uint32_t linear = address;
+    if (!segmentAddress(address, process, SEG_DATA, true, false, linear)) return;
+    PageGuard guard;
+    store(linear, translate(linear, process, true, guard), data, process, false, pc);
+}
+
+void MemoryManager::writeNonBlocking(uint32_t address, uint32_t data, PCB &process, uint32_t pc) {
+    uint32_t linear = address;
+    if (!segmentAddress(address, process, SEG_DATA, true, false, linear)) return;
+    PageGuard guard;
+    store(linear, translate(linear, process, true, guard), data, process, mshr_entries > 0, pc);
+}
+
+void MemoryManager::store(uint32_t address, uint32_t physical, uint32_t data, PCB &process, bool nonBlocking,
+                          uint32_t pc) {
     process.mem_accesses_total.fetch_add(1);
     process.mem_writes.fetch_add(1);
 
-    size_t cache_data = L1_cache->get(address);
+    // Escrita em endereço de código invalida a instrução pré-decodificada
+    // e as superinstruções e blocos traduzidos que a contêm
+    process.decode_cache.invalidate(address);
+    process.fusion_table.invalidate(address);
+    process.block_cache.write(address, data);
 
+    Cache &cache = l1Of(process);
+    PrefetchMark mark;
+    size_t cache_data = cache.get(physical, prefetch_config.enabled() ? &mark : nullptr);
+
+    // O store não tem registrador destino: um miss não bloqueante só ocupa o MSHR
+    uint64_t ignored = 0;
     if (cache_data == CACHE_MISS) {
         contabiliza_cache(process, false); // MISS
-        read(address, process); // Write-allocate: busca e coloca na cache
+        load(physical, process, nonBlocking ? &ignored : nullptr, pc); // Write-allocate: busca e coloca na cache
     } else {
         contabiliza_cache(process, true);  // HIT
+        if (mark.pending) consumePrefetch(process, mark);
+        if (mshr_entries > 0) joinMiss(process, physical, nonBlocking ? &ignored : nullptr);
     }
 
-    // Agora que o dado está na cache, atualiza e marca como "dirty"
-    L1_cache->update(address, data);
+    // Agora que o dado está na cache, atualiza e marca como "dirty".
+    // Só uma linha Exclusive/Modified aceita a escrita local; Shared precisa
+    // de upgrade no barramento (invalidando as outras cópias).
+    if (!cache.writeHit(physical, data)) {
+        std::lock_guard<std::mutex> bus(busFor(physical));
+        if (cache.lineState(physical) == Mesi::Invalid) {
+            // Outro núcleo tomou a linha entre a leitura e a escrita
+            serviceMiss(physical, process, true);
+        } else {
+            const size_t line_size = L2_cache->config().line_size;
+            const size_t base = physical - physical % line_size;
+            for (size_t other = 0; other < L1_caches.size(); ++other) {
+                if (other == static_cast<size_t>(process.core_id)) continue;
+                if (snoopCore(other, base, true, &l1_sinks[other]) != Mesi::Invalid) {
+                    coherence.invalidations.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            coherence.upgrades.fetch_add(1, std::memory_order_relaxed);
+        }
+        cache.setLineState(physical, Mesi::Exclusive);
+        cache.writeHit(physical, data);
+    }
     process.cache_mem_accesses.fetch_add(1);
     process.memory_cycles.fetch_add(process.memWeights.cache);
+    coreOf(process).clock += process.memWeights.cache;
 }
 
-// Função chamada pela cache para escrever dados "sujos" de volta na memória
 void MemoryManager::writeToFile(uint32_t address, uint32_t data) {
+    if (!vm.enabled()) {
+        writePhysical(address, data);
+        return;
+    }
+    // Endereço virtual: a imagem fica na memória secundária
+    std::unique_lock<std::shared_mutex> lock(paging_lock);
+    const size_t page = vm.config().page_size;
+    secondaryMemory->WriteMem(address, data);
+    long frame = vm.residentFrame(static_cast<uint32_t>(address / page));
+    if (frame >= 0) mainMemory->WriteMem(static_cast<uint32_t>(frame * page + address % page), data);
+}
+
+void MemoryManager::discardLines(uint32_t address, size_t size) {
+    const uint32_t line_size = static_cast<uint32_t>(L2_cache->config().line_size);
+    auto discard = [&](uint32_t physical) {
+        const uint32_t base = physical - physical % line_size;
+        std::lock_guard<std::mutex> bus(busFor(base));
+        // Como na expulsão da L2: a cópia da L2 vai primeiro para a memória e
+        // os dados Modified das L1, mais novos, por cima
+        L2_cache->snoop(base, true, this);
+        for (size_t core = 0; core < L1_caches.size(); ++core) snoopCore(core, base, true, this);
+    };
+    const uint32_t end = static_cast<uint32_t>(address + size);
+    if (!vm.enabled()) {
+        for (uint32_t base = address - address % line_size; base < end; base += line_size) discard(base);
+        return;
+    }
+    // Com paginação as caches guardam endereços físicos: só as páginas
+    // presentes têm linhas a descartar
+    std::shared_lock<std::shared_mutex> lock(paging_lock);
+    const uint32_t page = static_cast<uint32_t>(vm.config().page_size);
+    const uint32_t step = std::min(line_size, page);
+    for (uint32_t base = address - address % step; base < end; base += step) {
+        long frame = vm.residentFrame(base / page);
+        if (frame >= 0) discard(static_cast<uint32_t>(frame) * page + base % page);
+    }
+}
+
+// Função chamada pela cache para escrever dados "sujos" de volta na memória
+void MemoryManager::writePhysical(uint32_t address, uint32_t data) {
     if (address < mainMemoryLimit) {
         mainMemory->WriteMem(address, data);
     } else {
@@ -86,10 +640,72 @@ void MemoryManager::writeToFile(uint32_t address, uint32_t data) {
 }
 
 void MemoryManager::resetCache() {
-    L1_cache->reset();
+    for (auto &cache : L1_caches) {
+        cache->reset();
+    }
+    L2_cache->reset();
+    for (auto *counter : {&coherence.l2_hits, &coherence.l2_misses, &coherence.invalidations,
+                          &coherence.interventions, &coherence.upgrades, &coherence.back_invalidations,
+                          &prefetch.issued, &prefetch.useful, &prefetch.late, &prefetch.redundant,
+                          &prefetch.fill_cycles, &prefetch.saved_cycles, &buffers.writebacks,
+                          &buffers.writeback_cycles, &buffers.coalesced, &buffers.forwards,
+                          &buffers.full_stalls, &buffers.stall_cycles, &mshr.misses, &mshr.merged,
+                          &mshr.full_stalls, &mshr.dependency_stalls, &mshr.stall_cycles, &mshr.miss_cycles,
+                          &switches, &switch_invalidations, &flushing.flushes, &flushing.lines,
+                          &flushing.batches, &flushing.cycles, &flushing.unbatched_cycles}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    for (auto &victim : victims) {
+        victim->reset();
+    }
+    secondaryMemory->resetDevice();
+    vm.reset();
+    for (auto &unit : cores) {
+        unit.segments.clear();
+        unit.prefetcher.reset();
+        unit.write_buffer.reset();
+        unit.mshrs.reset();
+        unit.mshr_peak = 0;
+        unit.clock = 0;
+    }
 }
 
-void MemoryManager::simulateContextSwitch() {
+namespace {
+
+struct SwitchPolicyName {
+    const char *name;
+    SwitchPolicy policy;
+};
+
+const SwitchPolicyName SWITCH_POLICY_NAMES[] = {
+    {"partial", SwitchPolicy::Partial},
+    {"asid", SwitchPolicy::Asid},
+    {"asid-flush", SwitchPolicy::AsidFlush},
+};
+
+} // namespace
+
+bool parseSwitchPolicy(const std::string &name, SwitchPolicy &out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    std::replace(lower.begin(), lower.end(), '_', '-');
+    for (const auto &entry : SWITCH_POLICY_NAMES) {
+        if (lower == entry.name) {
+            out = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* switchPolicyName(SwitchPolicy policy) {
+    for (const auto &entry : SWITCH_POLICY_NAMES) {
+        if (entry.policy == policy) return entry.name;
+    }
+    return "?";
+}
+
+void MemoryManager::simulateContextSwitch(int core, int asid, const MemWeights &weights) {
     // Durante um context switch, parte da cache é invalidada (cache pollution)
     // Context switches causam:
     // - FCFS: menos switches (menos pollution) -> melhor cache
@@ -106,21 +722,228 @@ void MemoryManager::simulateContextSwitch() {
     // Isso permite que:
     // - Escalonadores com menos switches mantenham mais cache quente
     // - Multi-core tenha vantagem por menos contenção
-    L1_cache->invalidatePartial(0.3f);  // Invalida 30% da cache
+    //
+    // Com linhas marcadas por ASID a troca não precisa invalidar nada; em
+    // AsidFlush só as linhas do processo que sai são descartadas.
+    const size_t index = static_cast<size_t>(core);
+    Cache &cache = *L1_caches.at(index);
+    cores[index].clock += chargeFlush(cache.flush(&l1_sinks[index]), weights.l2, weights.cache);
+    size_t invalidated = 0;
+    switch (switch_policy) {
+        case SwitchPolicy::Partial:
+            invalidated = cache.invalidatePartial(0.3f, &l1_sinks[index]);  // Invalida 30% da L1
+            break;
+        case SwitchPolicy::AsidFlush:
+            invalidated = cache.invalidateAsid(static_cast<uint32_t>(asid), &l1_sinks[index]);
+            break;
+        case SwitchPolicy::Asid:
+            break;
+    }
+    switches.fetch_add(1, std::memory_order_relaxed);
+    switch_invalidations.fetch_add(invalidated, std::memory_order_relaxed);
 }
 
-void MemoryManager::simulateContextSwitchLight() {
+void MemoryManager::simulateContextSwitchLight(int core) {
     // Context switch sem preempção (ex: FCFS puro)
     // Quase não polui a cache, apenas marca algumas entradas como menos recentes
-    L1_cache->invalidatePartial(0.1f);  // Invalida apenas 10% da cache
+    size_t invalidated = 0;
+    if (switch_policy == SwitchPolicy::Partial) {
+        const size_t index = static_cast<size_t>(core);
+        invalidated = L1_caches.at(index)->invalidatePartial(0.1f, &l1_sinks[index]);  // Invalida apenas 10% da L1
+    }
+    switches.fetch_add(1, std::memory_order_relaxed);
+    switch_invalidations.fetch_add(invalidated, std::memory_order_relaxed);
+}
+
+SwitchStats MemoryManager::switchStats() const {
+    SwitchStats stats;
+    stats.switches = switches.load(std::memory_order_relaxed);
+    stats.invalidated_lines = switch_invalidations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryManager::flushCaches(const MemWeights &weights) {
+    // L1 -> L2 (ou memória, se a linha não estiver na L2) e depois L2 -> memória
+    for (size_t core = 0; core < L1_caches.size(); ++core) {
+        cores[core].clock += chargeFlush(L1_caches[core]->flush(&l1_sinks[core]), weights.l2, weights.cache);
+    }
+    chargeFlush(L2_cache->flush(this), weights.primary, weights.cache);
+
+    // Com paginação, as páginas sujas voltam para a imagem na memória secundária
+    if (!vm.enabled()) return;
+    std::unique_lock<std::shared_mutex> lock(paging_lock);
+    const uint32_t page = static_cast<uint32_t>(vm.config().page_size);
+    for (const auto &dirty : vm.dirtyFrames(true)) {
+        for (uint32_t i = 0; i < page; ++i) {
+            secondaryMemory->WriteMem(dirty.second * page + i, mainMemory->ReadMem(dirty.first * page + i));
+        }
+    }
+}
+
+uint64_t MemoryManager::chargeFlush(const std::vector<std::pair<size_t, size_t>> &words, uint64_t accessCost,
+                                    uint64_t transferCost) {
+    if (words.empty()) return 0;
+    const size_t line_size = L2_cache->config().line_size;
+    uint64_t lines = 0;
+    uint64_t batches = 0;
+    size_t previous = 0;
+    for (const auto &word : words) {
+        size_t line = word.first / line_size;
+        if (lines > 0 && line == previous) continue;
+        if (lines == 0 || line != previous + 1) batches++;  // quebra de sequência: novo lote
+        lines++;
+        previous = line;
+    }
+    // Cada lote paga um acesso; as linhas seguintes, só a transferência
+    const uint64_t cost = batches * accessCost + (lines - batches) * transferCost;
+    flushing.flushes.fetch_add(1, std::memory_order_relaxed);
+    flushing.lines.fetch_add(lines, std::memory_order_relaxed);
+    flushing.batches.fetch_add(batches, std::memory_order_relaxed);
+    flushing.cycles.fetch_add(cost, std::memory_order_relaxed);
+    flushing.unbatched_cycles.fetch_add(lines * accessCost, std::memory_order_relaxed);
+    return cost;
+}
+
+FlushStats MemoryManager::flushStats() const {
+    FlushStats stats;
+    stats.flushes = flushing.flushes.load(std::memory_order_relaxed);
+    stats.lines = flushing.lines.load(std::memory_order_relaxed);
+    stats.batches = flushing.batches.load(std::memory_order_relaxed);
+    stats.cycles = flushing.cycles.load(std::memory_order_relaxed);
+    stats.unbatched_cycles = flushing.unbatched_cycles.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void MemoryManager::setCachePolicy(ReplacementPolicy policy) {
-    if (L1_cache) {
-        L1_cache->setPolicy(policy);
+    for (auto &cache : L1_caches) {
+        cache->setPolicy(policy);
     }
+    L2_cache->setPolicy(policy);
 }
 
 ReplacementPolicy MemoryManager::getCachePolicy() const {
-    return L1_cache ? L1_cache->getPolicy() : ReplacementPolicy::FIFO;
-}
\ No newline at end of file
+    return L1_caches.front()->getPolicy();
+}
+
+void MemoryManager::configureCache(const CacheConfig &l1, const CacheConfig &l2) {
+    CacheConfig shared = l2;
+    shared.line_size = l1.line_size; // a coerência é por linha: L1 e L2 usam o mesmo tamanho
+    if (!shared.valid()) {
+        throw std::invalid_argument("Geometria da L2 inválida para linhas de " +
+                                    std::to_string(l1.line_size) + " endereços");
+    }
+    for (auto &cache : L1_caches) {
+        cache->configure(l1);
+    }
+    L2_cache->configure(shared);
+    bus_locks.reset(new std::mutex[L2_cache->shardCount()]);
+    for (size_t core = 0; core < cores.size(); ++core) {
+        cores[core].prefetcher.configure(prefetch_config, l1.line_size);
+        victims[core]->configure(victims[core]->lines(), l1.line_size);
+    }
+}
+
+void MemoryManager::configurePrefetcher(const PrefetchConfig &config) {
+    if (!config.valid()) {
+        throw std::invalid_argument("Configuração de prefetch inválida: grau de 1 a " +
+                                    std::to_string(PrefetchConfig::MAX_DEGREE) + " e distância de 1 a " +
+                                    std::to_string(PrefetchConfig::MAX_DISTANCE) + " linhas");
+    }
+    prefetch_config = config;
+    for (auto &unit : cores) {
+        unit.prefetcher.configure(config, getCacheConfig().line_size);
+        unit.clock = 0;
+    }
+    for (auto *counter : {&prefetch.issued, &prefetch.useful, &prefetch.late, &prefetch.redundant,
+                          &prefetch.fill_cycles, &prefetch.saved_cycles}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+const CacheConfig& MemoryManager::getCacheConfig() const {
+    return L1_caches.front()->config();
+}
+
+const CacheConfig& MemoryManager::getL2Config() const {
+    return L2_cache->config();
+}
+
+CoherenceStats MemoryManager::coherenceStats() {
+    CoherenceStats stats;
+    stats.l2_hits = coherence.l2_hits.load(std::memory_order_relaxed);
+    stats.l2_misses = coherence.l2_misses.load(std::memory_order_relaxed);
+    stats.invalidations = coherence.invalidations.load(std::memory_order_relaxed);
+    stats.interventions = coherence.interventions.load(std::memory_order_relaxed);
+    stats.upgrades = coherence.upgrades.load(std::memory_order_relaxed);
+    stats.back_invalidations = coherence.back_invalidations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+PrefetchStats MemoryManager::prefetchStats() {
+    PrefetchStats stats;
+    stats.issued = prefetch.issued.load(std::memory_order_relaxed);
+    stats.useful = prefetch.useful.load(std::memory_order_relaxed);
+    stats.late = prefetch.late.load(std::memory_order_relaxed);
+    stats.redundant = prefetch.redundant.load(std::memory_order_relaxed);
+    stats.fill_cycles = prefetch.fill_cycles.load(std::memory_order_relaxed);
+    stats.saved_cycles = prefetch.saved_cycles.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryManager::configureBuffers(const BufferConfig &config) {
+    if (!config.valid()) {
+        throw std::invalid_argument("Victim cache e buffer de escrita aceitam até " +
+                                    std::to_string(BufferConfig::MAX_ENTRIES) + " linhas");
+    }
+    buffer_config = config;
+    for (size_t core = 0; core < cores.size(); ++core) {
+        victims[core]->configure(config.victim_lines, getCacheConfig().line_size);
+        cores[core].write_buffer.configure(config.write_buffer_entries);
+    }
+    for (auto *counter : {&buffers.writebacks, &buffers.writeback_cycles, &buffers.coalesced,
+                          &buffers.forwards, &buffers.full_stalls, &buffers.stall_cycles}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+BufferStats MemoryManager::bufferStats() {
+    BufferStats stats;
+    for (auto &victim : victims) {
+        stats.victim_hits += victim->get_hits();
+        stats.victim_misses += victim->get_misses();
+    }
+    stats.writebacks = buffers.writebacks.load(std::memory_order_relaxed);
+    stats.writeback_cycles = buffers.writeback_cycles.load(std::memory_order_relaxed);
+    stats.coalesced = buffers.coalesced.load(std::memory_order_relaxed);
+    stats.forwards = buffers.forwards.load(std::memory_order_relaxed);
+    stats.full_stalls = buffers.full_stalls.load(std::memory_order_relaxed);
+    stats.stall_cycles = buffers.stall_cycles.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void MemoryManager::configureMshrs(size_t entries) {
+    if (entries > MshrFile::MAX_ENTRIES) {
+        throw std::invalid_argument("A L1 aceita até " + std::to_string(MshrFile::MAX_ENTRIES) + " MSHRs");
+    }
+    mshr_entries = entries;
+    for (auto &unit : cores) {
+        unit.mshrs.configure(entries);
+        unit.mshr_peak = 0;
+    }
+    for (auto *counter : {&mshr.misses, &mshr.merged, &mshr.full_stalls, &mshr.dependency_stalls,
+                          &mshr.stall_cycles, &mshr.miss_cycles}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+MshrStats MemoryManager::mshrStats() {
+    MshrStats stats;
+    stats.misses = mshr.misses.load(std::memory_order_relaxed);
+    stats.merged = mshr.merged.load(std::memory_order_relaxed);
+    stats.full_stalls = mshr.full_stalls.load(std::memory_order_relaxed);
+    stats.dependency_stalls = mshr.dependency_stalls.load(std::memory_order_relaxed);
+    stats.stall_cycles = mshr.stall_cycles.load(std::memory_order_relaxed);
+    stats.miss_cycles = mshr.miss_cycles.load(std::memory_order_relaxed);
+    for (const auto &unit : cores) stats.peak = std::max(stats.peak, unit.mshr_peak);
+    return stats;
+}
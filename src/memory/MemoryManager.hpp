@@ -1,47 +1,442 @@
 #ifndef MEMORY_MANAGER_HPP
 #define MEMORY_MANAGER_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include "MAIN_MEMORY.hpp"
 #include "SECONDARY_MEMORY.hpp"
 #include "cache.hpp" // Incluir a cache
 #include "cachePolicy.hpp" // Incluir para ReplacementPolicy enum
+#include "prefetcher.hpp"
+#include "victimCache.hpp"
+#include "writeBuffer.hpp"
+#include "mshr.hpp"
+#include "virtualMemory.hpp"
+#include "physicalAllocator.hpp"
 #include "../cpu/PCB.hpp" // Incluir o PCB para as métricas
 
 const size_t MAIN_MEMORY_SIZE = 1024;
 
-class MemoryManager {
+// Geometria padrão da L2 compartilhada (a linha acompanha a da L1)
+inline CacheConfig defaultL2Config() {
+    CacheConfig l2;
+    l2.capacity = 4096;
+    l2.ways = 8;
+    l2.shards = 8;
+    return l2;
+}
+
+// Tráfego do protocolo de coerência e da L2 (cópia dos contadores atômicos)
+struct CoherenceStats {
+    uint64_t l2_hits = 0;
+    uint64_t l2_misses = 0;
+    uint64_t invalidations = 0;      // cópias em outras L1 invalidadas (escrita/RFO)
+    uint64_t interventions = 0;      // linha Modified entregue por outra L1 (write-back + S)
+    uint64_t upgrades = 0;           // Shared -> Modified sem buscar dados
+    uint64_t back_invalidations = 0; // cópias em L1 removidas por expulsão na L2 (inclusão)
+};
+
+// Victim cache por L1 e buffer de escrita por núcleo (--victim-cache,
+// --write-buffer); 0 = desligado
+struct BufferConfig {
+    static constexpr size_t MAX_ENTRIES = 64;
+
+    size_t victim_lines = 0;          // linhas da victim cache de cada L1
+    size_t write_buffer_entries = 0;  // linhas pendentes no buffer de escrita
+
+    bool valid() const { return victim_lines <= MAX_ENTRIES && write_buffer_entries <= MAX_ENTRIES; }
+};
+
+// Victim cache e buffer de escrita (ambos desligados por padrão)
+struct BufferStats {
+    uint64_t victim_hits = 0;
+    uint64_t victim_misses = 0;
+    uint64_t writebacks = 0;        // linhas sujas escritas na memória
+    uint64_t writeback_cycles = 0;  // ciclos de write-back síncrono (sem buffer)
+    uint64_t coalesced = 0;         // escritas absorvidas por uma linha pendente
+    uint64_t forwards = 0;          // leituras servidas pelo buffer
+    uint64_t full_stalls = 0;       // esperas por buffer cheio
+    uint64_t stall_cycles = 0;      // ciclos dessas esperas
+};
+
+// Cache não bloqueante (--mshrs; desligada por padrão)
+struct MshrStats {
+    uint64_t misses = 0;             // misses primários (ocupam um MSHR)
+    uint64_t merged = 0;             // misses secundários juntados a um pedido em curso
+    uint64_t full_stalls = 0;        // esperas por MSHR livre
+    uint64_t dependency_stalls = 0;  // esperas por um dado ainda a caminho
+    uint64_t stall_cycles = 0;       // ciclos de todas as esperas (inclui a troca de contexto)
+    uint64_t miss_cycles = 0;        // latência somada dos misses primários
+    uint64_t peak = 0;               // maior número de misses simultâneos num núcleo
+};
+
+// O que a troca de contexto faz com a L1 do núcleo (--switch-policy)
+enum class SwitchPolicy {
+    Partial,   // invalida 30% das linhas (10% na chegada de um processo novo)
+    Asid,      // linhas marcadas com o ASID: a troca não invalida nada
+    AsidFlush  // invalida só as linhas do processo que sai
+};
+// Converte o nome ("partial", "asid", "asid-flush"); false se desconhecido
+bool parseSwitchPolicy(const std::string &name, SwitchPolicy &out);
+const char* switchPolicyName(SwitchPolicy policy);
+
+// Efeito das trocas de contexto nas L1
+struct SwitchStats {
+    uint64_t switches = 0;           // trocas (inclui a chegada de processos novos)
+    uint64_t invalidated_lines = 0;  // linhas descartadas por elas
+};
+
+// Flush das linhas sujas (troca de contexto e fim da execução). As palavras
+// saem em ordem de endereço; linhas consecutivas formam um lote que paga o
+// acesso ao nível inferior uma vez, e cada linha seguinte só a transferência
+struct FlushStats {
+    uint64_t flushes = 0;           // flushes com ao menos uma linha suja
+    uint64_t lines = 0;             // linhas escritas
+    uint64_t batches = 0;           // lotes de linhas consecutivas
+    uint64_t cycles = 0;            // custo cobrado, em lotes
+    uint64_t unbatched_cycles = 0;  // custo se cada linha fosse escrita sozinha
+};
+
+// Hierarquia de memória: uma L1 privada por núcleo, uma L2 compartilhada e
+// inclusiva, memória principal e secundária.
+// - Hits na L1 só tomam o lock da própria L1.
+// - Misses, upgrades e expulsões da L2 passam pelo "barramento", onde as
+//   outras L1 são consultadas (snoop) segundo o protocolo MESI. O barramento
+//   é dividido como a L2 (um lock por shard de conjuntos da L2): transações em
+//   linhas de shards diferentes correm em paralelo, e a vítima de uma expulsão
+//   na L2 está sempre no mesmo shard da linha que a expulsou.
+// - O núcleo de cada acesso vem de PCB::core_id.
+// - Cada L1 pode ter um prefetcher (desligado por padrão). As buscas de
+//   prefetch seguem o mesmo caminho de um miss, mas o custo não entra nos
+//   ciclos do processo: a linha fica marcada com o instante em que chega no
+//   relógio do núcleo (ciclos de memória acumulados por ele), e um acesso
+//   antes disso paga só o restante (prefetch atrasado).
+// - Opcionalmente, cada L1 tem uma victim cache com as linhas que expulsou
+//   (consultada antes do barramento) e cada núcleo um buffer de escrita para
+//   as linhas sujas que a L2 expulsa para a memória. Sem o buffer, o miss que
+//   provocou a expulsão espera o write-back (custo de um acesso à memória).
+// - Com MSHRs, os loads e stores do pipeline detalhado não bloqueiam no
+//   miss: pagam a consulta à L1 e seguem; o dado chega `custo` ciclos depois
+//   no relógio do núcleo. O pipeline só espera quando uma instrução usa o
+//   registrador ainda pendente, quando os MSHRs acabam ou na troca de contexto.
+// - A memória secundária cobra um peso fixo por linha ou, com um modelo de
+//   dispositivo (disk/flash), latência + transferência + fila no relógio do núcleo.
+// - Com paginação, read/write recebem endereços virtuais (os que o processo
+//   usa hoje, a partir do base_address). A memória secundária guarda a imagem
+//   virtual (a página v fica nos endereços v * page_size) e a principal vira
+//   um conjunto de quadros; as caches, o barramento e o prefetch trabalham
+//   com endereços físicos (quadro * page_size + deslocamento). Uma falta de
+//   página tira as linhas do quadro vítima das caches, grava a vítima suja
+//   na secundária e traz a página nova, tudo cobrado do processo.
+// - Com segmentação, loads e stores usam deslocamentos no segmento de dados
+//   do processo (o lw/sw de hoje já é um imediato) e as buscas de instrução
+//   são conferidas no de código; só depois vem a paginação. Os descritores
+//   ficam em registradores de segmento por núcleo: o caso comum é uma
+//   verificação de limite, e só a recarga (outro processo no núcleo) lê a
+//   tabela, ao custo de um acesso à memória principal. Uma violação não
+//   lança exceção: o load devolve MEMORY_ACCESS_ERROR e o store é descartado;
+//   uma busca fora do código marca PCB::segment_fault e o Fetch encerra o processo.
+class MemoryManager : public CacheLowerLevel {
 public:
-    MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize);
+    MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize,
+                  const CacheConfig &cacheConfig = CacheConfig{}, size_t numCores = 1,
+                  const CacheConfig &l2Config = defaultL2Config());
     ~MemoryManager();  // Destrutor para limpar cache antes de destruir memórias
 
+    // `pc` dos acessos a dados: endereço do lw/sw que os fez, chave da tabela
+    // do prefetcher stride (NO_PC = o PC atual do processo)
+    static constexpr uint32_t NO_PC = UINT32_MAX;
+
     // Métodos unificados agora recebem o PCB para as métricas
-    uint32_t read(uint32_t address, PCB& process);
-    void write(uint32_t address, uint32_t data, PCB& process);
-    
+    uint32_t read(uint32_t address, PCB& process, uint32_t pc = NO_PC);
+    void write(uint32_t address, uint32_t data, PCB& process, uint32_t pc = NO_PC);
+    // Busca de instrução: igual a read(), mas com segmentação o endereço é
+    // conferido no segmento de código em vez de relativo ao de dados
+    uint32_t fetch(uint32_t address, PCB& process);
+
+    // Acessos do pipeline detalhado. Com MSHRs, um miss não bloqueia: o
+    // processo paga só a consulta à L1 e `readyAt` recebe o instante (relógio
+    // do núcleo) em que o dado chega; 0 = já disponível. Sem MSHRs equivalem
+    // a read()/write().
+    uint32_t readNonBlocking(uint32_t address, PCB &process, uint64_t &readyAt, uint32_t pc = NO_PC);
+    void writeNonBlocking(uint32_t address, uint32_t data, PCB &process, uint32_t pc = NO_PC);
+    // Espera o dado de um load pendente (dependência no pipeline)
+    void waitForLoad(PCB &process, uint64_t readyAt);
+    // Espera todos os misses pendentes do núcleo (fim do quantum)
+    void drainMisses(PCB &process);
+
     // Método para resetar a cache (útil entre execuções de diferentes escalonadores)
     void resetCache();
-    
-    // Simula cache pollution (invalidação parcial) durante context switch
-    void simulateContextSwitch();
-    
+
+    // Simula cache pollution (invalidação parcial) na L1 do núcleo durante
+    // context switch; `asid` é o pid do processo que sai (ver SwitchPolicy).
+    // Antes, as linhas sujas da L1 descem para a L2 num flush em lotes, cujo
+    // custo, com os pesos `weights` do processo que sai, vai para o relógio
+    // do núcleo (é do sistema, não do processo)
+    void simulateContextSwitch(int core = 0, int asid = 0, const MemWeights &weights = MemWeights{});
+
     // Simula context switch SEM invalidar cache (para single-core sem preempção)
-    void simulateContextSwitchLight();
-    
-    // Função auxiliar para o write-back da cache
+    void simulateContextSwitchLight(int core = 0);
+
+    // Escreve as linhas sujas de todas as L1 e da L2 na memória (ficam
+    // válidas e limpas): deixa a memória com o estado final da execução
+    void flushCaches(const MemWeights &weights = MemWeights{});
+    FlushStats flushStats() const;
+
+    void setSwitchPolicy(SwitchPolicy policy) { switch_policy = policy; }
+    SwitchPolicy getSwitchPolicy() const { return switch_policy; }
+    SwitchStats switchStats() const;
+
+    // Escreve na memória sem passar pela cache (carga de programas). Com
+    // paginação o endereço é virtual: vai para a imagem na memória secundária
+    // (e para o quadro, se a página estiver presente).
     void writeToFile(uint32_t address, uint32_t data);
-    
-    // Métodos para configurar e obter política de cache
+    // Tira das caches as linhas de [address, address + size) (as sujas vão
+    // para a memória). Chamada antes de gravar com writeToFile a imagem de
+    // um bloco reaproveitado: não sobram cópias do processo anterior
+    void discardLines(uint32_t address, size_t size);
+    // Write-back das caches: sempre em endereço físico
+    void writeBack(uint32_t address, uint32_t data) override { writePhysical(address, data); }
+
+    // Métodos para configurar e obter política de cache (todas as L1 e a L2)
     void setCachePolicy(ReplacementPolicy policy);
     ReplacementPolicy getCachePolicy() const;
 
+    // Geometria das caches; a L2 usa o tamanho de linha da L1
+    void configureCache(const CacheConfig &l1, const CacheConfig &l2 = defaultL2Config());
+    const CacheConfig& getCacheConfig() const;
+    const CacheConfig& getL2Config() const;
+
+    // Prefetcher de todas as L1 (zera o estado e as estatísticas do prefetch)
+    void configurePrefetcher(const PrefetchConfig &config);
+    const PrefetchConfig& getPrefetchConfig() const { return prefetch_config; }
+    PrefetchStats prefetchStats();
+
+    // Victim caches e buffers de escrita (zera o conteúdo e as estatísticas)
+    void configureBuffers(const BufferConfig &config);
+    const BufferConfig& getBufferConfig() const { return buffer_config; }
+    BufferStats bufferStats();
+
+    // MSHRs de cada L1 (0 = cache bloqueante); zera as estatísticas
+    void configureMshrs(size_t entries);
+    size_t getMshrEntries() const { return mshr_entries; }
+    MshrStats mshrStats();
+
+    // Modelo de tempo da memória secundária (zera a fila e as estatísticas).
+    // Um `backing_file` diferente do atual troca o armazenamento pelo arquivo
+    // mapeado (ou volta ao vetor em RAM): só antes do primeiro acesso.
+    void configureDevice(const DeviceConfig &config);
+    size_t getSecondaryCapacity() const { return secondaryMemory->capacity(); }
+    const DeviceConfig& getDeviceConfig() const { return secondaryMemory->deviceConfig(); }
+    DeviceStats deviceStats() { return secondaryMemory->deviceStats(); }
+
+    // Memória virtual paginada (0 quadros = desligada). Lança invalid_argument
+    // se os quadros não couberem na memória principal ou a página não for
+    // múltipla da linha. Zera tabelas, TLBs e estatísticas: só antes da carga.
+    void configurePaging(const PageConfig &config);
+    const PageConfig& getPageConfig() const { return vm.config(); }
+    PagingStats pagingStats() const { return vm.stats(); }
+
+    // Segmentação pela SegmentTable do PCB (desligada por padrão). Esvazia
+    // os registradores de segmento e zera as estatísticas.
+    void configureSegmentation(bool enabled);
+    bool segmentationEnabled() const { return segmentation; }
+    SegmentStats segmentStats() const;
+
+    // Alocador das imagens dos processos (Fixed = faixas fixas, sem
+    // alocador). A arena é o espaço que o processo endereça: memória
+    // principal + secundária, ou só a imagem virtual com paginação; por isso
+    // vem depois de configurePaging. Recomeça com a arena toda livre.
+    void configureAllocator(const AllocConfig &config);
+    const AllocConfig& getAllocConfig() const { return allocator.config(); }
+    // Base do bloco com `size` endereços, ou -1 sem espaço (thread-safe)
+    long allocate(size_t size);
+    void release(uint32_t base);
+    AllocStats allocatorStats();
+
+    size_t numCores() const { return L1_caches.size(); }
+    Cache& l1(size_t core) { return *L1_caches.at(core); }
+    CoherenceStats coherenceStats();
+
 private:
+    // Write-back das L1: vai para a L2 (inclusiva) ou, se a linha não estiver
+    // lá, direto para a memória. Linhas expulsas vão para a victim cache do núcleo.
+    struct L2WriteBack : CacheLowerLevel {
+        MemoryManager *owner = nullptr;
+        size_t core = 0;
+        void writeBack(uint32_t address, uint32_t data) override;
+        void evictLine(uint32_t base, const uint32_t *words, Mesi state) override;
+    };
+
+    // Write-back para a memória durante uma busca: escreve e anota as linhas,
+    // para que o custo caia sobre o núcleo que provocou a expulsão
+    struct WriteBackRecorder : CacheLowerLevel {
+        MemoryManager *owner = nullptr;
+        size_t line_size = 1;
+        std::vector<uint32_t> lines;  // bases distintas, todas cobradas
+        void writeBack(uint32_t address, uint32_t data) override;
+    };
+
     std::unique_ptr<MAIN_MEMORY> mainMemory;
     std::unique_ptr<SECONDARY_MEMORY> secondaryMemory;
-    std::unique_ptr<Cache> L1_cache; // Adiciona a Cache L1
+    std::vector<std::unique_ptr<Cache>> L1_caches; // Uma L1 privada por núcleo
+    std::unique_ptr<Cache> L2_cache;               // L2 compartilhada e inclusiva
+    std::vector<L2WriteBack> l1_sinks;             // Destino das expulsões de cada L1
+    std::vector<std::unique_ptr<VictimCache>> victims; // Victim cache de cada L1
+    std::unique_ptr<std::mutex[]> bus_locks;       // Um lock de barramento por shard da L2
+
+    // Contadores de coerência (relaxed: só precisam ser exatos ao fim da execução)
+    struct CoherenceCounters {
+        std::atomic<uint64_t> l2_hits{0};
+        std::atomic<uint64_t> l2_misses{0};
+        std::atomic<uint64_t> invalidations{0};
+        std::atomic<uint64_t> interventions{0};
+        std::atomic<uint64_t> upgrades{0};
+        std::atomic<uint64_t> back_invalidations{0};
+    } coherence;
+
+    // Estado temporal de cada núcleo: prefetcher, buffer de escrita, MSHRs,
+    // relógio (ciclos de memória de demanda) e registradores de segmento. Só
+    // o núcleo dono acessa;
+    // alinhado para não dividir linha do host
+    struct alignas(64) CoreState {
+        Prefetcher prefetcher;
+        WriteBuffer write_buffer;
+        MshrFile mshrs;
+        uint64_t mshr_peak = 0;
+        uint64_t clock = 0;
+        SegmentRegisters segments;
+    };
+    std::vector<CoreState> cores;
+    PrefetchConfig prefetch_config;
+    struct PrefetchCounters {
+        std::atomic<uint64_t> issued{0};
+        std::atomic<uint64_t> useful{0};
+        std::atomic<uint64_t> late{0};
+        std::atomic<uint64_t> redundant{0};
+        std::atomic<uint64_t> fill_cycles{0};
+        std::atomic<uint64_t> saved_cycles{0};
+    } prefetch;
+    BufferConfig buffer_config;
+    struct BufferCounters {
+        std::atomic<uint64_t> writebacks{0};
+        std::atomic<uint64_t> writeback_cycles{0};
+        std::atomic<uint64_t> coalesced{0};
+        std::atomic<uint64_t> forwards{0};
+        std::atomic<uint64_t> full_stalls{0};
+        std::atomic<uint64_t> stall_cycles{0};
+    } buffers;
+    size_t mshr_entries = 0;
+    SwitchPolicy switch_policy = SwitchPolicy::Partial;
+    std::atomic<uint64_t> switches{0};
+    std::atomic<uint64_t> switch_invalidations{0};
+    struct FlushCounters {
+        std::atomic<uint64_t> flushes{0};
+        std::atomic<uint64_t> lines{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> unbatched_cycles{0};
+    } flushing;
+    struct MshrCounters {
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> merged{0};
+        std::atomic<uint64_t> full_stalls{0};
+        std::atomic<uint64_t> dependency_stalls{0};
+        std::atomic<uint64_t> stall_cycles{0};
+        std::atomic<uint64_t> miss_cycles{0};
+    } mshr;
 
     size_t mainMemoryLimit;
+    size_t memoryLimit;  // memória principal + secundária
+    size_t secondarySize;  // tamanho pedido no construtor (memória secundária em RAM)
+
+    // Paginação: traduções em paralelo (lock compartilhado durante o acesso
+    // inteiro) e faltas de página exclusivas
+    VirtualMemory vm;
+    std::shared_mutex paging_lock;
+    struct PageGuard {
+        std::shared_lock<std::shared_mutex> shared;
+        std::unique_lock<std::shared_mutex> exclusive;
+    };
+
+    bool segmentation = false;
+
+    PhysicalAllocator allocator;
+    std::mutex allocator_lock;
+    // Endereço do processo -> linear pela segmentação: deslocamento no
+    // segmento `segment` ou, com `linearCheck`, endereço já linear só
+    // conferido nos limites. false = violação (contada, sem exceção).
+    // Processos sem segmentos definidos usam endereços lineares.
+    bool segmentAddress(uint32_t address, PCB &process, int segment, bool write, bool linearCheck,
+                        uint32_t &linear);
+
+    // Leitura e escrita diretas de uma palavra física na memória principal ou
+    // secundária (sem cache)
+    uint32_t readFromMemory(uint32_t address);
+    void writePhysical(uint32_t address, uint32_t data);
+    Cache& l1Of(const PCB &process) { return *L1_caches.at(static_cast<size_t>(process.core_id)); }
+    std::mutex& busFor(uint32_t address) { return bus_locks[L2_cache->shardOf(address)]; }
+    // Leitura e escrita (endereço físico) com ou sem MSHRs (`readyAt` nulo =
+    // bloqueante); `address` no store é o linear (antes da paginação), para
+    // as caches de decodificação; `pc` segue para o prefetcher
+    uint32_t load(uint32_t address, PCB &process, uint64_t *readyAt, uint32_t pc);
+    void store(uint32_t address, uint32_t physical, uint32_t data, PCB &process, bool nonBlocking, uint32_t pc);
+    // Endereço físico do acesso; com paginação, `guard` fica com o lock
+    // (compartilhado, ou exclusivo depois de uma falta) até o fim do acesso
+    uint32_t translate(uint32_t address, PCB &process, bool write, PageGuard &guard);
+    // Falta de página: libera um quadro e traz a página; devolve o quadro
+    uint32_t servicePageFault(PCB &process, uint32_t vpn, bool write);
+    // Remove das caches as linhas do quadro (dados sujos vão para ele)
+    void purgeFrame(uint32_t base);
+    // Custo de mover uma página de/para a memória secundária no instante `now`
+    uint64_t pageTransferCost(PCB &process, uint32_t address, uint64_t now);
+    // Limite dos endereços físicos (prefetch)
+    size_t physicalLimit() const {
+        return vm.enabled() ? vm.config().frames * vm.config().page_size : memoryLimit;
+    }
+    // Traz a linha do endereço para a L1 do núcleo (snoop nas outras L1, L2,
+    // memória). Com `exclusive`, invalida as outras cópias (read-for-ownership).
+    // O custo é cobrado do processo, ou devolvido em `deferred` (miss não
+    // bloqueante). Exige o lock de barramento do endereço. Devolve a palavra.
+    uint32_t serviceMiss(uint32_t address, PCB &process, bool exclusive, uint64_t *deferred = nullptr);
+    // Busca a linha em `base` para a L1 do núcleo do processo, deixando-a em
+    // `burst`. Com `demand`, o acesso entra nas contagens do processo. Exige o
+    // lock de barramento do endereço. Devolve o custo em ciclos.
+    uint64_t fetchLine(uint32_t base, PCB &process, bool exclusive, bool demand, uint32_t *burst);
+    // Primeiro uso de uma linha de prefetch: útil ou atrasada (paga o restante)
+    void consumePrefetch(PCB &process, const PrefetchMark &mark);
+    // Treina o prefetcher do núcleo com o acesso da instrução em `pc` e busca
+    // as linhas previstas
+    void runPrefetcher(uint32_t address, PCB &process, uint32_t pc, bool miss, bool prefetchHit);
+    CoreState& coreOf(const PCB &process) { return cores[static_cast<size_t>(process.core_id)]; }
+    // Hit numa linha com miss em andamento: um acesso não bloqueante junta-se
+    // ao pedido (`readyAt`); um bloqueante espera a linha chegar
+    void joinMiss(PCB &process, uint32_t address, uint64_t *readyAt);
+    // Avança o relógio do núcleo até `at`, cobrando a espera do processo
+    void stallUntil(PCB &process, uint64_t at);
+    // Custo para o núcleo da escrita de uma linha suja na memória: o
+    // write-back inteiro (síncrono) ou só a espera por espaço no buffer. A
+    // leitura que causou a expulsão tem prioridade: a escrita entra no buffer
+    // `readCost` ciclos depois
+    uint64_t writeBackDelay(PCB &process, uint32_t base, uint64_t readCost);
+    // Contabiliza um flush (palavras em ordem de endereço) cujo primeiro
+    // acesso de cada lote custa `accessCost` e cada linha seguinte do lote,
+    // `transferCost`; devolve o custo
+    uint64_t chargeFlush(const std::vector<std::pair<size_t, size_t>> &words, uint64_t accessCost,
+                         uint64_t transferCost);
+    // Custo de ler ou escrever a linha em `base` na memória secundária no
+    // instante `now` do núcleo: o peso fixo ou o modelo do dispositivo
+    uint64_t secondaryCost(PCB &process, uint32_t base, uint64_t now);
+    // Snoop na L1 e na victim cache do núcleo; devolve o estado mais forte
+    Mesi snoopCore(size_t core, size_t base, bool invalidate, CacheLowerLevel *lower);
+    // Expulsão na L2: remove as cópias da linha em todas as L1 e victim
+    // caches (inclusão); dados Modified das L1 vão para `lower`
+    void backInvalidate(size_t base, CacheLowerLevel *lower);
 };
 
-#endif // MEMORY_MANAGER_HPP
\ No newline at end of file
+#endif // MEMORY_MANAGER_HPP
@@ -1,5 +1,52 @@
 #include "SECONDARY_MEMORY.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct DeviceName {
+    const char *name;
+    DeviceKind kind;
+};
+
+const DeviceName DEVICE_NAMES[] = {
+    {"flat", DeviceKind::Flat},
+    {"disk", DeviceKind::Disk},
+    {"flash", DeviceKind::Flash},
+};
+
+} // namespace
+
+bool parseDeviceKind(const std::string &name, DeviceKind &out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "hdd") lower = "disk";
+    if (lower == "ssd") lower = "flash";
+    for (const auto &entry : DEVICE_NAMES) {
+        if (lower == entry.name) {
+            out = entry.kind;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* deviceKindName(DeviceKind kind) {
+    for (const auto &entry : DEVICE_NAMES) {
+        if (entry.kind == kind) return entry.name;
+    }
+    return "?";
+}
+
 SECONDARY_MEMORY::SECONDARY_MEMORY(size_t size) {
     if (size > MAX_SECONDARY_MEMORY_SIZE) {
         this->size = MAX_SECONDARY_MEMORY_SIZE;
@@ -7,58 +54,129 @@ SECONDARY_MEMORY::SECONDARY_MEMORY(size_t size) {
         this->size = size;
     }
     this->storage.resize(this->size, MEMORY_ACCESS_ERROR);
+    this->words = this->storage.data();
+    configureDevice(DeviceConfig{});
+}
+
+SECONDARY_MEMORY::SECONDARY_MEMORY(size_t size, const std::string &backingFile) : backing_path(backingFile) {
+    auto fail = [&](const char *what, int fd) {
+        std::string message = std::string(what) + " " + backingFile + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error(message);
+    };
+
+    int fd = ::open(backingFile.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) fail("Não foi possível abrir", fd);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) fail("Não foi possível consultar", fd);
+
+    // Sem tamanho pedido, o arquivo existente define a capacidade
+    size_t existing = static_cast<size_t>(info.st_size) / sizeof(uint32_t);
+    this->size = std::min<size_t>(size ? size : existing, MAX_MAPPED_SECONDARY_MEMORY_SIZE);
+    if (this->size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Arquivo de memória secundária vazio e sem tamanho: " + backingFile);
+    }
+    // Estender não escreve nada: o sistema de arquivos cria um arquivo esparso
+    mapped_bytes = this->size * sizeof(uint32_t);
+    if (static_cast<size_t>(info.st_size) < mapped_bytes &&
+        ::ftruncate(fd, static_cast<off_t>(mapped_bytes)) != 0) {
+        fail("Não foi possível estender", fd);
+    }
+    void *mapping = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) fail("Não foi possível mapear", fd);
+    ::close(fd);  // o mapeamento continua válido sem o descritor
+
+    this->words = static_cast<uint32_t *>(mapping);
+    configureDevice(DeviceConfig{});
 }
 
 SECONDARY_MEMORY::~SECONDARY_MEMORY() {
+    if (mapped()) {
+        // As páginas sujas já estão no page cache; msync só antecipa a escrita
+        ::msync(words, mapped_bytes, MS_ASYNC);
+        ::munmap(words, mapped_bytes);
+    }
     this->storage.clear();
 }
 
-// Simulação de acesso lento
+// Acesso direto: a lentidão do dispositivo é cobrada em ciclos por access()
 uint32_t SECONDARY_MEMORY::ReadMem(uint32_t address) {
     if (address < this->size) {
-        // Varredura simulada: percorre o vetor para encontrar o endereço
-        for (uint32_t i = 0; i < this->size; ++i) {
-            if (i == address) {
-                return storage[i];
-            }
-        }
+        return words[address];
     }
     return MEMORY_ACCESS_ERROR;
 }
 
-// Simulação de acesso lento
 uint32_t SECONDARY_MEMORY::WriteMem(uint32_t address, uint32_t data) {
     if (address < this->size) {
-        // Varredura simulada: percorre o vetor para encontrar o endereço
-        for (uint32_t i = 0; i < this->size; ++i) {
-            if (i == address) {
-                storage[i] = data;
-                return data;
-            }
-        }
+        words[address] = data;
+        return data;
     }
     return MEMORY_ACCESS_ERROR;
 }
 
 uint32_t SECONDARY_MEMORY::DeleteData(uint32_t address) {
     if (address < this->size) {
-        uint32_t deletedData = storage[address];
-        storage[address] = MEMORY_ACCESS_ERROR;
+        uint32_t deletedData = words[address];
+        words[address] = MEMORY_ACCESS_ERROR;
         return deletedData;
     }
     return MEMORY_ACCESS_ERROR;
 }
 
 bool SECONDARY_MEMORY::isEmpty() {
-    for (const auto &val : storage) {
-        if (val != MEMORY_ACCESS_ERROR) return false;
+    for (size_t i = 0; i < size; ++i) {
+        if (words[i] != MEMORY_ACCESS_ERROR) return false;
     }
     return true;
 }
 
 bool SECONDARY_MEMORY::notFull() {
-    for (const auto &val : storage) {
-        if (val == MEMORY_ACCESS_ERROR) return true;
+    for (size_t i = 0; i < size; ++i) {
+        if (words[i] == MEMORY_ACCESS_ERROR) return true;
     }
     return false;
+}
+
+void SECONDARY_MEMORY::configureDevice(const DeviceConfig &config) {
+    std::lock_guard<std::mutex> lock(device_lock);
+    device = config;
+    busy_until.assign(device.queue_depth, 0);
+    next_sequential = UINT64_MAX;
+    stats = DeviceStats{};
+}
+
+void SECONDARY_MEMORY::resetDevice() {
+    configureDevice(DeviceConfig(device));
+}
+
+uint64_t SECONDARY_MEMORY::access(uint32_t address, size_t words, uint64_t now) {
+    std::lock_guard<std::mutex> lock(device_lock);
+
+    // O pedido ocupa a posição da fila que fica livre primeiro
+    auto slot = std::min_element(busy_until.begin(), busy_until.end());
+    uint64_t start = std::max(now, *slot);
+
+    bool sequential = (address == next_sequential);
+    uint64_t service = (words + device.bandwidth - 1) / device.bandwidth;
+    // No disco, um pedido que continua o anterior não reposiciona a cabeça
+    if (device.kind == DeviceKind::Flash || !sequential) service += device.effectiveLatency();
+
+    *slot = start + service;
+    next_sequential = static_cast<uint64_t>(address) + words;
+
+    stats.requests++;
+    if (sequential) stats.sequential++;
+    if (start > now) {
+        stats.queued++;
+        stats.queue_cycles += start - now;
+    }
+    stats.service_cycles += service;
+    return (start - now) + service;
+}
+
+DeviceStats SECONDARY_MEMORY::deviceStats() {
+    std::lock_guard<std::mutex> lock(device_lock);
+    return stats;
 }
\ No newline at end of file
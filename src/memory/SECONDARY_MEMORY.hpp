@@ -4,28 +4,111 @@
 #include <cstdint>
 #include <vector>
 #include <cstddef>
+#include <mutex>
+#include <string>
 
 #define MEMORY_ACCESS_ERROR UINT32_MAX
-#define MAX_SECONDARY_MEMORY_SIZE 8192
+#define MAX_SECONDARY_MEMORY_SIZE 16384  // cobre a imagem virtual inteira com paginação
+#define MAX_MAPPED_SECONDARY_MEMORY_SIZE (size_t(1) << 30)  // 1G palavras = 4 GiB em arquivo
 
 using std::size_t;
 using std::uint32_t;
 using std::vector;
 
+// Modelo de tempo do dispositivo da memória secundária (--secondary-device)
+enum class DeviceKind {
+    Flat,   // custo fixo por linha (MemWeights::secondary)
+    Disk,   // posicionamento (seek + rotação) quando o acesso não é sequencial
+    Flash   // latência fixa de leitura/escrita por pedido
+};
+// Converte o nome ("flat", "disk", "flash"); false se desconhecido
+bool parseDeviceKind(const std::string &name, DeviceKind &out);
+const char* deviceKindName(DeviceKind kind);
+
+// Parâmetros do dispositivo. O custo de um pedido, em ciclos simulados, é
+// a espera na fila + posicionamento/latência + palavras / banda.
+struct DeviceConfig {
+    static constexpr size_t MAX_QUEUE = 64;
+
+    DeviceKind kind = DeviceKind::Flat;
+    uint64_t latency = 0;    // ciclos de posicionamento (disk) ou por pedido (flash); 0 = padrão do tipo
+    size_t bandwidth = 4;    // palavras transferidas por ciclo
+    size_t queue_depth = 1;  // pedidos atendidos ao mesmo tempo
+
+    bool timed() const { return kind != DeviceKind::Flat; }
+    uint64_t effectiveLatency() const {
+        if (latency > 0) return latency;
+        return (kind == DeviceKind::Disk) ? 60 : (kind == DeviceKind::Flash) ? 12 : 0;
+    }
+    // Arquivo mapeado como armazenamento (--secondary-file); vazio = vetor em RAM
+    std::string backing_file;
+    size_t words = 0;        // palavras no arquivo (0 = tamanho atual do arquivo ou o padrão)
+
+    bool valid() const {
+        return bandwidth >= 1 && queue_depth >= 1 && queue_depth <= MAX_QUEUE &&
+               words <= MAX_MAPPED_SECONDARY_MEMORY_SIZE;
+    }
+};
+
+// Pedidos atendidos pelo dispositivo (só com um modelo de tempo)
+struct DeviceStats {
+    uint64_t requests = 0;
+    uint64_t sequential = 0;      // continuaram o pedido anterior (disk: sem posicionamento)
+    uint64_t queued = 0;          // esperaram um pedido em curso
+    uint64_t queue_cycles = 0;    // ciclos dessas esperas
+    uint64_t service_cycles = 0;  // latência + transferência
+};
+
+// Memória secundária: armazenamento indexado diretamente (o acesso no host
+// é O(1)). Fica num vetor em RAM (até MAX_SECONDARY_MEMORY_SIZE palavras,
+// iniciadas com MEMORY_ACCESS_ERROR) ou num arquivo mapeado com mmap
+// (MAP_SHARED): pode ter gigabytes, persiste entre execuções e as páginas só
+// são lidas quando usadas. Palavras novas de um arquivo estendido valem 0.
+// A lentidão do dispositivo é cobrada em ciclos simulados por
+// access(). As palavras são sempre lidas e escritas na hora; o modelo só
+// calcula quanto o pedido custa no relógio de quem o fez. Os relógios dos
+// núcleos não são sincronizados, então a fila é uma aproximação com vários núcleos.
 class SECONDARY_MEMORY {
 private:
     size_t size;
     vector<uint32_t> storage; // Alterado para um vetor simples
+    uint32_t *words = nullptr;  // storage.data() ou o arquivo mapeado
+    std::string backing_path;   // arquivo mapeado (vazio = em RAM)
+    size_t mapped_bytes = 0;
+
+    DeviceConfig device;
+    std::mutex device_lock;          // o dispositivo é compartilhado pelos núcleos
+    vector<uint64_t> busy_until;     // término do pedido em cada posição da fila
+    uint64_t next_sequential = UINT64_MAX;  // endereço que continua o último pedido
+    DeviceStats stats;
 
     bool notFull();
     bool isEmpty();
 
 public:
     SECONDARY_MEMORY(size_t size);
+    // Mapeia `backingFile` (criado ou estendido até `size` palavras; com
+    // size 0, usa o tamanho atual do arquivo). Lança runtime_error se falhar.
+    SECONDARY_MEMORY(size_t size, const std::string &backingFile);
     ~SECONDARY_MEMORY();
+    SECONDARY_MEMORY(const SECONDARY_MEMORY &) = delete;
+    SECONDARY_MEMORY& operator=(const SECONDARY_MEMORY &) = delete;
+
+    size_t capacity() const { return size; }
+    bool mapped() const { return !backing_path.empty(); }
+    const std::string& backingFile() const { return backing_path; }
     uint32_t ReadMem(uint32_t address);
     uint32_t WriteMem(uint32_t address, uint32_t data);
     uint32_t DeleteData(uint32_t address);
+
+    // Modelo de tempo (zera a fila e as estatísticas; o arquivo não muda)
+    void configureDevice(const DeviceConfig &config);
+    const DeviceConfig& deviceConfig() const { return device; }
+    // Pedido de `words` palavras a partir de `address`, feito no instante
+    // `now` do relógio de quem pede; devolve o custo em ciclos (espera + serviço)
+    uint64_t access(uint32_t address, size_t words, uint64_t now);
+    DeviceStats deviceStats();
+    void resetDevice();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,9 +2,22 @@
 #define SEGMENT_TABLE_HPP
 
 #include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <string>
 
+// Números dos segmentos padrão de cada processo
+enum SegmentNumber { SEG_CODE = 0, SEG_DATA = 1, SEG_STACK = 2, SEG_HEAP = 3 };
+
+// Resultado de uma tradução sem exceções (caminho de acesso à memória)
+enum class SegmentFault {
+    None,
+    Invalid,     // número de segmento fora da tabela
+    NotPresent,  // segmento não carregado
+    Limit,       // deslocamento além do limite
+    ReadOnly     // escrita em segmento somente leitura
+};
+
 // Estrutura de um segmento de memória (Modelo Tanenbaum)
 struct Segment {
     uint32_t base;          // Endereço base do segmento
@@ -23,6 +36,14 @@ struct Segment {
         return offset < limit;
     }
     
+    // Mesmas verificações de getPhysicalAddress, sem exceções
+    SegmentFault check(uint32_t offset, bool write) const noexcept {
+        if (!present) return SegmentFault::NotPresent;
+        if (!isValidOffset(offset)) return SegmentFault::Limit;
+        if (write && read_only) return SegmentFault::ReadOnly;
+        return SegmentFault::None;
+    }
+    
     // Calcula o endereço físico a partir do offset
     uint32_t getPhysicalAddress(uint32_t offset) const {
         if (!present) {
@@ -40,9 +61,11 @@ class SegmentTable {
 private:
     std::vector<Segment> segments;
     int process_id;
+    uint64_t generation = 0;  // muda a cada setSegment (invalida descritores em cache)
+    bool active = false;      // algum segmento definido
 
 public:
-    SegmentTable(int pid) : process_id(pid) {
+    explicit SegmentTable(int pid = 0) : process_id(pid) {
         // Inicializa com 4 segmentos padrão: CODE, DATA, STACK, HEAP
         segments.resize(4);
     }
@@ -52,6 +75,8 @@ public:
                     bool read_only, const std::string& name) {
         if (segment_number >= 0 && segment_number < static_cast<int>(segments.size())) {
             segments[segment_number] = Segment(base, limit, true, read_only, name);
+            generation++;
+            active = true;
         }
     }
     
@@ -65,6 +90,17 @@ public:
         return seg.getPhysicalAddress(offset);
     }
     
+    // Tradução sem exceções: SegmentFault::None e `physical` preenchido, ou o motivo da falha
+    SegmentFault tryTranslate(int segment_number, uint32_t offset, bool write, uint32_t& physical) const noexcept {
+        if (segment_number < 0 || segment_number >= static_cast<int>(segments.size())) {
+            return SegmentFault::Invalid;
+        }
+        const Segment& seg = segments[segment_number];
+        SegmentFault fault = seg.check(offset, write);
+        if (fault == SegmentFault::None) physical = seg.base + offset;
+        return fault;
+    }
+    
     // Verifica se uma operação de escrita é permitida
     bool canWrite(int segment_number) const {
         if (segment_number < 0 || segment_number >= static_cast<int>(segments.size())) {
@@ -89,6 +125,109 @@ public:
     int getProcessId() const {
         return process_id;
     }
+    
+    uint64_t getGeneration() const {
+        return generation;
+    }
+    
+    // false enquanto nenhum segmento foi definido (ex.: durante a carga do programa)
+    bool isActive() const {
+        return active;
+    }
+};
+
+// Custo e violações da segmentação ao fim da execução
+struct SegmentStats {
+    uint64_t register_hits = 0;     // acessos resolvidos pelo descritor em cache
+    uint64_t descriptor_loads = 0;  // descritores lidos da tabela (registrador recarregado)
+    uint64_t load_cycles = 0;       // ciclos dessas leituras
+    uint64_t limit_faults = 0;      // acessos fora do segmento (inclui segmento inválido)
+    uint64_t protection_faults = 0; // escritas em segmento somente leitura
+    uint64_t not_present_faults = 0;
+};
+
+// Registradores de segmento de um núcleo com a parte oculta: o descritor
+// (base, limite, proteção) copiado da tabela na última carga. Um acesso cujo
+// registrador já tem o descritor do processo é só uma verificação de limite;
+// outro processo no núcleo ou uma mudança na tabela (geração) recarrega o
+// descritor. Não é thread-safe: cada núcleo tem o seu.
+class SegmentRegisters {
+public:
+    // Traduz `offset` no segmento; `loaded` indica que o descritor foi lido da tabela
+    SegmentFault translate(const SegmentTable& table, int segment_number, uint32_t offset, bool write,
+                           uint32_t& linear, bool& loaded) noexcept {
+        const Hidden* reg = nullptr;
+        SegmentFault fault = descriptor(table, segment_number, loaded, reg);
+        if (fault != SegmentFault::None) return count(fault);
+        if (offset >= reg->limit) return count(SegmentFault::Limit);
+        if (write && reg->read_only) return count(SegmentFault::ReadOnly);
+        linear = reg->base + offset;
+        return SegmentFault::None;
+    }
+    
+    // Confere um endereço linear contra o segmento (busca de instrução: o
+    // carregador já relocou o código, o PC é linear)
+    SegmentFault check(const SegmentTable& table, int segment_number, uint32_t linear, bool& loaded) noexcept {
+        const Hidden* reg = nullptr;
+        SegmentFault fault = descriptor(table, segment_number, loaded, reg);
+        if (fault != SegmentFault::None) return count(fault);
+        if (linear - reg->base >= reg->limit) return count(SegmentFault::Limit);
+        return SegmentFault::None;
+    }
+    
+    void chargeLoad(uint64_t cycles) { stats.load_cycles += cycles; }
+    void clear() {
+        for (auto& reg : regs) reg = Hidden{};
+        stats = SegmentStats{};
+    }
+    const SegmentStats& getStats() const { return stats; }
+
+private:
+    struct Hidden {
+        bool valid = false;
+        int pid = 0;
+        uint64_t generation = 0;
+        uint32_t base = 0;
+        uint32_t limit = 0;
+        bool read_only = false;
+    };
+    Hidden regs[4];
+    SegmentStats stats;
+    
+    // Descritor do segmento no registrador, recarregado da tabela se preciso
+    SegmentFault descriptor(const SegmentTable& table, int segment_number, bool& loaded, const Hidden*& out) noexcept {
+        loaded = false;
+        if (segment_number < 0 || segment_number >= 4 ||
+            segment_number >= static_cast<int>(table.getSegmentCount())) {
+            return SegmentFault::Invalid;
+        }
+        Hidden& reg = regs[segment_number];
+        if (!reg.valid || reg.pid != table.getProcessId() || reg.generation != table.getGeneration()) {
+            const Segment& seg = table.getSegment(segment_number);
+            loaded = true;
+            stats.descriptor_loads++;
+            if (!seg.present) {
+                reg.valid = false;
+                return SegmentFault::NotPresent;
+            }
+            reg = Hidden{true, table.getProcessId(), table.getGeneration(), seg.base, seg.limit, seg.read_only};
+        } else {
+            stats.register_hits++;
+        }
+        out = &reg;
+        return SegmentFault::None;
+    }
+    
+    SegmentFault count(SegmentFault fault) {
+        switch (fault) {
+            case SegmentFault::ReadOnly: stats.protection_faults++; break;
+            case SegmentFault::NotPresent: stats.not_present_faults++; break;
+            case SegmentFault::Limit:
+            case SegmentFault::Invalid: stats.limit_faults++; break;
+            case SegmentFault::None: break;
+        }
+        return fault;
+    }
 };
 
 // Classe para gerenciar endereçamento segmentado
@@ -2,187 +2,397 @@
 #include "cachePolicy.hpp"
 #include "MemoryManager.hpp" // Necessário para a lógica de write-back
 
-Cache::Cache(ReplacementPolicy p) : policy(p) {
-    this->capacity = CACHE_CAPACITY;
-    this->cacheMap.reserve(CACHE_CAPACITY);
-    this->cache_misses = 0;
-    this->cache_hits = 0;
+#include <algorithm>
+#include <stdexcept>
+
+Cache::Cache(ReplacementPolicy p, const CacheConfig &config) : replacement(p) {
+    configure(config);
 }
 
 Cache::~Cache() {
-    this->cacheMap.clear();
+    this->tags.clear();
+    this->data.clear();
+}
+
+void Cache::configure(const CacheConfig &config) {
+    if (!config.valid()) {
+        throw std::invalid_argument("Geometria de cache inválida: capacidade deve ser múltipla do tamanho "
+                                    "da linha e o número de linhas múltiplo da associatividade");
+    }
+    geometry = config;
+    num_ways = config.associativity();
+    num_sets = config.sets();
+    num_shards = std::max<size_t>(1, std::min(config.shards, num_sets));
+    shards.reset(new Shard[num_shards]);
+    tags.assign(num_sets * num_ways, 0);
+    valid_mask.assign(num_sets * num_ways, 0);
+    dirty_mask.assign(num_sets * num_ways, 0);
+    line_state.assign(num_sets * num_ways, Mesi::Invalid);
+    line_asid.assign(num_sets * num_ways, 0);
+    prefetch_marks.assign(num_sets * num_ways, PrefetchMark{});
+    data.assign(num_sets * num_ways * config.line_size, 0);
+    replacement.resize(num_sets, num_ways);
+}
+
+std::vector<std::unique_lock<std::mutex>> Cache::lockAll() {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) locks.emplace_back(shards[i].lock);
+    return locks;
+}
+
+void Cache::locate(size_t address, size_t &set, uint64_t &tag, size_t &offset) const {
+    size_t line = address / geometry.line_size;
+    offset = address % geometry.line_size;
+    set = line % num_sets;
+    tag = line / num_sets;
+}
+
+long Cache::findWay(size_t set, uint64_t tag) const {
+    const size_t first = set * num_ways;
+    for (size_t w = 0; w < num_ways; ++w) {
+        if (valid_mask[first + w] != 0 && tags[first + w] == tag) return static_cast<long>(w);
+    }
+    return -1;
+}
+
+long Cache::findLine(size_t address) const {
+    size_t set, offset;
+    uint64_t tag;
+    locate(address, set, tag, offset);
+    long way = findWay(set, tag);
+    return (way < 0) ? -1 : static_cast<long>(lineIndex(set, static_cast<size_t>(way)));
+}
+
+void Cache::writeBackLine(size_t line, size_t set, CacheLowerLevel *lower) {
+    if (dirty_mask[line] == 0 || !lower) return;
+    size_t base = lineBase(set, tags[line]);
+    for (size_t i = 0; i < geometry.line_size; ++i) {
+        if (dirty_mask[line] & (1ull << i)) {
+            lower->writeBack(static_cast<uint32_t>(base + i), data[line * geometry.line_size + i]);
+        }
+    }
+}
+
+void Cache::clearLine(size_t line) {
+    valid_mask[line] = 0;
+    dirty_mask[line] = 0;
+    line_state[line] = Mesi::Invalid;
+    prefetch_marks[line].pending = false;
 }
 
 size_t Cache::get(size_t address) {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
-    if (cacheMap.count(address) > 0 && cacheMap[address].isValid) {
-        cache_hits++;
-        
-        // Se estamos usando LRU, atualizar a ordem de acesso
-        if (policy == ReplacementPolicy::LRU) {
-            CachePolicy cachepolicy(policy);
-            cachepolicy.updateLRU(lru_list, address);
+    return get(address, nullptr);
+}
+
+size_t Cache::get(size_t address, PrefetchMark *consumed) {
+    size_t set, offset;
+    uint64_t tag;
+    locate(address, set, tag, offset);
+    Shard &shard = shardFor(set);
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    long way = findWay(set, tag);
+    if (way >= 0) {
+        size_t line = lineIndex(set, static_cast<size_t>(way));
+        if (valid_mask[line] & (1ull << offset)) {
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            replacement.onHit(set, static_cast<size_t>(way));
+            if (consumed && prefetch_marks[line].pending) {
+                *consumed = prefetch_marks[line];
+                prefetch_marks[line].pending = false;
+            }
+            return data[line * geometry.line_size + offset]; // Cache hit
         }
-        
-        return cacheMap[address].data; // Cache hit
     }
 
-    cache_misses++;
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
     return CACHE_MISS; // Cache miss
 }
 
-void Cache::put(size_t address, size_t data, MemoryManager* memManager) {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
-    // Se a cache está cheia, precisamos remover um item
-    if (cacheMap.size() >= capacity) {
-        CachePolicy cachepolicy(policy);
-        size_t addr_to_remove = -1;
-        
-        // Escolher política de substituição
-        if (policy == ReplacementPolicy::FIFO) {
-            addr_to_remove = cachepolicy.getAddressToReplaceFIFO(fifo_queue);
-        } else if (policy == ReplacementPolicy::LRU) {
-            addr_to_remove = cachepolicy.getAddressToReplaceLRU(lru_list);
+size_t Cache::allocateWay(size_t set, uint64_t tag, Mesi state, CacheLowerLevel *lower, long *evictedBase,
+                          uint32_t asid) {
+    long found = findWay(set, tag);
+    if (found >= 0) {
+        // Linha já presente (outro setor válido): só preenche as palavras
+        return static_cast<size_t>(found);
+    }
+
+    // Escolher a via a substituir conforme a política
+    size_t way = replacement.victim(set, &valid_mask[set * num_ways], tag);
+    size_t victim_line = lineIndex(set, way);
+
+    // Lógica de WRITE-BACK: se o bloco a ser removido estiver sujo...
+    if (valid_mask[victim_line] != 0) {
+        writeBackLine(victim_line, set, lower);
+        replacement.onEvict(set, way, tags[victim_line]);
+        size_t base = lineBase(set, tags[victim_line]);
+        const uint64_t full = (geometry.line_size >= 64) ? ~0ull : ((1ull << geometry.line_size) - 1);
+        if (lower && valid_mask[victim_line] == full) {
+            // Depois do write-back a linha está limpa: Modified passa a Exclusive
+            Mesi clean = (line_state[victim_line] == Mesi::Modified) ? Mesi::Exclusive : line_state[victim_line];
+            lower->evictLine(static_cast<uint32_t>(base), &data[victim_line * geometry.line_size], clean);
         }
+        if (evictedBase) *evictedBase = static_cast<long>(base);
+    }
+    clearLine(victim_line);
+    tags[victim_line] = tag;
+    line_state[victim_line] = state;
+    line_asid[victim_line] = asid;
+    replacement.onFill(set, way, tag);
+    return way;
+}
 
-        if (addr_to_remove != static_cast<size_t>(-1)) {
-            CacheEntry& entry_to_remove = cacheMap[addr_to_remove];
+void Cache::put(size_t address, size_t value, CacheLowerLevel* lower) {
+    long evicted = -1;
+    {
+        size_t set, offset;
+        uint64_t tag;
+        locate(address, set, tag, offset);
+        std::lock_guard<std::mutex> lock(shardFor(set).lock);
 
-            // Lógica de WRITE-BACK: se o bloco a ser removido estiver sujo...
-            if (entry_to_remove.isDirty) {
-                memManager->writeToFile(addr_to_remove, entry_to_remove.data);
-            }
-            // Remove da cache
-            cacheMap.erase(addr_to_remove);
+        size_t line = lineIndex(set, allocateWay(set, tag, Mesi::Exclusive, lower, &evicted, 0));
+
+        data[line * geometry.line_size + offset] = static_cast<uint32_t>(value);
+        valid_mask[line] |= (1ull << offset);
+        dirty_mask[line] &= ~(1ull << offset); // Começa como "limpo"
+    }
+    // Fora do lock: o gancho pode consultar outras caches
+    if (evicted >= 0 && eviction_hook) eviction_hook(static_cast<size_t>(evicted));
+}
+
+void Cache::fillLine(size_t base, const uint32_t *words, size_t count, CacheLowerLevel* lower, Mesi state,
+                     long *evictedBase, uint32_t asid) {
+    long evicted = -1;
+    {
+        size_t set, offset;
+        uint64_t tag;
+        locate(base, set, tag, offset);
+        std::lock_guard<std::mutex> lock(shardFor(set).lock);
+
+        size_t line = lineIndex(set, allocateWay(set, tag, state, lower, &evicted, asid));
+
+        count = std::min(count, geometry.line_size - offset);
+        uint32_t *dest = &data[line * geometry.line_size];
+        for (size_t i = 0; i < count; ++i) {
+            // Não sobrescreve palavras sujas: a cache tem a versão mais nova
+            if (!(dirty_mask[line] & (1ull << (offset + i)))) dest[offset + i] = words[i];
         }
+        uint64_t filled = (count >= 64) ? ~0ull : ((1ull << count) - 1);
+        valid_mask[line] |= filled << offset;
+    }
+    if (evictedBase) {
+        *evictedBase = evicted;
+    } else if (evicted >= 0 && eviction_hook) {
+        eviction_hook(static_cast<size_t>(evicted));
+    }
+}
+
+void Cache::update(size_t address, size_t value) {
+    size_t set, offset;
+    uint64_t tag;
+    locate(address, set, tag, offset);
+    std::lock_guard<std::mutex> lock(shardFor(set).lock);
+
+    long way = findWay(set, tag);
+
+    // Se o item não está na cache, o `put` deve ser chamado antes pelo
+    // `MemoryManager` (write-allocate). Aqui só atualizamos se existir.
+    if (way < 0) return;
+    size_t line = lineIndex(set, static_cast<size_t>(way));
+    if (!(valid_mask[line] & (1ull << offset))) return;
+
+    data[line * geometry.line_size + offset] = static_cast<uint32_t>(value);
+    dirty_mask[line] |= (1ull << offset); // Marca como sujo
+    line_state[line] = Mesi::Modified;
+}
+
+void Cache::markPrefetched(size_t base, const PrefetchMark &mark) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(base)).lock);
+    long line = findLine(base);
+    if (line >= 0) prefetch_marks[line] = mark;
+}
+
+bool Cache::readLine(size_t base, uint32_t *out) {
+    Shard &shard = shardFor(setOf(base));
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    const uint64_t full = (geometry.line_size >= 64) ? ~0ull : ((1ull << geometry.line_size) - 1);
+    long line = findLine(base);
+    if (line < 0 || valid_mask[line] != full) {
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    replacement.onHit(static_cast<size_t>(line) / num_ways, static_cast<size_t>(line) % num_ways);
+    std::copy_n(&data[static_cast<size_t>(line) * geometry.line_size], geometry.line_size, out);
+    return true;
+}
 
-    // Adiciona o novo item na cache
-    CacheEntry new_entry;
-    new_entry.data = data;
-    new_entry.isValid = true;
-    new_entry.isDirty = false; // Começa como "limpo"
+bool Cache::writeHit(size_t address, uint32_t value) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(address)).lock);
 
-    cacheMap[address] = new_entry;
-    
-    // Adiciona na estrutura de controle apropriada
-    if (policy == ReplacementPolicy::FIFO) {
-        fifo_queue.push(address);
-    } else if (policy == ReplacementPolicy::LRU) {
-        CachePolicy cachepolicy(policy);
-        cachepolicy.updateLRU(lru_list, address);
+    long line = findLine(address);
+    if (line < 0) return false;
+    size_t offset = address % geometry.line_size;
+    Mesi state = line_state[line];
+    if (!(valid_mask[line] & (1ull << offset)) || (state != Mesi::Exclusive && state != Mesi::Modified)) {
+        return false;
     }
+    data[static_cast<size_t>(line) * geometry.line_size + offset] = value;
+    dirty_mask[line] |= (1ull << offset);
+    line_state[line] = Mesi::Modified;
+    return true;
+}
+
+Mesi Cache::lineState(size_t address) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(address)).lock);
+    long line = findLine(address);
+    return (line < 0) ? Mesi::Invalid : line_state[line];
 }
 
-void Cache::update(size_t address, size_t data) {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
-    // Se o item não está na cache, primeiro o colocamos lá
-    if (cacheMap.find(address) == cacheMap.end()) {
-        // Para a simplicidade, assumimos que o `put` deve ser chamado pelo `MemoryManager`
-        // em um cache miss de escrita. Aqui, focamos em atualizar.
-        // Em um sistema real, aqui ocorreria um "write-allocate".
-        // Por ora, vamos apenas atualizar se existir.
-        return;
+void Cache::setLineState(size_t address, Mesi state) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(address)).lock);
+    long line = findLine(address);
+    if (line >= 0) line_state[line] = state;
+}
+
+Mesi Cache::snoop(size_t base, bool invalidate, CacheLowerLevel *lower) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(base)).lock);
+
+    long found = findLine(base);
+    if (found < 0) return Mesi::Invalid;
+    size_t line = static_cast<size_t>(found);
+    Mesi previous = line_state[line];
+
+    // Dados modificados seguem para o nível inferior antes de outro núcleo usá-los
+    writeBackLine(line, line / num_ways, lower);
+    dirty_mask[line] = 0;
+    if (invalidate) {
+        clearLine(line);
+    } else {
+        line_state[line] = Mesi::Shared;
     }
-    
-    cacheMap[address].data = data;
-    cacheMap[address].isDirty = true; // Marca como sujo
-    cacheMap[address].isValid = true;
+    return previous;
 }
 
 void Cache::invalidate() {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
-    for (auto &c : cacheMap) {
-        c.second.isValid = false;
-    }
-    // Limpar as estruturas de controle
-    std::queue<size_t> empty_queue;
-    fifo_queue.swap(empty_queue);
-    lru_list.clear();
+    auto locks = lockAll();
+
+    std::fill(valid_mask.begin(), valid_mask.end(), 0);
+    std::fill(dirty_mask.begin(), dirty_mask.end(), 0);
+    std::fill(line_state.begin(), line_state.end(), Mesi::Invalid);
+    replacement.reset();
 }
 
-void Cache::invalidatePartial(float percentage) {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
-    // Invalida apenas uma porcentagem da cache (cache pollution parcial)
+size_t Cache::invalidatePartial(float percentage, CacheLowerLevel *lower) {
+    auto locks = lockAll();
+
+    // Invalida apenas uma porcentagem das linhas válidas (cache pollution parcial)
     // Mais realista que invalidar tudo durante context switch
-    
-    if (percentage <= 0.0f) return;
-    if (percentage >= 1.0f) {
-        // Não chama invalidate() para evitar double-lock, faz manualmente
-        for (auto &c : cacheMap) {
-            c.second.isValid = false;
-        }
-        std::queue<size_t> empty_queue;
-        fifo_queue.swap(empty_queue);
-        lru_list.clear();
-        return;
-    }
-    
-    int entries_to_invalidate = static_cast<int>(cacheMap.size() * percentage);
-    int count = 0;
-    
-    // Invalida as primeiras N entradas (simula que o novo processo sobrescreve parte da cache)
-    for (auto &entry : cacheMap) {
-        if (count >= entries_to_invalidate) break;
-        entry.second.isValid = false;
-        count++;
-    }
-    
-    // Não limpamos as estruturas de controle completamente
-    // Apenas removemos parte dos elementos das filas
-    if (policy == ReplacementPolicy::FIFO) {
-        std::queue<size_t> new_queue;
-        int remaining = fifo_queue.size() - entries_to_invalidate;
-        while (remaining > 0 && !fifo_queue.empty()) {
-            new_queue.push(fifo_queue.front());
-            fifo_queue.pop();
-            remaining--;
+    if (percentage <= 0.0f) return 0;
+
+    size_t valid_lines = static_cast<size_t>(
+        std::count_if(valid_mask.begin(), valid_mask.end(), [](uint64_t m) { return m != 0; }));
+    size_t to_invalidate = (percentage >= 1.0f) ? valid_lines : static_cast<size_t>(valid_lines * percentage);
+    size_t invalidated = 0;
+
+    // Invalida as primeiras N linhas válidas, na ordem dos conjuntos
+    // (simula que o novo processo sobrescreve parte da cache). Dados
+    // modificados não podem se perder: seguem para o nível inferior.
+    for (size_t line = 0; line < valid_mask.size() && invalidated < to_invalidate; ++line) {
+        if (valid_mask[line] != 0) {
+            writeBackLine(line, line / num_ways, lower);
+            clearLine(line);
+            invalidated++;
         }
-        fifo_queue = new_queue;
-    } else if (policy == ReplacementPolicy::LRU) {
-        while (entries_to_invalidate > 0 && !lru_list.empty()) {
-            lru_list.pop_front();  // Remove os menos recentemente usados
-            entries_to_invalidate--;
+    }
+    return invalidated;
+}
+
+size_t Cache::invalidateAsid(uint32_t asid, CacheLowerLevel *lower) {
+    auto locks = lockAll();
+
+    size_t invalidated = 0;
+    for (size_t line = 0; line < valid_mask.size(); ++line) {
+        if (valid_mask[line] != 0 && line_asid[line] == asid) {
+            writeBackLine(line, line / num_ways, lower);
+            clearLine(line);
+            invalidated++;
         }
     }
+    return invalidated;
+}
+
+uint32_t Cache::lineAsid(size_t address) {
+    std::lock_guard<std::mutex> lock(shardFor(setOf(address)).lock);
+    long line = findLine(address);
+    return (line < 0) ? 0 : line_asid[line];
 }
 
 void Cache::reset() {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
+    auto locks = lockAll();
+
     // Limpa completamente a cache (dados + estatísticas)
-    cacheMap.clear();
-    std::queue<size_t> empty_queue;
-    fifo_queue.swap(empty_queue);
-    lru_list.clear();
-    cache_hits = 0;
-    cache_misses = 0;
+    std::fill(valid_mask.begin(), valid_mask.end(), 0);
+    std::fill(dirty_mask.begin(), dirty_mask.end(), 0);
+    std::fill(line_state.begin(), line_state.end(), Mesi::Invalid);
+    std::fill(data.begin(), data.end(), 0);
+    replacement.reset();
+    for (size_t i = 0; i < num_shards; ++i) {
+        shards[i].hits.store(0, std::memory_order_relaxed);
+        shards[i].misses.store(0, std::memory_order_relaxed);
+    }
 }
 
-std::vector<std::pair<size_t, size_t>> Cache::dirtyData() {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
+std::vector<std::pair<size_t, size_t>> Cache::collectDirty() const {
     std::vector<std::pair<size_t, size_t>> dirty_data;
-    for (const auto &c : cacheMap) {
-        if (c.second.isDirty) {
-            dirty_data.emplace_back(c.first, c.second.data);
+    for (size_t line = 0; line < dirty_mask.size(); ++line) {
+        if (dirty_mask[line] == 0) continue;
+        size_t set = line / num_ways;
+        size_t base = lineBase(set, tags[line]);
+        for (size_t i = 0; i < geometry.line_size; ++i) {
+            if (dirty_mask[line] & (1ull << i)) {
+                dirty_data.emplace_back(base + i, data[line * geometry.line_size + i]);
+            }
         }
     }
+    // As linhas saem na ordem dos conjuntos; ordenadas, linhas vizinhas na
+    // memória ficam juntas (rajadas no write-back)
+    std::sort(dirty_data.begin(), dirty_data.end());
     return dirty_data;
 }
 
-int Cache::get_misses(){
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    // Retorna o número de cache misses
-    return cache_misses;
+std::vector<std::pair<size_t, size_t>> Cache::dirtyData() {
+    auto locks = lockAll();
+    return collectDirty();
+}
+
+std::vector<std::pair<size_t, size_t>> Cache::flush(CacheLowerLevel *lower) {
+    auto locks = lockAll();
+
+    auto dirty_data = collectDirty();
+    if (!lower) return dirty_data;
+    for (const auto &word : dirty_data) {
+        lower->writeBack(static_cast<uint32_t>(word.first), static_cast<uint32_t>(word.second));
+    }
+    for (size_t line = 0; line < dirty_mask.size(); ++line) {
+        if (dirty_mask[line] == 0) continue;
+        dirty_mask[line] = 0;
+        if (line_state[line] == Mesi::Modified) line_state[line] = Mesi::Exclusive;
+    }
+    return dirty_data;
+}
+
+uint64_t Cache::get_misses() const {
+    // Retorna o número de cache misses (soma dos shards, sem travar)
+    uint64_t total = 0;
+    for (size_t i = 0; i < num_shards; ++i) total += shards[i].misses.load(std::memory_order_relaxed);
+    return total;
+}
+uint64_t Cache::get_hits() const {
+    // Retorna o número de cache hits (soma dos shards, sem travar)
+    uint64_t total = 0;
+    for (size_t i = 0; i < num_shards; ++i) total += shards[i].hits.load(std::memory_order_relaxed);
+    return total;
 }
-int Cache::get_hits(){
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    // Retorna o número de cache hits
-    return cache_hits;
-}
\ No newline at end of file
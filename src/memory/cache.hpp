@@ -2,54 +2,190 @@
 #define CACHE_HPP
 
 #include <cstdint>
-#include <cstddef> 
-#include <unordered_map>
+#include <cstddef>
 #include <vector>
-#include <queue>
-#include <list>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include "cachePolicy.hpp"
 
-#define CACHE_CAPACITY 64  // Aumentado de 16 para 64 - permite mais diferenciação
 #define CACHE_MISS UINT32_MAX
 
-struct CacheEntry {
-    size_t data;
-    bool isValid;
-    bool isDirty;
+// Geometria da cache, definida em tempo de execução (--cache-size, --cache-ways,
+// --line-size). As medidas são em endereços da memória simulada, que guardam
+// uma palavra cada; o PC e os dados avançam de 4 em 4 endereços.
+struct CacheConfig {
+    size_t capacity = 256;  // capacidade total em endereços (uma palavra cada)
+    size_t ways = 0;        // vias por conjunto (0 = totalmente associativa)
+    size_t line_size = 16;  // endereços por linha (até 64): 4 instruções
+    size_t shards = 1;      // travas independentes (conjunto % shards; limitado a sets)
+
+    size_t lines() const { return line_size ? capacity / line_size : 0; }
+    size_t associativity() const { return ways ? ways : lines(); }
+    size_t sets() const { return associativity() ? lines() / associativity() : 0; }
+    // Geometria válida: linhas inteiras, conjuntos inteiros e ao menos uma linha
+    bool valid() const {
+        return line_size >= 1 && line_size <= 64 && capacity % line_size == 0 && lines() > 0 &&
+               associativity() <= lines() && lines() % associativity() == 0;
+    }
+};
+
+// Estado de coerência MESI de uma linha. As L1 privadas usam os quatro
+// estados; numa cache sem coerência (L2, testes) as linhas ficam Exclusive
+// ou Modified.
+enum class Mesi : uint8_t {
+    Invalid,
+    Shared,
+    Exclusive,
+    Modified
 };
 
-// Forward declaration
-class MemoryManager;
-enum class ReplacementPolicy;
+// Linha trazida por prefetch e ainda não usada pela demanda: instante, no
+// relógio de ciclos do núcleo, em que os dados chegam e o custo da busca
+struct PrefetchMark {
+    bool pending = false;
+    uint64_t ready_at = 0;
+    uint64_t cost = 0;
+};
+
+// Destino do write-back das palavras sujas: a memória (MemoryManager) ou o
+// próximo nível da hierarquia
+class CacheLowerLevel {
+public:
+    virtual ~CacheLowerLevel() = default;
+    virtual void writeBack(uint32_t address, uint32_t data) = 0;
+    // Linha inteira expulsa por substituição, já limpa (depois do write-back);
+    // usado pela victim cache. Linhas parcialmente válidas não são repassadas.
+    virtual void evictLine(uint32_t, const uint32_t *, Mesi) {}
+};
 
+// Cache associativa por conjuntos em arrays contíguos.
+// - Endereço -> linha = address / line_size; conjunto = linha % sets; tag = linha / sets.
+// - Cada linha guarda a tag, uma máscara de validade por palavra (setor) e uma
+//   máscara de palavras sujas; os dados ficam num único vetor (sets*ways*line_size).
+// - Uma consulta percorre só as vias do conjunto (O(vias), sem alocação).
+// - Um miss preenche a linha inteira numa rajada (fillLine); put preenche uma
+//   palavra só, então uma linha pode estar parcialmente válida.
+//   Ao substituir uma linha, apenas as palavras sujas são escritas de volta.
+// - Cada linha tem um estado MESI; o protocolo (snoop entre as L1) fica no
+//   MemoryManager, a cache só aplica as transições pedidas.
+// - Cada linha guarda o ASID (espaço de endereçamento, o pid) de quem a
+//   trouxe. Os endereços são físicos, então o ASID não entra na comparação
+//   de tags: serve para invalidar seletivamente as linhas de um processo.
+// - Os conjuntos são divididos em shards (conjunto % shards), cada um com sua
+//   trava e contadores atômicos: acessos a conjuntos de shards diferentes não
+//   disputam a mesma trava. Operações sobre a cache inteira travam todos os
+//   shards em ordem. configure() não pode rodar em paralelo com acessos.
 class Cache {
 private:
-    std::unordered_map<size_t, CacheEntry> cacheMap;
-    std::queue<size_t> fifo_queue; // Fila para controlar a ordem de entrada (FIFO)
-    std::list<size_t> lru_list;    // Lista para controlar acessos (LRU)
-    ReplacementPolicy policy;      // Política de substituição atual
-    size_t capacity;
-    mutable std::mutex cache_mutex;  // Proteger acesso à cache em ambiente multithread
-    int cache_misses;
-    int cache_hits;
+    CacheConfig geometry;
+    size_t num_sets;
+    size_t num_ways;
+    std::vector<uint64_t> tags;
+    std::vector<uint64_t> valid_mask;  // bit i = palavra i da linha válida
+    std::vector<uint64_t> dirty_mask;  // bit i = palavra i da linha suja
+    std::vector<Mesi> line_state;      // estado MESI por linha
+    std::vector<uint32_t> line_asid;   // espaço de endereçamento que trouxe a linha
+    std::vector<PrefetchMark> prefetch_marks; // linhas de prefetch ainda não usadas
+    std::vector<uint32_t> data;
+    CachePolicy replacement;           // metadados da política de substituição
+
+    // Trava e estatísticas de um grupo de conjuntos; alinhado para que núcleos
+    // em shards diferentes não compartilhem a mesma linha de cache do host
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+    std::unique_ptr<Shard[]> shards;
+    size_t num_shards = 1;
+    std::function<void(size_t)> eviction_hook; // chamado com a base de cada linha expulsa
+
+    Shard& shardFor(size_t set) { return shards[set % num_shards]; }
+    size_t setOf(size_t address) const { return (address / geometry.line_size) % num_sets; }
+    // Trava todos os shards (operações sobre a cache inteira), na ordem dos índices
+    std::vector<std::unique_lock<std::mutex>> lockAll();
+
+    // Decompõe o endereço; devolve a via com a tag no conjunto ou -1
+    void locate(size_t address, size_t &set, uint64_t &tag, size_t &offset) const;
+    long findWay(size_t set, uint64_t tag) const;
+    // Via para a tag no conjunto: a já presente ou uma vítima (com write-back).
+    // A base da linha expulsa vai para `evictedBase` (o gancho roda sem o lock).
+    size_t allocateWay(size_t set, uint64_t tag, Mesi state, CacheLowerLevel *lower, long *evictedBase,
+                       uint32_t asid);
+    size_t lineIndex(size_t set, size_t way) const { return set * num_ways + way; }
+    size_t lineBase(size_t set, uint64_t tag) const {
+        return static_cast<size_t>((tag * num_sets + set) * geometry.line_size);
+    }
+    // Linha (índice global) que contém o endereço, ou -1
+    long findLine(size_t address) const;
+    void writeBackLine(size_t line, size_t set, CacheLowerLevel *lower);
+    void clearLine(size_t line);
+    // Palavras sujas (endereço, dado) em ordem de endereço; exige todos os locks
+    std::vector<std::pair<size_t, size_t>> collectDirty() const;
 
 public:
-    Cache(ReplacementPolicy p = static_cast<ReplacementPolicy>(0)); // FIFO por padrão
+    Cache(ReplacementPolicy p = ReplacementPolicy::FIFO, const CacheConfig &config = CacheConfig{});
     ~Cache();
-    int get_misses();
-    int get_hits();
+    uint64_t get_misses() const;
+    uint64_t get_hits() const;
+    // Shard (trava) responsável pelo endereço
+    size_t shardOf(size_t address) const { return setOf(address) % num_shards; }
+    size_t shardCount() const { return num_shards; }
     size_t get(size_t address);
-    // O método put agora precisa interagir com o MemoryManager para o write-back
-    void put(size_t address, size_t data, MemoryManager* memManager);
+    // Como get; num hit que é o primeiro uso de uma linha de prefetch, a marca
+    // da linha é consumida e copiada para `consumed`
+    size_t get(size_t address, PrefetchMark *consumed);
+    // O método put agora precisa interagir com o nível inferior para o write-back
+    void put(size_t address, size_t data, CacheLowerLevel* lower);
+    // Preenche a linha que começa em `base` com `count` palavras lidas em rajada.
+    // Palavras sujas já presentes na linha são preservadas; uma linha nova entra
+    // no estado `state`, marcada com `asid`. Com `evictedBase`, a base da linha
+    // expulsa (ou -1) é devolvida ao chamador em vez de acionar o gancho de expulsão.
+    void fillLine(size_t base, const uint32_t *words, size_t count, CacheLowerLevel* lower,
+                  Mesi state = Mesi::Exclusive, long *evictedBase = nullptr, uint32_t asid = 0);
+    // Marca a linha (já presente) como trazida por prefetch
+    void markPrefetched(size_t base, const PrefetchMark &mark);
+    // Copia a linha inteira (todas as palavras válidas) para `out`; conta hit/miss
+    bool readLine(size_t base, uint32_t *out);
     void update(size_t address, size_t data);
-    void invalidate();          // Invalida toda a cache
-    void invalidatePartial(float percentage = 0.5);  // Invalida parcialmente (padrão 50%)
+    // Escrita que só acerta se a linha for exclusiva da cache (E ou M); passa a M
+    bool writeHit(size_t address, uint32_t data);
+
+    // Coerência: estado da linha do endereço e transições pedidas pelo barramento
+    Mesi lineState(size_t address);
+    void setLineState(size_t address, Mesi state);
+    // Outro núcleo pediu a linha: palavras sujas vão para `lower` e a linha
+    // passa a Shared ou é invalidada. Devolve o estado anterior.
+    Mesi snoop(size_t base, bool invalidate, CacheLowerLevel *lower);
+    // Chamado (com a base da linha, fora do lock da cache) sempre que uma linha
+    // válida é expulsa, depois do write-back dela
+    void setEvictionHook(std::function<void(size_t)> hook) { eviction_hook = std::move(hook); }
+    void invalidate();          // Invalida toda a cache (descarta os dados sujos: flush antes)
+    // Invalida a fração `percentage` das linhas válidas, as primeiras na ordem
+    // dos conjuntos; palavras sujas vão antes para `lower`. Devolve quantas.
+    size_t invalidatePartial(float percentage = 0.5, CacheLowerLevel *lower = nullptr);
+    // Invalida só as linhas do espaço de endereçamento `asid` (write-back em
+    // `lower`). Devolve quantas.
+    size_t invalidateAsid(uint32_t asid, CacheLowerLevel *lower);
+    // ASID da linha do endereço (0 se ausente)
+    uint32_t lineAsid(size_t address);
     void reset(); // Reseta completamente a cache (dados + estatísticas)
-    std::vector<std::pair<size_t, size_t>> dirtyData(); // Mantido para possíveis outras lógicas
-    
+    // Palavras sujas (endereço, dado), em ordem de endereço
+    std::vector<std::pair<size_t, size_t>> dirtyData();
+    // Escreve todas as palavras sujas em `lower`, em ordem de endereço, e as
+    // marca limpas (Modified passa a Exclusive); as linhas continuam válidas.
+    // Devolve as palavras escritas.
+    std::vector<std::pair<size_t, size_t>> flush(CacheLowerLevel *lower);
+
+    // Redefine a geometria (descarta o conteúdo e as estatísticas)
+    void configure(const CacheConfig &config);
+    const CacheConfig& config() const { return geometry; }
+
     // Métodos para trocar política em tempo de execução
-    void setPolicy(ReplacementPolicy p) { policy = p; }
-    ReplacementPolicy getPolicy() const { return policy; }
+    void setPolicy(ReplacementPolicy p) { replacement.setPolicy(p); }
+    ReplacementPolicy getPolicy() const { return replacement.getPolicy(); }
 };
 
-#endif
\ No newline at end of file
+#endif
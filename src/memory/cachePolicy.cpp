@@ -1,40 +1,73 @@
 #include "cachePolicy.hpp"
 
-CachePolicy::CachePolicy(ReplacementPolicy p) : policy(p) {}
+#include <algorithm>
+#include <cctype>
 
-CachePolicy::~CachePolicy() {}
+namespace {
 
-// Implementação da política FIFO
-size_t CachePolicy::getAddressToReplaceFIFO(std::queue<size_t>& fifo_queue) {
-    if (fifo_queue.empty()) {
-        return -1; // Retorna -1 se não houver nada para remover
-    }
+struct PolicyName {
+    const char *name;
+    ReplacementPolicy policy;
+};
 
-    // Pega o primeiro endereço que entrou na fila
-    size_t address_to_remove = fifo_queue.front();
-    // Remove da fila
-    fifo_queue.pop();
+const PolicyName POLICY_NAMES[] = {
+    {"FIFO", ReplacementPolicy::FIFO},   {"LRU", ReplacementPolicy::LRU},
+    {"CLOCK", ReplacementPolicy::CLOCK}, {"LFU", ReplacementPolicy::LFU},
+    {"ARC", ReplacementPolicy::ARC},     {"2Q", ReplacementPolicy::TWO_Q},
+    {"SRRIP", ReplacementPolicy::SRRIP},
+};
 
-    return address_to_remove;
+} // namespace
+
+bool parseReplacementPolicy(const std::string &name, ReplacementPolicy &out) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    if (upper == "TWO_Q") upper = "2Q";
+    for (const auto &entry : POLICY_NAMES) {
+        if (upper == entry.name) {
+            out = entry.policy;
+            return true;
+        }
+    }
+    return false;
 }
 
-// Implementação da política LRU (Least Recently Used)
-size_t CachePolicy::getAddressToReplaceLRU(std::list<size_t>& lru_list) {
-    if (lru_list.empty()) {
-        return -1; // Retorna -1 se não houver nada para remover
+const char* replacementPolicyName(ReplacementPolicy p) {
+    for (const auto &entry : POLICY_NAMES) {
+        if (entry.policy == p) return entry.name;
     }
+    return "?";
+}
+
+CachePolicy::CachePolicy(ReplacementPolicy p) : policy(p), impl(make(p)) {}
 
-    // Remove o primeiro da lista (menos recentemente usado)
-    size_t address_to_remove = lru_list.front();
-    lru_list.pop_front();
+CachePolicy::~CachePolicy() {}
 
-    return address_to_remove;
+CachePolicy::Impl CachePolicy::make(ReplacementPolicy p) {
+    switch (p) {
+        case ReplacementPolicy::LRU:   return AgePolicy(true);
+        case ReplacementPolicy::CLOCK: return ClockPolicy();
+        case ReplacementPolicy::LFU:   return LfuPolicy();
+        case ReplacementPolicy::ARC:   return ArcPolicy();
+        case ReplacementPolicy::TWO_Q: return TwoQPolicy();
+        case ReplacementPolicy::SRRIP: return SrripPolicy();
+        case ReplacementPolicy::FIFO:
+        default:                       return AgePolicy(false);
+    }
+}
+
+void CachePolicy::resize(size_t numSets, size_t numWays) {
+    sets = numSets;
+    ways = numWays ? numWays : 1;
+    std::visit([&](auto &p) { p.resize(sets, ways); }, impl);
 }
 
-// Atualiza o acesso LRU - move endereço para o final (mais recente)
-void CachePolicy::updateLRU(std::list<size_t>& lru_list, size_t address) {
-    // Remove o endereço se já existir na lista
-    lru_list.remove(address);
-    // Adiciona no final (mais recentemente usado)
-    lru_list.push_back(address);
-}
\ No newline at end of file
+void CachePolicy::reset() {
+    std::visit([](auto &p) { p.reset(); }, impl);
+}
+
+void CachePolicy::setPolicy(ReplacementPolicy p) {
+    policy = p;
+    impl = make(p);
+    std::visit([&](auto &impl_policy) { impl_policy.resize(sets, ways); }, impl);
+}
@@ -1,37 +1,76 @@
 #ifndef CACHE_POLICY_HPP
 #define CACHE_POLICY_HPP
 
-#include "cache.hpp"
-#include <queue>
-#include <map>
-#include <list>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include "replacementPolicies.hpp"
 
 // Enum para definir a política de substituição
 enum class ReplacementPolicy {
-    FIFO,  // First In, First Out
-    LRU    // Least Recently Used
+    FIFO,   // First In, First Out
+    LRU,    // Least Recently Used
+    CLOCK,  // Segunda chance (bit de referência)
+    LFU,    // Least Frequently Used, com envelhecimento
+    ARC,    // Adaptive Replacement Cache
+    TWO_Q,  // 2Q (A1in/A1out/Am)
+    SRRIP   // Static Re-Reference Interval Prediction
 };
 
+// Converte o nome da política (sem diferenciar maiúsculas; "2Q" ou "TWO_Q").
+// Devolve false se o nome não for conhecido.
+bool parseReplacementPolicy(const std::string &name, ReplacementPolicy &out);
+const char* replacementPolicyName(ReplacementPolicy p);
+
+// Metadados de substituição de uma cache associativa por conjuntos.
+// As políticas são classes concretas (replacementPolicies.hpp) guardadas num
+// std::variant: a escolha é feita em tempo de execução (setPolicy), mas cada
+// chamada despacha para a implementação sem funções virtuais. A vítima é
+// sempre a primeira via inválida ou, com o conjunto cheio, a que a política
+// escolher. Nenhuma operação aloca memória depois do resize.
 class CachePolicy {
 private:
+    using Impl = std::variant<AgePolicy, ClockPolicy, LfuPolicy, SrripPolicy, TwoQPolicy, ArcPolicy>;
+
     ReplacementPolicy policy;
+    size_t sets = 0;
+    size_t ways = 1;
+    Impl impl;
+
+    static Impl make(ReplacementPolicy p);
 
 public:
     CachePolicy(ReplacementPolicy p = ReplacementPolicy::FIFO);
     ~CachePolicy();
 
-    // Retorna o endereço a ser substituído com base na política FIFO
-    size_t getAddressToReplaceFIFO(std::queue<size_t>& fifo_queue);
-    
-    // Retorna o endereço a ser substituído com base na política LRU
-    size_t getAddressToReplaceLRU(std::list<size_t>& lru_list);
-    
-    // Atualiza o acesso LRU (move para o final da lista)
-    void updateLRU(std::list<size_t>& lru_list, size_t address);
-    
+    // Dimensiona os metadados para a geometria da cache (zera o estado)
+    void resize(size_t sets, size_t ways);
+    void reset();
+
+    // Linha preenchida com um bloco novo (tag do bloco)
+    void onFill(size_t set, size_t way, uint64_t tag) {
+        std::visit([&](auto &p) { p.onFill(set, way, tag); }, impl);
+    }
+    // Acerto na linha
+    void onHit(size_t set, size_t way) {
+        std::visit([&](auto &p) { p.onHit(set, way); }, impl);
+    }
+    // Linha válida expulsa para dar lugar a outra (ARC/2Q guardam a tag)
+    void onEvict(size_t set, size_t way, uint64_t tag) {
+        std::visit([&](auto &p) { p.onEvict(set, way, tag); }, impl);
+    }
+
+    // Via a ser substituída no conjunto para receber `incomingTag`. `valid`
+    // aponta para as `ways` máscaras de validade do conjunto (0 = linha livre).
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag) {
+        return std::visit([&](auto &p) { return p.victim(set, valid, incomingTag); }, impl);
+    }
+
     // Getter para a política atual
     ReplacementPolicy getPolicy() const { return policy; }
-    void setPolicy(ReplacementPolicy p) { policy = p; }
+    // Troca a política (descarta o estado da anterior)
+    void setPolicy(ReplacementPolicy p);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,58 @@
+#include "mshr.hpp"
+
+#include <algorithm>
+
+void MshrFile::configure(size_t entries) {
+    capacity = entries;
+    slots.clear();
+    slots.reserve(capacity);
+}
+
+void MshrFile::reset() {
+    slots.clear();
+}
+
+void MshrFile::retire(uint64_t now) {
+    slots.erase(std::remove_if(slots.begin(), slots.end(), [now](const Entry &e) { return e.ready_at <= now; }),
+                slots.end());
+}
+
+uint64_t MshrFile::pending(size_t base, uint64_t now) {
+    retire(now);
+    for (const auto &e : slots) {
+        if (e.base == base) return e.ready_at;
+    }
+    return 0;
+}
+
+bool MshrFile::full(uint64_t now) {
+    retire(now);
+    return slots.size() >= capacity;
+}
+
+size_t MshrFile::allocate(size_t base, uint64_t readyAt) {
+    // A linha pode ter sido invalidada por outro núcleo com o miss em
+    // andamento: o novo pedido reaproveita a entrada
+    for (auto &e : slots) {
+        if (e.base == base) {
+            e.ready_at = std::max(e.ready_at, readyAt);
+            return slots.size();
+        }
+    }
+    slots.push_back(Entry{base, readyAt});
+    return slots.size();
+}
+
+uint64_t MshrFile::earliest() const {
+    uint64_t first = 0;
+    for (const auto &e : slots) {
+        if (first == 0 || e.ready_at < first) first = e.ready_at;
+    }
+    return first;
+}
+
+uint64_t MshrFile::latest() const {
+    uint64_t last = 0;
+    for (const auto &e : slots) last = std::max(last, e.ready_at);
+    return last;
+}
@@ -0,0 +1,49 @@
+#ifndef MSHR_HPP
+#define MSHR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Registradores de miss pendente (MSHRs) de uma L1: cada miss em andamento
+// ocupa uma entrada até a linha chegar, no relógio do núcleo. Como o buffer
+// de escrita, modela só o tempo: a linha já foi copiada para a L1, e a
+// entrada diz a partir de quando o dado pode ser usado.
+// - Um novo miss na mesma linha (miss secundário) junta-se à entrada existente.
+// - Sem entrada livre, o núcleo espera a primeira linha chegar.
+// Não é thread-safe: só o núcleo dono a usa.
+class MshrFile {
+public:
+    static constexpr size_t MAX_ENTRIES = 64;
+
+    explicit MshrFile(size_t entries = 0) { configure(entries); }
+
+    // Número de entradas (0 = desligado: a cache é bloqueante)
+    void configure(size_t entries);
+    bool enabled() const { return capacity > 0; }
+    size_t entries() const { return capacity; }
+    void reset();
+
+    // Instante em que a linha chega, ou 0 se não há miss pendente nela em `now`
+    uint64_t pending(size_t base, uint64_t now);
+    // Todas as entradas ocupadas em `now`
+    bool full(uint64_t now);
+    // Registra um miss primário; devolve as entradas ocupadas depois dele
+    size_t allocate(size_t base, uint64_t readyAt);
+    // Chegada da primeira e da última linha pendentes (0 se não há nenhuma)
+    uint64_t earliest() const;
+    uint64_t latest() const;
+
+private:
+    struct Entry {
+        size_t base;
+        uint64_t ready_at;
+    };
+    size_t capacity = 0;
+    std::vector<Entry> slots;
+
+    // Libera as entradas cujas linhas chegaram até `now`
+    void retire(uint64_t now);
+};
+
+#endif
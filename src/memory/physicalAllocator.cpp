@@ -0,0 +1,223 @@
+#include "physicalAllocator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iterator>
+
+namespace {
+
+struct PolicyName {
+    const char *name;
+    AllocPolicy policy;
+};
+
+const PolicyName ALLOC_POLICY_NAMES[] = {
+    {"fixed", AllocPolicy::Fixed},
+    {"buddy", AllocPolicy::Buddy},
+    {"first-fit", AllocPolicy::FirstFit},
+    {"best-fit", AllocPolicy::BestFit},
+};
+
+} // namespace
+
+bool parseAllocPolicy(const std::string &name, AllocPolicy &out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    std::replace(lower.begin(), lower.end(), '_', '-');
+    if (lower == "firstfit") lower = "first-fit";
+    if (lower == "bestfit") lower = "best-fit";
+    for (const auto &entry : ALLOC_POLICY_NAMES) {
+        if (lower == entry.name) {
+            out = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* allocPolicyName(AllocPolicy policy) {
+    for (const auto &entry : ALLOC_POLICY_NAMES) {
+        if (entry.policy == policy) return entry.name;
+    }
+    return "?";
+}
+
+void PhysicalAllocator::configure(const AllocConfig &config, size_t arenaSize) {
+    cfg = config;
+    // A arena é um número inteiro de grânulos, depois da faixa reservada
+    arena = arenaSize - arenaSize % cfg.granule;
+    const size_t start = std::min(arena, (cfg.reserved + cfg.granule - 1) / cfg.granule * cfg.granule);
+    free_lists.clear();
+    free_ranges.clear();
+    used.clear();
+    counters = AllocStats{};
+    counters.arena = arena - start;
+    if (!cfg.enabled() || counters.arena == 0) return;
+
+    if (cfg.policy != AllocPolicy::Buddy) {
+        free_ranges[static_cast<uint32_t>(start)] = counters.arena;
+        return;
+    }
+    // Maiores blocos potência de 2 alinhados que cobrem a arena (uma arena
+    // que não é potência de 2 vira alguns blocos de topo)
+    int max_order = 0;
+    while ((cfg.granule << (max_order + 1)) <= arena) ++max_order;
+    free_lists.assign(static_cast<size_t>(max_order) + 1, {});
+    size_t address = start;
+    while (address < arena) {
+        int order = max_order;
+        while (order > 0 && (address % (cfg.granule << order) != 0 || address + (cfg.granule << order) > arena)) {
+            --order;
+        }
+        free_lists[order].insert(static_cast<uint32_t>(address));
+        address += cfg.granule << order;
+    }
+}
+
+long PhysicalAllocator::allocate(size_t size) {
+    if (!cfg.enabled() || size == 0) return -1;
+    auto start = std::chrono::steady_clock::now();
+    long base = (cfg.policy == AllocPolicy::Buddy) ? allocateBuddy(size) : allocateFit(size);
+    uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    counters.alloc_ns += ns;
+    counters.max_alloc_ns = std::max(counters.max_alloc_ns, ns);
+
+    if (base < 0) {
+        counters.failures++;
+        return -1;
+    }
+    const Block &block = used[static_cast<uint32_t>(base)];
+    counters.allocations++;
+    counters.requested += block.requested;
+    counters.in_use += block.size;
+    counters.peak_in_use = std::max(counters.peak_in_use, counters.in_use);
+    return base;
+}
+
+long PhysicalAllocator::allocateBuddy(size_t size) {
+    int order = 0;
+    while ((cfg.granule << order) < size) ++order;
+    if (order >= static_cast<int>(free_lists.size())) return -1;
+
+    // Menor ordem com bloco livre; dentro dela, o de menor endereço
+    int from = order;
+    while (from < static_cast<int>(free_lists.size()) && free_lists[from].empty()) {
+        counters.search_steps++;
+        ++from;
+    }
+    if (from == static_cast<int>(free_lists.size())) return -1;
+    counters.search_steps++;
+    uint32_t base = *free_lists[from].begin();
+    free_lists[from].erase(free_lists[from].begin());
+    // Divide ao meio até o tamanho pedido; as metades de cima ficam livres
+    while (from > order) {
+        --from;
+        free_lists[from].insert(static_cast<uint32_t>(base + (cfg.granule << from)));
+        counters.splits++;
+    }
+    used[base] = Block{size, cfg.granule << order, order};
+    return static_cast<long>(base);
+}
+
+long PhysicalAllocator::allocateFit(size_t size) {
+    const size_t rounded = (size + cfg.granule - 1) / cfg.granule * cfg.granule;
+    auto chosen = free_ranges.end();
+    for (auto it = free_ranges.begin(); it != free_ranges.end(); ++it) {
+        counters.search_steps++;
+        if (it->second < rounded) continue;
+        if (cfg.policy == AllocPolicy::FirstFit) {
+            chosen = it;
+            break;
+        }
+        if (chosen == free_ranges.end() || it->second < chosen->second) chosen = it;
+        if (chosen->second == rounded) break;  // encaixe exato: não há melhor
+    }
+    if (chosen == free_ranges.end()) return -1;
+
+    uint32_t base = chosen->first;
+    size_t remaining = chosen->second - rounded;
+    free_ranges.erase(chosen);
+    if (remaining > 0) free_ranges[static_cast<uint32_t>(base + rounded)] = remaining;
+    used[base] = Block{size, rounded, 0};
+    return static_cast<long>(base);
+}
+
+bool PhysicalAllocator::release(uint32_t base) {
+    auto it = used.find(base);
+    if (it == used.end()) return false;
+    Block block = it->second;
+    used.erase(it);
+    counters.frees++;
+    counters.requested -= block.requested;
+    counters.in_use -= block.size;
+    if (cfg.policy == AllocPolicy::Buddy) {
+        releaseBuddy(base, block);
+    } else {
+        releaseFit(base, block);
+    }
+    return true;
+}
+
+void PhysicalAllocator::releaseBuddy(uint32_t base, const Block &block) {
+    int order = block.order;
+    // Une com o irmão enquanto ele estiver livre e inteiro
+    while (order + 1 < static_cast<int>(free_lists.size())) {
+        uint32_t buddy = base ^ static_cast<uint32_t>(cfg.granule << order);
+        auto found = free_lists[order].find(buddy);
+        if (found == free_lists[order].end()) break;
+        free_lists[order].erase(found);
+        base = std::min(base, buddy);
+        ++order;
+        counters.merges++;
+    }
+    free_lists[order].insert(base);
+}
+
+void PhysicalAllocator::releaseFit(uint32_t base, const Block &block) {
+    size_t size = block.size;
+    auto next = free_ranges.lower_bound(base);
+    // Vizinha de cima livre
+    if (next != free_ranges.end() && next->first == base + size) {
+        size += next->second;
+        next = free_ranges.erase(next);
+        counters.merges++;
+    }
+    // Vizinha de baixo livre
+    if (next != free_ranges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == base) {
+            prev->second += size;
+            counters.merges++;
+            return;
+        }
+    }
+    free_ranges[base] = size;
+}
+
+size_t PhysicalAllocator::blockSize(uint32_t base) const {
+    auto it = used.find(base);
+    return (it == used.end()) ? 0 : it->second.size;
+}
+
+AllocStats PhysicalAllocator::stats() const {
+    AllocStats stats = counters;
+    stats.free_total = stats.largest_free = stats.free_blocks = 0;
+    if (cfg.policy == AllocPolicy::Buddy) {
+        for (size_t order = 0; order < free_lists.size(); ++order) {
+            if (free_lists[order].empty()) continue;
+            size_t size = cfg.granule << order;
+            stats.free_blocks += free_lists[order].size();
+            stats.free_total += free_lists[order].size() * size;
+            stats.largest_free = std::max(stats.largest_free, size);
+        }
+    } else {
+        for (const auto &range : free_ranges) {
+            stats.free_blocks++;
+            stats.free_total += range.second;
+            stats.largest_free = std::max(stats.largest_free, range.second);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,106 @@
+#ifndef PHYSICAL_ALLOCATOR_HPP
+#define PHYSICAL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Onde as imagens dos processos ficam na memória (--allocator)
+enum class AllocPolicy {
+    Fixed,     // faixas fixas de 1024 endereços por processo (sem alocador)
+    Buddy,     // blocos potência de 2 divididos e unidos com o "irmão"
+    FirstFit,  // primeira faixa livre que cabe, em ordem de endereço
+    BestFit    // menor faixa livre que cabe
+};
+// Converte o nome ("fixed", "buddy", "first-fit", "best-fit"); false se desconhecido
+bool parseAllocPolicy(const std::string &name, AllocPolicy &out);
+const char* allocPolicyName(AllocPolicy policy);
+
+// Parâmetros do alocador (--allocator, --alloc-granule, --data-area)
+struct AllocConfig {
+    static constexpr size_t MAX_GRANULE = 4096;
+
+    AllocPolicy policy = AllocPolicy::Fixed;
+    size_t granule = 16;       // menor bloco (buddy) e múltiplo dos pedidos (fits)
+    size_t data_area = 512;    // endereços reservados após o código (segmento de dados)
+    size_t reserved = 0;       // endereços baixos [0, reserved) fora da arena
+
+    bool enabled() const { return policy != AllocPolicy::Fixed; }
+    bool valid() const {
+        return granule >= 1 && granule <= MAX_GRANULE && (granule & (granule - 1)) == 0 && data_area >= 1;
+    }
+};
+
+// Contadores do alocador ao fim da execução
+struct AllocStats {
+    size_t arena = 0;                 // endereços administrados
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t failures = 0;            // pedidos sem bloco livre que coubesse
+    uint64_t splits = 0;              // divisões de bloco (buddy)
+    uint64_t merges = 0;              // uniões com o bloco vizinho ou irmão
+    uint64_t search_steps = 0;        // blocos livres examinados pelas buscas
+    uint64_t alloc_ns = 0;            // tempo (host) somado das alocações
+    uint64_t max_alloc_ns = 0;        // alocação mais lenta
+    size_t requested = 0;             // endereços pedidos pelos blocos em uso
+    size_t in_use = 0;                // endereços dos blocos em uso (com o arredondamento)
+    size_t peak_in_use = 0;
+    size_t free_total = 0;
+    size_t largest_free = 0;
+    size_t free_blocks = 0;
+
+    // Fração dos blocos em uso perdida no arredondamento
+    double internalFragmentation() const { return in_use ? 1.0 - double(requested) / double(in_use) : 0.0; }
+    // Fração da memória livre fora do maior bloco livre
+    double externalFragmentation() const {
+        return free_total ? 1.0 - double(largest_free) / double(free_total) : 0.0;
+    }
+};
+
+// Alocador da memória física para as imagens dos processos. Administra os
+// endereços [reserved, arena) em unidades de `granule`. Não é thread-safe: o
+// MemoryManager serializa as chamadas.
+// - Buddy: a arena é coberta por blocos potência de 2 alinhados; um pedido
+//   pega o menor bloco livre que cabe, dividido ao meio até o tamanho
+//   necessário, e a liberação une o bloco ao irmão livre, nível a nível.
+// - First/best-fit: faixas livres ordenadas por endereço; a liberação une a
+//   faixa às vizinhas livres.
+class PhysicalAllocator {
+public:
+    void configure(const AllocConfig &config, size_t arenaSize);
+    const AllocConfig& config() const { return cfg; }
+
+    // Reserva `size` endereços; devolve a base ou -1 se nenhum bloco couber
+    long allocate(size_t size);
+    // Devolve o bloco que começa em `base`; false se não houver um em uso
+    bool release(uint32_t base);
+    // Tamanho do bloco em uso que começa em `base` (0 se não houver)
+    size_t blockSize(uint32_t base) const;
+
+    AllocStats stats() const;
+
+private:
+    struct Block {
+        size_t requested = 0;
+        size_t size = 0;
+        int order = 0;   // buddy: log2(size / granule)
+    };
+
+    AllocConfig cfg;
+    size_t arena = 0;
+    std::vector<std::set<uint32_t>> free_lists;  // buddy: blocos livres por ordem
+    std::map<uint32_t, size_t> free_ranges;      // fits: base -> tamanho
+    std::unordered_map<uint32_t, Block> used;
+    AllocStats counters;
+
+    long allocateBuddy(size_t size);
+    long allocateFit(size_t size);
+    void releaseBuddy(uint32_t base, const Block &block);
+    void releaseFit(uint32_t base, const Block &block);
+};
+
+#endif
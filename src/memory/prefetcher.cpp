@@ -0,0 +1,175 @@
+#include "prefetcher.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+struct KindName {
+    const char *name;
+    PrefetchKind kind;
+};
+
+const KindName KIND_NAMES[] = {
+    {"none", PrefetchKind::None},
+    {"next-line", PrefetchKind::NextLine},
+    {"stride", PrefetchKind::Stride},
+    {"stream", PrefetchKind::Stream},
+};
+
+} // namespace
+
+bool parsePrefetchKind(const std::string &name, PrefetchKind &out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "nextline" || lower == "next_line") lower = "next-line";
+    for (const auto &entry : KIND_NAMES) {
+        if (lower == entry.name) {
+            out = entry.kind;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* prefetchKindName(PrefetchKind kind) {
+    for (const auto &entry : KIND_NAMES) {
+        if (entry.kind == kind) return entry.name;
+    }
+    return "?";
+}
+
+Prefetcher::Prefetcher(const PrefetchConfig &config, size_t lineSize) {
+    configure(config, lineSize);
+}
+
+void Prefetcher::configure(const PrefetchConfig &config, size_t lineSize) {
+    cfg = config;
+    line_size = lineSize ? lineSize : 1;
+    rpt.assign(cfg.kind == PrefetchKind::Stride ? cfg.table_entries : 0, RptEntry{});
+    streams.assign(cfg.kind == PrefetchKind::Stream ? cfg.streams : 0, Stream{});
+    stream_clock = 0;
+}
+
+void Prefetcher::reset() {
+    std::fill(rpt.begin(), rpt.end(), RptEntry{});
+    std::fill(streams.begin(), streams.end(), Stream{});
+    stream_clock = 0;
+}
+
+size_t Prefetcher::observe(uint32_t pc, uint32_t address, bool miss, bool prefetchHit, uint32_t *out) {
+    switch (cfg.kind) {
+        case PrefetchKind::NextLine:
+            return (miss || prefetchHit) ? nextLine(address, out) : 0;
+        case PrefetchKind::Stride:
+            // A RPT aprende com todos os acessos, não só com os misses
+            return stride(pc, address, out);
+        case PrefetchKind::Stream:
+            return (miss || prefetchHit) ? stream(address, out) : 0;
+        case PrefetchKind::None:
+        default:
+            return 0;
+    }
+}
+
+size_t Prefetcher::run(int64_t line, int64_t direction, uint32_t *out) const {
+    size_t n = 0;
+    for (size_t i = 0; i < cfg.degree; ++i) {
+        int64_t target = line + direction * static_cast<int64_t>(cfg.distance + i);
+        int64_t base = target * static_cast<int64_t>(line_size);
+        if (target < 0 || base > std::numeric_limits<uint32_t>::max()) break;
+        out[n++] = static_cast<uint32_t>(base);
+    }
+    return n;
+}
+
+size_t Prefetcher::nextLine(uint32_t address, uint32_t *out) const {
+    return run(address / line_size, 1, out);
+}
+
+size_t Prefetcher::stride(uint32_t pc, uint32_t address, uint32_t *out) {
+    // Instruções são alinhadas em 4: o índice ignora os 2 bits baixos do PC
+    RptEntry &entry = rpt[(pc >> 2) % rpt.size()];
+    if (!entry.valid || entry.pc != pc) {
+        entry = RptEntry{};
+        entry.valid = true;
+        entry.pc = pc;
+        entry.last_address = address;
+        return 0;
+    }
+
+    int64_t observed = static_cast<int64_t>(address) - static_cast<int64_t>(entry.last_address);
+    bool correct = (observed == entry.stride);
+    switch (entry.state) {
+        case RptState::Initial:
+            entry.state = correct ? RptState::Steady : RptState::Transient;
+            break;
+        case RptState::Transient:
+            entry.state = correct ? RptState::Steady : RptState::NoPrediction;
+            break;
+        case RptState::Steady:
+            if (!correct) entry.state = RptState::Initial;
+            break;
+        case RptState::NoPrediction:
+            if (correct) entry.state = RptState::Transient;
+            break;
+    }
+    // Só troca o passo fora do estado estável (um desvio isolado não o apaga)
+    if (!correct && entry.state != RptState::Initial) entry.stride = observed;
+    entry.last_address = address;
+
+    if (entry.state != RptState::Steady || entry.stride == 0) return 0;
+
+    const int64_t line = address / line_size;
+    const int64_t step = entry.stride;
+    if (step > -static_cast<int64_t>(line_size) && step < static_cast<int64_t>(line_size)) {
+        // Passo menor que a linha: as próximas linhas na direção do passo
+        return run(line, step > 0 ? 1 : -1, out);
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < cfg.degree; ++i) {
+        int64_t target = static_cast<int64_t>(address) + step * static_cast<int64_t>(cfg.distance + i);
+        if (target < 0 || target > std::numeric_limits<uint32_t>::max()) break;
+        out[n++] = static_cast<uint32_t>(target - target % static_cast<int64_t>(line_size));
+    }
+    return n;
+}
+
+size_t Prefetcher::stream(uint32_t address, uint32_t *out) {
+    const int64_t line = address / line_size;
+    ++stream_clock;
+
+    // Fluxo cujo último miss está perto desta linha; senão substitui o menos usado
+    Stream *match = nullptr;
+    Stream *oldest = &streams.front();
+    for (auto &s : streams) {
+        if (s.valid && s.last_line != line && std::abs(line - s.last_line) <= STREAM_WINDOW) {
+            match = &s;
+            break;
+        }
+        if (!s.valid || (oldest->valid && s.last_use < oldest->last_use)) oldest = &s;
+    }
+    if (!match) {
+        *oldest = Stream{};
+        oldest->valid = true;
+        oldest->last_line = line;
+        oldest->last_use = stream_clock;
+        return 0;
+    }
+
+    int direction = (line > match->last_line) ? 1 : -1;
+    if (direction == match->direction) {
+        match->confidence++;
+    } else {
+        match->direction = direction;
+        match->confidence = 1;
+    }
+    match->last_line = line;
+    match->last_use = stream_clock;
+
+    // Dois passos na mesma direção confirmam o fluxo
+    return (match->confidence >= 2) ? run(line, direction, out) : 0;
+}
@@ -0,0 +1,102 @@
+#ifndef PREFETCHER_HPP
+#define PREFETCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tipo de prefetcher de hardware associado a cada L1
+enum class PrefetchKind {
+    None,      // Sem prefetch
+    NextLine,  // Próximas linhas em todo miss (e no primeiro uso de linha buscada)
+    Stride,    // Tabela de predição de referências (RPT) indexada pelo PC
+    Stream     // Fluxos sequenciais confirmados por dois misses na mesma direção
+};
+
+// Converte o nome do prefetcher ("none", "next-line", "stride", "stream");
+// devolve false se o nome não for conhecido
+bool parsePrefetchKind(const std::string &name, PrefetchKind &out);
+const char* prefetchKindName(PrefetchKind kind);
+
+// Parâmetros do prefetcher (--prefetch, --prefetch-degree, --prefetch-distance)
+struct PrefetchConfig {
+    static constexpr size_t MAX_DEGREE = 16;
+    static constexpr size_t MAX_DISTANCE = 64;
+
+    PrefetchKind kind = PrefetchKind::None;
+    size_t degree = 2;          // linhas buscadas por disparo
+    size_t distance = 1;        // linhas à frente da atual onde a busca começa
+    size_t table_entries = 64;  // entradas da RPT (stride)
+    size_t streams = 8;         // fluxos acompanhados (stream)
+
+    bool enabled() const { return kind != PrefetchKind::None; }
+    bool valid() const {
+        return degree >= 1 && degree <= MAX_DEGREE && distance >= 1 && distance <= MAX_DISTANCE &&
+               table_entries >= 1 && streams >= 1;
+    }
+};
+
+// Contadores do prefetch ao fim da execução
+struct PrefetchStats {
+    uint64_t issued = 0;       // linhas buscadas por prefetch
+    uint64_t useful = 0;       // usadas pela demanda depois de chegarem
+    uint64_t late = 0;         // usadas pela demanda antes de chegarem (stall parcial)
+    uint64_t redundant = 0;    // pedidos descartados: a linha já estava na L1
+    uint64_t fill_cycles = 0;  // ciclos de tráfego gastos pelas buscas de prefetch
+    uint64_t saved_cycles = 0; // ciclos de miss que a demanda deixou de pagar
+};
+
+// Lógica de predição de um prefetcher: observa os acessos de demanda de um
+// núcleo e devolve as bases das linhas a buscar. Não acessa a memória nem a
+// cache (quem filtra e busca é o MemoryManager) e não é thread-safe: cada
+// núcleo tem o seu.
+class Prefetcher {
+public:
+    explicit Prefetcher(const PrefetchConfig &config = PrefetchConfig{}, size_t lineSize = 16);
+
+    void configure(const PrefetchConfig &config, size_t lineSize);
+    const PrefetchConfig& config() const { return cfg; }
+    void reset();
+
+    // Acesso de demanda ao endereço pela instrução em `pc`. `miss`: a linha
+    // faltou na L1; `prefetchHit`: primeiro uso de uma linha trazida por
+    // prefetch (mantém next-line e stream à frente da demanda). Escreve até
+    // MAX_DEGREE bases em `out` e devolve quantas.
+    size_t observe(uint32_t pc, uint32_t address, bool miss, bool prefetchHit, uint32_t *out);
+
+private:
+    // Estados da RPT (Chen & Baer, 1995)
+    enum class RptState : uint8_t { Initial, Transient, Steady, NoPrediction };
+    struct RptEntry {
+        bool valid = false;
+        uint32_t pc = 0;
+        uint32_t last_address = 0;
+        int64_t stride = 0;
+        RptState state = RptState::Initial;
+    };
+    struct Stream {
+        bool valid = false;
+        int64_t last_line = 0;
+        int direction = 0;    // +1 / -1 (0 = ainda sem direção)
+        int confidence = 0;   // misses consecutivos na mesma direção
+        uint64_t last_use = 0;
+    };
+
+    // Misses a até STREAM_WINDOW linhas do último miss continuam o fluxo
+    static constexpr int64_t STREAM_WINDOW = 4;
+
+    PrefetchConfig cfg;
+    size_t line_size = 16;
+    std::vector<RptEntry> rpt;
+    std::vector<Stream> streams;
+    uint64_t stream_clock = 0;
+
+    size_t nextLine(uint32_t address, uint32_t *out) const;
+    size_t stride(uint32_t pc, uint32_t address, uint32_t *out);
+    size_t stream(uint32_t address, uint32_t *out);
+    // Linhas a partir de `line` + direction * (distance + i), i < degree
+    size_t run(int64_t line, int64_t direction, uint32_t *out) const;
+};
+
+#endif
@@ -0,0 +1,371 @@
+#include "replacementPolicies.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// Próximo valor do relógio do conjunto. Antes do overflow, os carimbos do
+// conjunto viram a posição relativa (0..ways-1), preservando a ordem.
+uint32_t nextStamp(std::vector<uint32_t> &stamps, std::vector<uint32_t> &clock, size_t set, size_t ways) {
+    if (clock[set] == std::numeric_limits<uint32_t>::max()) {
+        uint32_t *row = &stamps[set * ways];
+        std::vector<size_t> order(ways);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [row](size_t a, size_t b) { return row[a] < row[b]; });
+        for (size_t rank = 0; rank < ways; ++rank) row[order[rank]] = static_cast<uint32_t>(rank);
+        clock[set] = static_cast<uint32_t>(ways);
+    }
+    return ++clock[set];
+}
+
+// Primeira via livre do conjunto, ou `ways` se estiver cheio
+size_t freeWay(const uint64_t *valid, size_t ways) {
+    for (size_t w = 0; w < ways; ++w) {
+        if (valid[w] == 0) return w;
+    }
+    return ways;
+}
+
+// Via válida de menor carimbo entre as que satisfazem `pick`, ou `ways`
+template <typename Pick>
+size_t oldestWhere(const uint32_t *stamps, size_t ways, Pick pick) {
+    size_t chosen = ways;
+    for (size_t w = 0; w < ways; ++w) {
+        if (pick(w) && (chosen == ways || stamps[w] < stamps[chosen])) chosen = w;
+    }
+    return chosen;
+}
+
+} // namespace
+
+// ======================== FIFO / LRU ========================
+
+void AgePolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    age.assign(sets * ways, 0);
+    set_clock.assign(sets, 0);
+}
+
+void AgePolicy::reset() {
+    std::fill(age.begin(), age.end(), 0);
+    std::fill(set_clock.begin(), set_clock.end(), 0);
+}
+
+uint32_t AgePolicy::tick(size_t set) {
+    return nextStamp(age, set_clock, set, ways);
+}
+
+void AgePolicy::onFill(size_t set, size_t way, uint64_t) {
+    age[set * ways + way] = tick(set);
+}
+
+void AgePolicy::onHit(size_t set, size_t way) {
+    // Atualiza o acesso LRU (a linha passa a ser a mais recente do conjunto)
+    if (lru) {
+        age[set * ways + way] = tick(set);
+    }
+}
+
+size_t AgePolicy::victim(size_t set, const uint64_t *valid, uint64_t) {
+    const uint32_t *row = &age[set * ways];
+    size_t chosen = 0;
+    for (size_t w = 0; w < ways; ++w) {
+        if (valid[w] == 0) return w; // linha livre
+        if (row[w] < row[chosen]) chosen = w;
+    }
+    return chosen;
+}
+
+// ======================== CLOCK ========================
+
+void ClockPolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    referenced.assign(sets * ways, 0);
+    hand.assign(sets, 0);
+}
+
+void ClockPolicy::reset() {
+    std::fill(referenced.begin(), referenced.end(), 0);
+    std::fill(hand.begin(), hand.end(), 0);
+}
+
+void ClockPolicy::onFill(size_t set, size_t way, uint64_t) {
+    referenced[set * ways + way] = 1;
+}
+
+void ClockPolicy::onHit(size_t set, size_t way) {
+    referenced[set * ways + way] = 1;
+}
+
+size_t ClockPolicy::victim(size_t set, const uint64_t *valid, uint64_t) {
+    size_t free = freeWay(valid, ways);
+    if (free < ways) return free;
+
+    // Segunda chance: no máximo duas voltas (a primeira limpa todos os bits)
+    uint8_t *bits = &referenced[set * ways];
+    size_t w = hand[set];
+    while (bits[w]) {
+        bits[w] = 0;
+        w = (w + 1) % ways;
+    }
+    hand[set] = static_cast<uint32_t>((w + 1) % ways);
+    return w;
+}
+
+// ======================== LFU com envelhecimento ========================
+
+void LfuPolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    count.assign(sets * ways, 0);
+    filled_at.assign(sets * ways, 0);
+    set_accesses.assign(sets, 0);
+    set_clock.assign(sets, 0);
+}
+
+void LfuPolicy::reset() {
+    std::fill(count.begin(), count.end(), 0);
+    std::fill(filled_at.begin(), filled_at.end(), 0);
+    std::fill(set_accesses.begin(), set_accesses.end(), 0);
+    std::fill(set_clock.begin(), set_clock.end(), 0);
+}
+
+void LfuPolicy::access(size_t set) {
+    if (++set_accesses[set] < AGING_PERIOD_PER_WAY * ways) return;
+    set_accesses[set] = 0;
+    uint32_t *row = &count[set * ways];
+    for (size_t w = 0; w < ways; ++w) row[w] >>= 1;
+}
+
+void LfuPolicy::onFill(size_t set, size_t way, uint64_t) {
+    access(set);
+    count[set * ways + way] = 1;
+    filled_at[set * ways + way] = nextStamp(filled_at, set_clock, set, ways);
+}
+
+void LfuPolicy::onHit(size_t set, size_t way) {
+    access(set);
+    uint32_t &c = count[set * ways + way];
+    if (c < std::numeric_limits<uint32_t>::max()) c++;
+}
+
+size_t LfuPolicy::victim(size_t set, const uint64_t *valid, uint64_t) {
+    size_t free = freeWay(valid, ways);
+    if (free < ways) return free;
+
+    const uint32_t *row = &count[set * ways];
+    const uint32_t *fill = &filled_at[set * ways];
+    size_t chosen = 0;
+    for (size_t w = 1; w < ways; ++w) {
+        if (row[w] < row[chosen] || (row[w] == row[chosen] && fill[w] < fill[chosen])) chosen = w;
+    }
+    return chosen;
+}
+
+// ======================== SRRIP ========================
+
+void SrripPolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    rrpv.assign(sets * ways, MAX_RRPV);
+}
+
+void SrripPolicy::reset() {
+    std::fill(rrpv.begin(), rrpv.end(), MAX_RRPV);
+}
+
+void SrripPolicy::onFill(size_t set, size_t way, uint64_t) {
+    rrpv[set * ways + way] = INSERT_RRPV;
+}
+
+void SrripPolicy::onHit(size_t set, size_t way) {
+    rrpv[set * ways + way] = 0;
+}
+
+size_t SrripPolicy::victim(size_t set, const uint64_t *valid, uint64_t) {
+    size_t free = freeWay(valid, ways);
+    if (free < ways) return free;
+
+    uint8_t *row = &rrpv[set * ways];
+    for (;;) {
+        for (size_t w = 0; w < ways; ++w) {
+            if (row[w] >= MAX_RRPV) return w;
+        }
+        for (size_t w = 0; w < ways; ++w) row[w]++;
+    }
+}
+
+// ======================== Lista fantasma ========================
+
+void GhostList::resize(size_t sets, size_t cap) {
+    capacity = cap ? cap : 1;
+    tags.assign(sets * capacity, 0);
+    sizes.assign(sets, 0);
+}
+
+void GhostList::reset() {
+    std::fill(sizes.begin(), sizes.end(), 0);
+}
+
+bool GhostList::contains(size_t set, uint64_t tag) const {
+    const uint64_t *row = &tags[set * capacity];
+    return std::find(row, row + sizes[set], tag) != row + sizes[set];
+}
+
+bool GhostList::take(size_t set, uint64_t tag) {
+    uint64_t *row = &tags[set * capacity];
+    uint64_t *end = row + sizes[set];
+    uint64_t *it = std::find(row, end, tag);
+    if (it == end) return false;
+    std::copy(it + 1, end, it);
+    sizes[set]--;
+    return true;
+}
+
+void GhostList::dropOldest(size_t set) {
+    if (sizes[set] == 0) return;
+    uint64_t *row = &tags[set * capacity];
+    std::copy(row + 1, row + sizes[set], row);
+    sizes[set]--;
+}
+
+void GhostList::push(size_t set, uint64_t tag) {
+    if (sizes[set] == capacity) dropOldest(set);
+    tags[set * capacity + sizes[set]] = tag;
+    sizes[set]++;
+}
+
+// ======================== 2Q ========================
+
+void TwoQPolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    kin = std::max<size_t>(1, ways / 4);
+    in_am.assign(sets * ways, 0);
+    stamp.assign(sets * ways, 0);
+    set_clock.assign(sets, 0);
+    pending_am.assign(sets, 0);
+    a1out.resize(sets, std::max<size_t>(1, ways / 2));
+}
+
+void TwoQPolicy::reset() {
+    std::fill(in_am.begin(), in_am.end(), 0);
+    std::fill(stamp.begin(), stamp.end(), 0);
+    std::fill(set_clock.begin(), set_clock.end(), 0);
+    std::fill(pending_am.begin(), pending_am.end(), 0);
+    a1out.reset();
+}
+
+void TwoQPolicy::onFill(size_t set, size_t way, uint64_t) {
+    in_am[set * ways + way] = pending_am[set];
+    pending_am[set] = 0;
+    stamp[set * ways + way] = nextStamp(stamp, set_clock, set, ways);
+}
+
+void TwoQPolicy::onHit(size_t set, size_t way) {
+    // Hits em A1in não promovem (a linha pode ser só uma rajada correlacionada)
+    if (in_am[set * ways + way]) {
+        stamp[set * ways + way] = nextStamp(stamp, set_clock, set, ways);
+    }
+}
+
+void TwoQPolicy::onEvict(size_t set, size_t way, uint64_t tag) {
+    if (!in_am[set * ways + way]) a1out.push(set, tag);
+}
+
+size_t TwoQPolicy::victim(size_t set, const uint64_t *valid, uint64_t incomingTag) {
+    // Tag lembrada em A1out: a linha já mostrou reuso e entra em Am
+    pending_am[set] = a1out.take(set, incomingTag) ? 1 : 0;
+
+    size_t free = freeWay(valid, ways);
+    if (free < ways) return free;
+
+    const uint8_t *am = &in_am[set * ways];
+    const uint32_t *row = &stamp[set * ways];
+    size_t a1in_lines = static_cast<size_t>(std::count(am, am + ways, 0));
+    size_t chosen = ways;
+    if (a1in_lines > kin || a1in_lines == ways) {
+        chosen = oldestWhere(row, ways, [am](size_t w) { return am[w] == 0; });
+    }
+    if (chosen == ways) chosen = oldestWhere(row, ways, [am](size_t w) { return am[w] != 0; });
+    if (chosen == ways) chosen = oldestWhere(row, ways, [](size_t) { return true; });
+    return chosen;
+}
+
+// ======================== ARC ========================
+
+void ArcPolicy::resize(size_t sets, size_t numWays) {
+    ways = numWays ? numWays : 1;
+    in_t2.assign(sets * ways, 0);
+    stamp.assign(sets * ways, 0);
+    set_clock.assign(sets, 0);
+    target_t1.assign(sets, 0);
+    pending_t2.assign(sets, 0);
+    b1.resize(sets, ways);
+    b2.resize(sets, ways);
+}
+
+void ArcPolicy::reset() {
+    std::fill(in_t2.begin(), in_t2.end(), 0);
+    std::fill(stamp.begin(), stamp.end(), 0);
+    std::fill(set_clock.begin(), set_clock.end(), 0);
+    std::fill(target_t1.begin(), target_t1.end(), 0);
+    std::fill(pending_t2.begin(), pending_t2.end(), 0);
+    b1.reset();
+    b2.reset();
+}
+
+void ArcPolicy::onFill(size_t set, size_t way, uint64_t) {
+    in_t2[set * ways + way] = pending_t2[set];
+    pending_t2[set] = 0;
+    stamp[set * ways + way] = nextStamp(stamp, set_clock, set, ways);
+}
+
+void ArcPolicy::onHit(size_t set, size_t way) {
+    // Segundo acesso: a linha passa (ou volta) ao topo de T2
+    in_t2[set * ways + way] = 1;
+    stamp[set * ways + way] = nextStamp(stamp, set_clock, set, ways);
+}
+
+void ArcPolicy::onEvict(size_t set, size_t way, uint64_t tag) {
+    if (in_t2[set * ways + way]) {
+        b2.push(set, tag);
+    } else {
+        b1.push(set, tag);
+    }
+}
+
+size_t ArcPolicy::victim(size_t set, const uint64_t *valid, uint64_t incomingTag) {
+    // Adaptação: hit fantasma em B1 pede mais espaço para recência (p sobe),
+    // em B2 mais espaço para frequência (p desce)
+    uint32_t &p = target_t1[set];
+    bool ghost_b2 = false;
+    if (b1.contains(set, incomingTag)) {
+        size_t delta = std::max<size_t>(1, b2.size(set) / std::max<size_t>(1, b1.size(set)));
+        p = static_cast<uint32_t>(std::min(ways, p + delta));
+        b1.take(set, incomingTag);
+        pending_t2[set] = 1;
+    } else if (b2.contains(set, incomingTag)) {
+        size_t delta = std::max<size_t>(1, b1.size(set) / std::max<size_t>(1, b2.size(set)));
+        p = static_cast<uint32_t>(p > delta ? p - delta : 0);
+        b2.take(set, incomingTag);
+        pending_t2[set] = 1;
+        ghost_b2 = true;
+    } else {
+        pending_t2[set] = 0;
+    }
+
+    size_t free = freeWay(valid, ways);
+    if (free < ways) return free;
+
+    // REPLACE: sai a LRU de T1 se T1 passou do alvo p, senão a LRU de T2
+    const uint8_t *t2 = &in_t2[set * ways];
+    const uint32_t *row = &stamp[set * ways];
+    size_t t1_lines = static_cast<size_t>(std::count(t2, t2 + ways, 0));
+    size_t chosen = ways;
+    if (t1_lines > 0 && (t1_lines > p || (ghost_b2 && t1_lines == p))) {
+        chosen = oldestWhere(row, ways, [t2](size_t w) { return t2[w] == 0; });
+    }
+    if (chosen == ways) chosen = oldestWhere(row, ways, [t2](size_t w) { return t2[w] != 0; });
+    if (chosen == ways) chosen = oldestWhere(row, ways, [](size_t) { return true; });
+    return chosen;
+}
@@ -0,0 +1,168 @@
+#ifndef REPLACEMENT_POLICIES_HPP
+#define REPLACEMENT_POLICIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Implementações das políticas de substituição de uma cache associativa por
+// conjuntos. Todas seguem a mesma interface (resolvida em tempo de compilação
+// pelo CachePolicy, que escolhe a implementação em tempo de execução):
+//
+//   void   resize(size_t sets, size_t ways);   // zera todo o estado
+//   void   reset();
+//   void   onFill(size_t set, size_t way, uint64_t tag);  // linha nova na via
+//   void   onHit(size_t set, size_t way);
+//   void   onEvict(size_t set, size_t way, uint64_t tag); // vítima válida expulsa
+//   size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+//
+// `valid` aponta para as `ways` máscaras de validade do conjunto (0 = livre);
+// toda política escolhe primeiro uma via livre. O estado é por conjunto, então
+// conjuntos de shards diferentes podem ser atualizados em paralelo.
+
+// FIFO e LRU: idade por linha = relógio do conjunto no preenchimento (FIFO)
+// ou no último acesso (LRU); a vítima é a de menor idade.
+class AgePolicy {
+private:
+    bool lru;
+    size_t ways = 1;
+    std::vector<uint32_t> age;        // idade por linha (sets * ways)
+    std::vector<uint32_t> set_clock;  // relógio por conjunto
+
+    // Avança o relógio do conjunto, renormalizando as idades antes do overflow
+    uint32_t tick(size_t set);
+
+public:
+    explicit AgePolicy(bool lru = false) : lru(lru) {}
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t, size_t, uint64_t) {}
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+// CLOCK (segunda chance): bit de referência por linha e um ponteiro por
+// conjunto que limpa bits até achar uma linha não referenciada.
+class ClockPolicy {
+private:
+    size_t ways = 1;
+    std::vector<uint8_t> referenced;
+    std::vector<uint32_t> hand;
+
+public:
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t, size_t, uint64_t) {}
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+// LFU com envelhecimento: contador de acessos por linha; a cada AGING_PERIOD
+// acessos ao conjunto todos os contadores são divididos por 2, para que linhas
+// quentes no passado não fiquem presas. Empate: a linha preenchida há mais tempo.
+class LfuPolicy {
+private:
+    size_t ways = 1;
+    std::vector<uint32_t> count;
+    std::vector<uint32_t> filled_at;     // ordem de preenchimento (desempate)
+    std::vector<uint32_t> set_accesses;  // acessos desde o último envelhecimento
+    std::vector<uint32_t> set_clock;
+
+    void access(size_t set);
+
+public:
+    static constexpr uint32_t AGING_PERIOD_PER_WAY = 8;
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t, size_t, uint64_t) {}
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+// SRRIP (Jaleel et al., 2010) com RRPV de 2 bits: inserção com "reuso
+// distante" (2), hit volta a 0; a vítima é a primeira via com RRPV 3,
+// envelhecendo o conjunto inteiro até existir uma.
+class SrripPolicy {
+private:
+    size_t ways = 1;
+    std::vector<uint8_t> rrpv;
+
+public:
+    static constexpr uint8_t MAX_RRPV = 3;
+    static constexpr uint8_t INSERT_RRPV = 2;
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t, size_t, uint64_t) {}
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+// Lista fantasma por conjunto: tags de linhas expulsas, da mais antiga para a
+// mais recente, com capacidade fixa (a mais antiga sai quando enche).
+class GhostList {
+private:
+    size_t capacity = 1;
+    std::vector<uint64_t> tags;   // sets * capacity
+    std::vector<uint32_t> sizes;  // tamanho por conjunto
+
+public:
+    void resize(size_t sets, size_t capacity);
+    void reset();
+    size_t size(size_t set) const { return sizes[set]; }
+    // Remove a tag se presente; devolve se estava na lista
+    bool take(size_t set, uint64_t tag);
+    bool contains(size_t set, uint64_t tag) const;
+    void push(size_t set, uint64_t tag);
+    void dropOldest(size_t set);
+};
+
+// 2Q (Johnson & Shasha, 1994) por conjunto: linhas novas entram na fila A1in
+// (FIFO); uma linha cuja tag ainda está no fantasma A1out (expulsa de A1in
+// recentemente) entra direto em Am (LRU). A1in é esvaziada primeiro quando
+// passa de KIN linhas; senão sai a menos recente de Am.
+class TwoQPolicy {
+private:
+    size_t ways = 1;
+    size_t kin = 1;
+    std::vector<uint8_t> in_am;       // 1 = linha em Am, 0 = em A1in
+    std::vector<uint32_t> stamp;      // ordem de entrada (A1in) ou de uso (Am)
+    std::vector<uint32_t> set_clock;
+    std::vector<uint8_t> pending_am;  // próxima linha preenchida vai para Am
+    GhostList a1out;
+
+public:
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t set, size_t way, uint64_t tag);
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+// ARC (Megiddo & Modha, 2003) por conjunto, com c = vias: T1 guarda linhas
+// vistas uma vez, T2 as reutilizadas; os fantasmas B1/B2 lembram as tags
+// expulsas de cada uma e ajustam o alvo adaptativo p de |T1|.
+class ArcPolicy {
+private:
+    size_t ways = 1;
+    std::vector<uint8_t> in_t2;
+    std::vector<uint32_t> stamp;       // último uso (LRU dentro de T1/T2)
+    std::vector<uint32_t> set_clock;
+    std::vector<uint32_t> target_t1;   // p
+    std::vector<uint8_t> pending_t2;   // próxima linha preenchida vai para T2
+    GhostList b1, b2;
+
+public:
+    void resize(size_t sets, size_t ways);
+    void reset();
+    void onFill(size_t set, size_t way, uint64_t tag);
+    void onHit(size_t set, size_t way);
+    void onEvict(size_t set, size_t way, uint64_t tag);
+    size_t victim(size_t set, const uint64_t *valid, uint64_t incomingTag);
+};
+
+#endif
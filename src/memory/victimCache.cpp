@@ -0,0 +1,88 @@
+#include "victimCache.hpp"
+
+#include <algorithm>
+
+VictimCache::VictimCache(size_t lines, size_t lineSize) {
+    configure(lines, lineSize);
+}
+
+void VictimCache::configure(size_t lines, size_t lineSize) {
+    std::lock_guard<std::mutex> guard(lock);
+    capacity = lines;
+    line_size = lineSize ? lineSize : 1;
+    entries.assign(capacity, Entry{});
+    data.assign(capacity * line_size, 0);
+    clock = 0;
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+}
+
+long VictimCache::find(size_t base) const {
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].valid && entries[i].base == base) return static_cast<long>(i);
+    }
+    return -1;
+}
+
+void VictimCache::insert(size_t base, const uint32_t *words, Mesi state) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (capacity == 0) return;
+
+    // A mesma linha já presente é substituída pela versão mais nova
+    long slot = find(base);
+    if (slot < 0) {
+        auto free = std::find_if(entries.begin(), entries.end(), [](const Entry &e) { return !e.valid; });
+        if (free == entries.end()) {
+            free = std::min_element(entries.begin(), entries.end(),
+                                    [](const Entry &a, const Entry &b) { return a.inserted < b.inserted; });
+        }
+        slot = static_cast<long>(free - entries.begin());
+    }
+
+    Entry &entry = entries[static_cast<size_t>(slot)];
+    entry.valid = true;
+    entry.base = base;
+    entry.state = state;
+    entry.inserted = ++clock;
+    std::copy_n(words, line_size, &data[static_cast<size_t>(slot) * line_size]);
+}
+
+bool VictimCache::take(size_t base, uint32_t *out, Mesi &state) {
+    std::lock_guard<std::mutex> guard(lock);
+    long slot = find(base);
+    if (slot < 0) {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    Entry &entry = entries[static_cast<size_t>(slot)];
+    state = entry.state;
+    std::copy_n(&data[static_cast<size_t>(slot) * line_size], line_size, out);
+    entry.valid = false;
+    return true;
+}
+
+Mesi VictimCache::snoop(size_t base, bool invalidate) {
+    std::lock_guard<std::mutex> guard(lock);
+    long slot = find(base);
+    if (slot < 0) return Mesi::Invalid;
+    Entry &entry = entries[static_cast<size_t>(slot)];
+    Mesi previous = entry.state;
+    if (invalidate) {
+        entry.valid = false;
+    } else {
+        entry.state = Mesi::Shared;
+    }
+    return previous;
+}
+
+void VictimCache::invalidate() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto &entry : entries) entry.valid = false;
+}
+
+void VictimCache::reset() {
+    invalidate();
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,59 @@
+#ifndef VICTIM_CACHE_HPP
+#define VICTIM_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "cache.hpp"
+
+// Victim cache de uma L1: poucas linhas, totalmente associativa, guardando as
+// linhas inteiras que a L1 expulsou. As palavras sujas já seguiram para a L2
+// na expulsão, então toda linha aqui é limpa (Exclusive ou Shared) e pode ser
+// descartada sem write-back. Um miss na L1 que acerta aqui devolve a linha à
+// L1 sem buscar na L2. Snoops de outros núcleos e back-invalidações da L2
+// também consultam a victim cache (tem trava própria).
+class VictimCache {
+public:
+    explicit VictimCache(size_t lines = 0, size_t lineSize = 16);
+
+    // Redefine o tamanho (0 = desligada); descarta o conteúdo e as estatísticas
+    void configure(size_t lines, size_t lineSize);
+    bool enabled() const { return capacity > 0; }
+    size_t lines() const { return capacity; }
+
+    // Linha expulsa da L1; substitui a mais antiga se estiver cheia
+    void insert(size_t base, const uint32_t *words, Mesi state);
+    // Remove a linha e copia os dados para `out` (hit); conta hit/miss
+    bool take(size_t base, uint32_t *out, Mesi &state);
+    // Outro núcleo pediu a linha: passa a Shared ou é removida. Devolve o
+    // estado anterior (Invalid se ausente)
+    Mesi snoop(size_t base, bool invalidate);
+    void invalidate();
+    void reset();  // conteúdo + estatísticas
+
+    uint64_t get_hits() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t get_misses() const { return misses.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        bool valid = false;
+        size_t base = 0;
+        Mesi state = Mesi::Invalid;
+        uint64_t inserted = 0;  // ordem de entrada (sai a mais antiga)
+    };
+
+    std::mutex lock;
+    size_t capacity = 0;
+    size_t line_size = 16;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> data;  // capacity * line_size
+    uint64_t clock = 0;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+    long find(size_t base) const;
+};
+
+#endif
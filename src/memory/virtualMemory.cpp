@@ -0,0 +1,237 @@
+#include "virtualMemory.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+struct PolicyName {
+    const char *name;
+    PageReplacement policy;
+};
+
+const PolicyName PAGE_POLICY_NAMES[] = {
+    {"clock", PageReplacement::Clock},
+    {"aging", PageReplacement::Aging},
+    {"wsclock", PageReplacement::WSClock},
+};
+
+} // namespace
+
+bool parsePageReplacement(const std::string &name, PageReplacement &out) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    lower.erase(std::remove(lower.begin(), lower.end(), '-'), lower.end());
+    if (lower == "lru" || lower == "lruapprox") lower = "aging";
+    for (const auto &entry : PAGE_POLICY_NAMES) {
+        if (lower == entry.name) {
+            out = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* pageReplacementName(PageReplacement policy) {
+    for (const auto &entry : PAGE_POLICY_NAMES) {
+        if (entry.policy == policy) return entry.name;
+    }
+    return "?";
+}
+
+void VirtualMemory::configure(const PageConfig &config, size_t cores) {
+    cfg = config;
+    tlbs.assign(std::max<size_t>(cores, 1), Tlb{});
+    reset();
+}
+
+void VirtualMemory::reset() {
+    frames = std::vector<Frame>(cfg.frames);
+    table.clear();
+    for (auto &tlb : tlbs) {
+        tlb.entries.assign(cfg.tlb_entries, TlbEntry{});
+        tlb.clock = 0;
+        tlb.hits = 0;
+        tlb.misses = 0;
+    }
+    hand = 0;
+    references.store(0, std::memory_order_relaxed);
+    faults = evictions = dirty_writebacks = shootdowns = 0;
+    walk_cycles.store(0, std::memory_order_relaxed);
+    fault_cycles.store(0, std::memory_order_relaxed);
+}
+
+VirtualMemory::Lookup VirtualMemory::lookup(size_t core, uint32_t vpn, bool write, uint32_t &frame) {
+    references.fetch_add(1, std::memory_order_relaxed);
+    Tlb &tlb = tlbs[core];
+    ++tlb.clock;
+
+    Lookup result = Lookup::TlbHit;
+    auto hit = std::find_if(tlb.entries.begin(), tlb.entries.end(),
+                            [&](const TlbEntry &e) { return e.valid && e.vpn == vpn; });
+    if (hit != tlb.entries.end()) {
+        tlb.hits++;
+        hit->last_use = tlb.clock;
+        frame = hit->frame;
+    } else {
+        tlb.misses++;
+        // Percurso na tabela de páginas (um nível)
+        if (vpn >= table.size() || table[vpn] < 0) return Lookup::Fault;
+        frame = static_cast<uint32_t>(table[vpn]);
+        fillTlb(tlb, vpn, frame);
+        result = Lookup::Walk;
+    }
+    Frame &f = frames[frame];
+    f.referenced.store(true, std::memory_order_relaxed);
+    if (write) f.dirty.store(true, std::memory_order_relaxed);
+    return result;
+}
+
+bool VirtualMemory::refill(size_t core, uint32_t vpn, bool write, uint32_t &frame) {
+    if (vpn >= table.size() || table[vpn] < 0) return false;
+    frame = static_cast<uint32_t>(table[vpn]);
+    fillTlb(tlbs[core], vpn, frame);
+    Frame &f = frames[frame];
+    f.referenced = true;
+    if (write) f.dirty = true;
+    return true;
+}
+
+void VirtualMemory::fillTlb(Tlb &tlb, uint32_t vpn, uint32_t frame) {
+    // Entrada livre ou a menos usada recentemente
+    auto slot = std::min_element(tlb.entries.begin(), tlb.entries.end(), [](const TlbEntry &a, const TlbEntry &b) {
+        if (a.valid != b.valid) return !a.valid;
+        return a.last_use < b.last_use;
+    });
+    *slot = TlbEntry{true, vpn, frame, tlb.clock};
+}
+
+uint32_t VirtualMemory::fault(size_t core, uint32_t vpn, bool write, Eviction &victim) {
+    faults++;
+    victim = Eviction{};
+
+    // Quadro livre, ou uma vítima escolhida pela política
+    auto free_frame = std::find_if(frames.begin(), frames.end(), [](const Frame &f) { return !f.used; });
+    size_t index = (free_frame != frames.end()) ? static_cast<size_t>(free_frame - frames.begin()) : chooseVictim();
+    Frame &f = frames[index];
+
+    if (f.used) {
+        victim = Eviction{true, f.vpn, f.dirty};
+        evictions++;
+        if (f.dirty) dirty_writebacks++;
+        table[f.vpn] = -1;
+        // Shootdown: a tradução antiga sai de todas as TLBs
+        for (auto &tlb : tlbs) {
+            for (auto &entry : tlb.entries) {
+                if (entry.valid && entry.vpn == f.vpn) {
+                    entry.valid = false;
+                    shootdowns++;
+                }
+            }
+        }
+    }
+
+    if (vpn >= table.size()) table.resize(static_cast<size_t>(vpn) + 1, -1);
+    table[vpn] = static_cast<int32_t>(index);
+    f.used = true;
+    f.vpn = vpn;
+    f.referenced = true;
+    f.dirty = write;
+    f.age = 0;
+    f.last_use = references.load(std::memory_order_relaxed);
+    Tlb &tlb = tlbs[core];
+    fillTlb(tlb, vpn, static_cast<uint32_t>(index));
+    return static_cast<uint32_t>(index);
+}
+
+size_t VirtualMemory::chooseVictim() {
+    switch (cfg.replacement) {
+        case PageReplacement::Aging:
+            return agingVictim();
+        case PageReplacement::WSClock:
+            return wsclockVictim();
+        case PageReplacement::Clock:
+        default:
+            return clockVictim();
+    }
+}
+
+size_t VirtualMemory::clockVictim() {
+    // Segunda chance: no máximo uma volta limpando R antes de achar R = 0
+    while (true) {
+        Frame &f = frames[hand];
+        size_t current = hand;
+        hand = (hand + 1) % frames.size();
+        if (!f.referenced) return current;
+        f.referenced = false;
+    }
+}
+
+size_t VirtualMemory::agingVictim() {
+    // Um tique por falta: R entra no bit mais alto do contador
+    for (auto &f : frames) {
+        f.age = static_cast<uint8_t>((f.age >> 1) | (f.referenced ? 0x80 : 0));
+        f.referenced = false;
+    }
+    auto oldest = std::min_element(frames.begin(), frames.end(),
+                                   [](const Frame &a, const Frame &b) { return a.age < b.age; });
+    return static_cast<size_t>(oldest - frames.begin());
+}
+
+size_t VirtualMemory::wsclockVictim() {
+    const uint64_t now = references.load(std::memory_order_relaxed);
+    // Primeira volta: página limpa fora do conjunto de trabalho. As sujas
+    // antigas seriam agendadas para escrita; a primeira delas é a reserva.
+    long dirty_old = -1;
+    for (size_t step = 0; step < frames.size(); ++step) {
+        Frame &f = frames[hand];
+        size_t current = hand;
+        hand = (hand + 1) % frames.size();
+        if (f.referenced) {
+            f.referenced = false;
+            f.last_use = now;
+            continue;
+        }
+        if (now - f.last_use > cfg.wsclock_tau) {
+            if (!f.dirty) return current;
+            if (dirty_old < 0) dirty_old = static_cast<long>(current);
+        }
+    }
+    if (dirty_old >= 0) return static_cast<size_t>(dirty_old);
+    // Todas no conjunto de trabalho: a de uso mais antigo
+    auto oldest = std::min_element(frames.begin(), frames.end(),
+                                   [](const Frame &a, const Frame &b) { return a.last_use < b.last_use; });
+    return static_cast<size_t>(oldest - frames.begin());
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> VirtualMemory::dirtyFrames(bool clean) {
+    std::vector<std::pair<uint32_t, uint32_t>> dirty;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!frames[i].used || !frames[i].dirty) continue;
+        dirty.emplace_back(static_cast<uint32_t>(i), frames[i].vpn);
+        if (clean) {
+            frames[i].dirty = false;
+            dirty_writebacks++;
+        }
+    }
+    return dirty;
+}
+
+long VirtualMemory::residentFrame(uint32_t vpn) const {
+    return (vpn < table.size()) ? table[vpn] : -1;
+}
+
+PagingStats VirtualMemory::stats() const {
+    PagingStats stats;
+    for (const auto &tlb : tlbs) {
+        stats.tlb_hits += tlb.hits;
+        stats.tlb_misses += tlb.misses;
+    }
+    stats.faults = faults;
+    stats.evictions = evictions;
+    stats.dirty_writebacks = dirty_writebacks;
+    stats.shootdowns = shootdowns;
+    stats.walk_cycles = walk_cycles.load(std::memory_order_relaxed);
+    stats.fault_cycles = fault_cycles.load(std::memory_order_relaxed);
+    return stats;
+}
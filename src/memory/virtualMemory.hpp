@@ -0,0 +1,144 @@
+#ifndef VIRTUAL_MEMORY_HPP
+#define VIRTUAL_MEMORY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Substituição de páginas quando não há quadro livre (--page-replacement)
+enum class PageReplacement {
+    Clock,   // segunda chance: o ponteiro limpa R até achar uma página com R = 0
+    Aging,   // aproximação de LRU: contador de 8 bits deslocado a cada falta
+    WSClock  // Clock com conjunto de trabalho: prefere páginas limpas fora da janela tau
+};
+// Converte o nome ("clock", "aging", "wsclock"); false se desconhecido
+bool parsePageReplacement(const std::string &name, PageReplacement &out);
+const char* pageReplacementName(PageReplacement policy);
+
+// Paginação (--frames, --page-size, --tlb, --page-replacement); 0 quadros = desligada
+struct PageConfig {
+    static constexpr size_t MAX_TLB = 256;
+
+    size_t frames = 0;          // quadros da memória principal
+    size_t page_size = 256;     // endereços por página (potência de 2, múltiplo da linha)
+    size_t tlb_entries = 16;    // entradas da TLB de cada núcleo
+    PageReplacement replacement = PageReplacement::Clock;
+    uint64_t wsclock_tau = 2048; // janela do WSClock, em referências traduzidas
+
+    bool enabled() const { return frames > 0; }
+    bool valid() const {
+        return page_size >= 1 && (page_size & (page_size - 1)) == 0 && tlb_entries >= 1 &&
+               tlb_entries <= MAX_TLB && wsclock_tau >= 1;
+    }
+};
+
+// Contadores da paginação ao fim da execução
+struct PagingStats {
+    uint64_t tlb_hits = 0;
+    uint64_t tlb_misses = 0;         // cada miss percorre a tabela de páginas
+    uint64_t faults = 0;             // faltas de página (página trazida da memória secundária)
+    uint64_t evictions = 0;          // páginas retiradas de um quadro
+    uint64_t dirty_writebacks = 0;   // páginas sujas escritas na memória secundária
+    uint64_t shootdowns = 0;         // entradas removidas de TLBs por uma expulsão
+    uint64_t walk_cycles = 0;        // ciclos dos percursos na tabela
+    uint64_t fault_cycles = 0;       // ciclos das faltas (leitura + escrita da vítima)
+};
+
+// Estado da memória virtual paginada: uma tabela de páginas única, uma TLB
+// por núcleo e a tabela de quadros com os bits R/D usados pela substituição.
+// Só faz a contabilidade: quem move os dados entre a memória secundária e os
+// quadros é o MemoryManager.
+// - O espaço virtual é o layout compartilhado dos processos (base_address) e
+//   a memória secundária guarda uma cópia de cada página: a tabela é global,
+//   para que dois processos que usam o mesmo endereço vejam o mesmo quadro.
+// - lookup() pode rodar em paralelo em núcleos diferentes (cada núcleo só
+//   mexe na própria TLB; R/D são atômicos); fault(), refill(), dirtyFrames()
+//   e reset() exigem exclusão de todos os outros acessos.
+// - Com uma tradução só, a TLB é indexada apenas pela página: a troca de
+//   contexto não a esvazia e o processo seguinte aproveita as entradas.
+class VirtualMemory {
+public:
+    enum class Lookup {
+        TlbHit,  // tradução na TLB
+        Walk,    // miss na TLB, página presente na tabela (TLB preenchida)
+        Fault    // página ausente: chamar fault()
+    };
+
+    // Página retirada de um quadro por fault()
+    struct Eviction {
+        bool valid = false;
+        uint32_t vpn = 0;
+        bool dirty = false;
+    };
+
+    void configure(const PageConfig &config, size_t cores);
+    const PageConfig& config() const { return cfg; }
+    bool enabled() const { return cfg.enabled(); }
+    void reset();
+
+    // Traduz a página `vpn` no núcleo; marca R (e D na escrita). Em
+    // TlbHit/Walk, `frame` recebe o quadro.
+    Lookup lookup(size_t core, uint32_t vpn, bool write, uint32_t &frame);
+    // Depois de um lookup() com Fault, já sob exclusão: se outro núcleo trouxe
+    // a página nesse meio-tempo, preenche a TLB, marca R/D e devolve true
+    bool refill(size_t core, uint32_t vpn, bool write, uint32_t &frame);
+    // Falta de página: escolhe um quadro (livre ou vítima, com shootdown nas
+    // TLBs), mapeia a página nele e a coloca na TLB do núcleo
+    uint32_t fault(size_t core, uint32_t vpn, bool write, Eviction &victim);
+    // Quadros com página suja (pares quadro, vpn); com `clean`, zera o bit D
+    std::vector<std::pair<uint32_t, uint32_t>> dirtyFrames(bool clean);
+    // Quadro onde a página `vpn` está, ou -1
+    long residentFrame(uint32_t vpn) const;
+
+    PagingStats stats() const;
+    // Percurso e falta cobrados (acumulados nas estatísticas)
+    void chargeWalk(uint64_t cycles) { walk_cycles.fetch_add(cycles, std::memory_order_relaxed); }
+    void chargeFault(uint64_t cycles) { fault_cycles.fetch_add(cycles, std::memory_order_relaxed); }
+
+private:
+    // R e D são marcados por lookup() de vários núcleos ao mesmo tempo
+    struct Frame {
+        bool used = false;
+        uint32_t vpn = 0;
+        std::atomic<bool> referenced{false};
+        std::atomic<bool> dirty{false};
+        uint8_t age = 0;         // Aging
+        uint64_t last_use = 0;   // WSClock (tempo virtual)
+    };
+    struct TlbEntry {
+        bool valid = false;
+        uint32_t vpn = 0;
+        uint32_t frame = 0;
+        uint64_t last_use = 0;   // LRU dentro da TLB
+    };
+    // TLB de um núcleo; alinhada para não dividir linha do host
+    struct alignas(64) Tlb {
+        std::vector<TlbEntry> entries;
+        uint64_t clock = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    PageConfig cfg;
+    std::vector<Frame> frames;
+    std::vector<int32_t> table;                            // vpn -> quadro (-1 = ausente)
+    std::vector<Tlb> tlbs;
+    size_t hand = 0;                                       // ponteiro do Clock/WSClock
+    std::atomic<uint64_t> references{0};                   // tempo virtual (traduções)
+    uint64_t faults = 0;
+    uint64_t evictions = 0;
+    uint64_t dirty_writebacks = 0;
+    uint64_t shootdowns = 0;
+    std::atomic<uint64_t> walk_cycles{0};
+    std::atomic<uint64_t> fault_cycles{0};
+
+    void fillTlb(Tlb &tlb, uint32_t vpn, uint32_t frame);
+    size_t chooseVictim();
+    size_t clockVictim();
+    size_t agingVictim();
+    size_t wsclockVictim();
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "writeBuffer.hpp"
+
+#include <algorithm>
+
+void WriteBuffer::configure(size_t entries) {
+    capacity = entries;
+    queue.clear();
+    queue.reserve(capacity);
+}
+
+void WriteBuffer::reset() {
+    queue.clear();
+}
+
+void WriteBuffer::retire(uint64_t now) {
+    auto done = std::find_if(queue.begin(), queue.end(), [now](const Entry &e) { return e.done_at > now; });
+    queue.erase(queue.begin(), done);
+}
+
+uint64_t WriteBuffer::push(size_t base, uint64_t now, uint64_t cost, bool &coalesced) {
+    retire(now);
+    coalesced = std::any_of(queue.begin(), queue.end(), [base](const Entry &e) { return e.base == base; });
+    if (coalesced) return 0;
+
+    uint64_t stall = 0;
+    if (queue.size() >= capacity) {
+        stall = queue.front().done_at - now;
+        now += stall;
+        retire(now);
+    }
+    uint64_t start = queue.empty() ? now : std::max(now, queue.back().done_at);
+    queue.push_back(Entry{base, start + cost});
+    return stall;
+}
+
+bool WriteBuffer::pending(size_t base, uint64_t now) {
+    retire(now);
+    return std::any_of(queue.begin(), queue.end(), [base](const Entry &e) { return e.base == base; });
+}
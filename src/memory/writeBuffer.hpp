@@ -0,0 +1,44 @@
+#ifndef WRITE_BUFFER_HPP
+#define WRITE_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Buffer de escrita entre a L2 e a memória, por núcleo. Modela só o tempo:
+// a linha suja expulsa já foi escrita na memória (o conteúdo funcional não
+// muda), e o buffer registra quando essa escrita termina no relógio do núcleo.
+// - As escritas drenam uma de cada vez, em segundo plano.
+// - Uma linha ainda pendente coalesce novas escritas e pode servir leituras.
+// - Com o buffer cheio, o núcleo espera a escrita mais antiga terminar.
+// Não é thread-safe: só o núcleo dono o usa.
+class WriteBuffer {
+public:
+    explicit WriteBuffer(size_t entries = 0) { configure(entries); }
+
+    // Número de entradas (0 = desligado: o write-back é síncrono)
+    void configure(size_t entries);
+    bool enabled() const { return capacity > 0; }
+    size_t entries() const { return capacity; }
+    void reset();
+
+    // Enfileira a escrita da linha em `now`, com `cost` ciclos de memória.
+    // Devolve os ciclos de espera (buffer cheio); `coalesced` indica que a
+    // linha já estava pendente e a escrita foi absorvida.
+    uint64_t push(size_t base, uint64_t now, uint64_t cost, bool &coalesced);
+    // A linha ainda está no buffer em `now`
+    bool pending(size_t base, uint64_t now);
+
+private:
+    struct Entry {
+        size_t base;
+        uint64_t done_at;  // instante em que a escrita termina
+    };
+    size_t capacity = 0;
+    std::vector<Entry> queue;  // em ordem de término
+
+    // Remove as escritas terminadas até `now`
+    void retire(uint64_t now);
+};
+
+#endif
@@ -1,6 +1,8 @@
 #include "parser_json.hpp"
 #include "../memory/MemoryManager.hpp" // Alterado de MainMemory.hpp
 #include "../cpu/PCB.hpp"              // Incluído para a função write
+#include "../cpu/CONTROL_UNIT.hpp"     // Control_Unit::Predecode (superinstruções)
+#include "../cpu/BlockEngine.hpp"      // DiscoverBlocks
 #include <unordered_map>
 #include <fstream>
 #include <algorithm>
@@ -324,6 +326,8 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
 
     int current_mem_addr = startAddr;
     int current_instruction_addr = 0;
+    vector<uint32_t> program_words;
+    vector<MicroOp> decoded_program;
     for (const auto &node : programJson) {
         if (!node.contains("instruction")) {
             continue;
@@ -333,6 +337,8 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
         
         // Escrever diretamente na memória principal (não apenas cache)
         memManager.writeToFile(current_mem_addr, binary_instruction);
+        program_words.push_back(binary_instruction);
+        decoded_program.push_back(Control_Unit::Predecode(binary_instruction));
         
         current_mem_addr += 4;
         current_instruction_addr++;
@@ -341,8 +347,21 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
     // ADICIONA INSTRUÇÃO END AUTOMATICAMENTE AO FINAL
     uint32_t end_instruction = 0xFC000000; // Opcode END = 111111 (6 bits mais significativos)
     memManager.writeToFile(current_mem_addr, end_instruction);
+    program_words.push_back(end_instruction);
+    decoded_program.push_back(Control_Unit::Predecode(end_instruction));
     current_mem_addr += 4;
 
+    // A faixa de código do processo define quais PCs a cache de decodificação cobre
+    pcb.decode_cache.configure(static_cast<uint32_t>(startAddr), static_cast<uint32_t>(current_mem_addr));
+
+    // Passada de fusão sobre o programa pré-decodificado (modo funcional)
+    pcb.fusion_table.configure(static_cast<uint32_t>(startAddr), static_cast<uint32_t>(current_mem_addr));
+    pcb.fusion_table.build(decoded_program);
+
+    // Descoberta e tradução dos blocos básicos (motor de blocos)
+    pcb.block_cache.configure(static_cast<uint32_t>(startAddr), static_cast<uint32_t>(current_mem_addr), program_words);
+    DiscoverBlocks(pcb.block_cache);
+
     return current_mem_addr;
 }
 
@@ -365,4 +384,43 @@ int loadJsonProgram(const string &filename, MemoryManager &memManager, PCB& pcb,
     if (j.contains("data"))    addr = parseData(j["data"], memManager, pcb, addr);
     if (j.contains("program")) addr = parseProgram(j["program"], memManager, pcb, addr);
     return addr;
+}
+
+// Palavras escritas por parseData (mesma regra de empacotamento dos bytes)
+static int dataWords(const json &dataJson){
+    int words = 0;
+    if (dataJson.is_object()){
+        for (auto it = dataJson.begin(); it != dataJson.end(); ++it){
+            words += it.value().is_array() ? static_cast<int>(it.value().size()) : 1;
+        }
+        return words;
+    }
+    if (dataJson.is_array()){
+        size_t bytes = 0;
+        for (const auto &item : dataJson){
+            string type = toLower(item.value("type","word"));
+            if (type=="word"){
+                words += static_cast<int>((bytes + 3) / 4);
+                bytes = 0;
+                words += item["value"].is_array() ? static_cast<int>(item["value"].size()) : 1;
+            } else if (type=="byte"){
+                bytes += item["value"].is_array() ? item["value"].size() : 1;
+            }
+        }
+        words += static_cast<int>((bytes + 3) / 4);
+    }
+    return words;
+}
+
+int jsonProgramSize(const string &filename){
+    json j = readJsonFile(filename);
+    int words = 0;
+    if (j.contains("data")) words += dataWords(j["data"]);
+    if (j.contains("program") && j["program"].is_array()) {
+        for (const auto &node : j["program"]) {
+            if (node.contains("instruction")) words++;
+        }
+        words++; // END
+    }
+    return words * 4;
 }
\ No newline at end of file
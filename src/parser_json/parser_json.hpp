@@ -13,6 +13,8 @@ using nlohmann::json;
 // ===== API principal =====
 // Agora recebe MemoryManager e PCB para carregar o programa
 int loadJsonProgram(const std::string &filename, MemoryManager &memManager, PCB& pcb, int startAddr);
+// Endereços que loadJsonProgram ocupará (seção data + programa + END), sem carregar
+int jsonProgramSize(const std::string &filename);
 
 // ===== Parsers de seção =====
 int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int startAddr);
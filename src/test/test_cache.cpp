@@ -0,0 +1,947 @@
+/*
+  test_cache.cpp
+  Teste da cache associativa por conjuntos (src/memory/cache.hpp): geometria
+  configurável, substituição por conjunto (FIFO, LRU, CLOCK, LFU, ARC, 2Q e
+  SRRIP), write-back de palavras sujas, linhas com setores, preenchimento em
+  rajada, prefetch (next-line, stride e stream), victim cache e buffer de
+  escrita, MSHRs, invalidação parcial e por ASID, flush das linhas sujas
+  em lotes, o modelo de tempo da memória secundária (em RAM ou num arquivo
+  mapeado), a memória virtual paginada (TLB, faltas e substituição de
+  páginas), a segmentação com descritores em cache, o alocador de memória
+  física (buddy, first-fit e best-fit) e a hierarquia L1 privada + L2
+  compartilhada com coerência MESI e as travas por shard com estatísticas
+  atômicas.
+*/
+#include <iostream>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "memory/cache.hpp"
+#include "memory/MemoryManager.hpp"
+#include "cpu/PCB.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void check(bool cond, const string &msg) {
+    if (cond) {
+        cout << "  -> SUCESSO: " << msg << "\n";
+    } else {
+        cout << "  -> FALHA: " << msg << "\n";
+        falhas++;
+    }
+}
+
+static CacheConfig geometry(size_t capacity, size_t ways, size_t line_size = 1) {
+    CacheConfig c;
+    c.capacity = capacity;
+    c.ways = ways;
+    c.line_size = line_size;
+    return c;
+}
+
+void geometryTest() {
+    cout << "\n=== Geometria ===\n";
+    CacheConfig full = geometry(64, 0);
+    check(full.sets() == 1 && full.associativity() == 64, "ways = 0 -> totalmente associativa");
+    CacheConfig fourWay = geometry(64, 4);
+    check(fourWay.sets() == 16 && fourWay.valid(), "64 palavras em 4 vias -> 16 conjuntos");
+    check(!geometry(64, 3).valid(), "capacidade nao multipla das vias e rejeitada");
+
+    bool threw = false;
+    try {
+        Cache invalid(ReplacementPolicy::FIFO, geometry(10, 0, 4));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    check(threw, "construtor lanca invalid_argument para geometria invalida");
+}
+
+void directMappedTest() {
+    cout << "\n=== Mapeamento direto ===\n";
+    Cache cache(ReplacementPolicy::FIFO, geometry(4, 1));
+    cache.put(0, 10, nullptr);
+    cache.put(4, 20, nullptr); // mesmo conjunto (4 % 4 == 0)
+    check(cache.get(0) == CACHE_MISS && cache.get(4) == 20, "enderecos conflitantes se substituem");
+    cache.put(1, 30, nullptr);
+    check(cache.get(1) == 30 && cache.get(4) == 20, "conjuntos diferentes nao interferem");
+}
+
+void replacementTest() {
+    cout << "\n=== Substituicao por conjunto ===\n";
+    // 4 palavras, 2 vias -> 2 conjuntos; 0, 2 e 4 caem no conjunto 0
+    Cache lru(ReplacementPolicy::LRU, geometry(4, 2));
+    lru.put(0, 1, nullptr);
+    lru.put(2, 2, nullptr);
+    lru.get(0);
+    lru.put(4, 3, nullptr);
+    check(lru.get(0) == 1 && lru.get(2) == CACHE_MISS, "LRU remove o menos recentemente usado");
+
+    Cache fifo(ReplacementPolicy::FIFO, geometry(4, 2));
+    fifo.put(0, 1, nullptr);
+    fifo.put(2, 2, nullptr);
+    fifo.get(0);
+    fifo.put(4, 3, nullptr);
+    check(fifo.get(0) == CACHE_MISS && fifo.get(2) == 2, "FIFO remove o mais antigo mesmo apos hit");
+    check(fifo.get_hits() == 2 && fifo.get_misses() == 1, "estatisticas de hits/misses");
+}
+
+// Cache de um único conjunto com 4 vias: o endereço é a própria tag
+static Cache singleSet(ReplacementPolicy p) {
+    return Cache(p, geometry(4, 4));
+}
+
+void policiesTest() {
+    cout << "\n=== Politicas plugaveis ===\n";
+    ReplacementPolicy parsed = ReplacementPolicy::FIFO;
+    check(parseReplacementPolicy("two_q", parsed) && parsed == ReplacementPolicy::TWO_Q &&
+          parseReplacementPolicy("srrip", parsed) && parsed == ReplacementPolicy::SRRIP &&
+          !parseReplacementPolicy("MRU", parsed),
+          "nomes de politica aceitos sem diferenciar maiusculas");
+    check(string(replacementPolicyName(ReplacementPolicy::TWO_Q)) == "2Q", "nome canonico do 2Q");
+
+    // CLOCK: a primeira volta limpa todos os bits; depois, a linha
+    // referenciada ganha segunda chance e sai a seguinte
+    Cache clock = singleSet(ReplacementPolicy::CLOCK);
+    for (size_t a = 0; a < 4; ++a) clock.put(a, a + 1, nullptr);
+    clock.put(4, 5, nullptr);
+    clock.get(1);
+    clock.put(5, 6, nullptr);
+    check(clock.get(0) == CACHE_MISS && clock.get(2) == CACHE_MISS && clock.get(1) == 2,
+          "CLOCK da segunda chance a linha referenciada");
+
+    // LFU: sai a linha com menos acessos, mesmo sendo a mais recente
+    Cache lfu = singleSet(ReplacementPolicy::LFU);
+    for (size_t a = 0; a < 4; ++a) lfu.put(a, a + 1, nullptr);
+    for (int i = 0; i < 3; ++i) lfu.get(0);
+    for (int i = 0; i < 2; ++i) lfu.get(1);
+    lfu.get(3);
+    lfu.put(4, 5, nullptr);
+    check(lfu.get(2) == CACHE_MISS && lfu.get(0) == 1 && lfu.get(3) == 4, "LFU remove o menos frequente");
+
+    // Três linhas quentes intercaladas com varreduras de duas linhas novas:
+    // LRU perde as quentes, SRRIP e ARC as mantêm
+    auto hotSurvivesScan = [](ReplacementPolicy p) {
+        Cache cache = singleSet(p);
+        for (size_t a = 0; a < 3; ++a) cache.put(a, a + 1, nullptr);
+        for (size_t a = 0; a < 3; ++a) cache.get(a);
+        bool kept = true;
+        for (size_t round = 0; round < 4; ++round) {
+            cache.put(100 + 2 * round, 7, nullptr);
+            cache.put(101 + 2 * round, 7, nullptr);
+            for (size_t a = 0; a < 3; ++a) kept = kept && cache.get(a) == a + 1;
+        }
+        return kept;
+    };
+    check(!hotSurvivesScan(ReplacementPolicy::LRU), "LRU perde as linhas quentes na varredura");
+    check(hotSurvivesScan(ReplacementPolicy::SRRIP), "SRRIP resiste a varredura");
+    check(hotSurvivesScan(ReplacementPolicy::ARC), "ARC protege as linhas reutilizadas (T2)");
+
+    // 2Q: a linha que volta logo depois de sair de A1in entra em Am e
+    // sobrevive a uma varredura longa
+    Cache twoQ = singleSet(ReplacementPolicy::TWO_Q);
+    for (size_t a = 0; a < 5; ++a) twoQ.put(a, a + 1, nullptr); // 0 sai de A1in para A1out
+    twoQ.put(0, 1, nullptr);
+    for (size_t a = 10; a < 20; ++a) twoQ.put(a, 7, nullptr);
+    check(twoQ.get(0) == 1, "2Q promove a linha lembrada em A1out para Am");
+
+    // Troca de politica em tempo de execucao mantem a cache utilizavel
+    Cache swapped = singleSet(ReplacementPolicy::FIFO);
+    swapped.setPolicy(ReplacementPolicy::ARC);
+    for (size_t a = 0; a < 8; ++a) swapped.put(a, a + 1, nullptr);
+    check(swapped.getPolicy() == ReplacementPolicy::ARC && swapped.get(7) == 8, "setPolicy troca a implementacao");
+}
+
+void writeBackTest() {
+    cout << "\n=== Write-back ===\n";
+    MemoryManager mem(1024, 1024);
+    PCB pcb;
+    Cache cache(ReplacementPolicy::FIFO, geometry(2, 1));
+    cache.put(0, 5, &mem);
+    cache.update(0, 99);
+    check(cache.dirtyData().size() == 1, "palavra atualizada fica suja");
+    cache.put(2, 7, &mem); // expulsa a linha suja do conjunto 0
+    check(mem.read(0, pcb) == 99, "linha suja e escrita de volta ao ser substituida");
+}
+
+void sectorTest() {
+    cout << "\n=== Linhas com setores ===\n";
+    Cache cache(ReplacementPolicy::FIFO, geometry(16, 2, 4));
+    cache.put(5, 50, nullptr);
+    check(cache.get(5) == 50, "palavra preenchida e hit");
+    check(cache.get(6) == CACHE_MISS, "outra palavra da mesma linha ainda invalida");
+    cache.put(6, 60, nullptr);
+    check(cache.get(5) == 50 && cache.get(6) == 60, "segundo setor preenchido sem substituir a linha");
+}
+
+void burstFillTest() {
+    cout << "\n=== Preenchimento em rajada ===\n";
+    Cache cache(ReplacementPolicy::FIFO, geometry(32, 0, 16));
+    uint32_t words[16];
+    for (uint32_t i = 0; i < 16; ++i) words[i] = 200 + i;
+    cache.put(20, 7, nullptr);
+    cache.update(20, 77); // palavra suja antes da rajada
+    cache.fillLine(16, words, 16, nullptr);
+    check(cache.get(16) == 200 && cache.get(31) == 215, "linha inteira valida apos a rajada");
+    check(cache.get(20) == 77, "palavra suja preservada pela rajada");
+
+    MemoryManager mem(1024, 1024);
+    PCB pcb;
+    for (uint32_t a = 0; a < 16; a += 4) mem.write(a, a + 1, pcb);
+    PCB reader;
+    mem.read(0, reader);
+    mem.read(4, reader);
+    mem.read(8, reader);
+    mem.read(12, reader);
+    check(reader.cache_misses.load() == 0 && reader.primary_mem_accesses.load() == 0,
+          "leituras sequenciais na linha alocada pela escrita sao hits");
+
+    MemoryManager cold(1024, 1024);
+    for (uint32_t pc = 0; pc < 32; pc += 4) cold.writeToFile(pc, pc); // programa fora da cache
+    PCB fetcher;
+    for (uint32_t pc = 0; pc < 32; pc += 4) cold.read(pc, fetcher);
+    check(fetcher.cache_misses.load() == 2 && fetcher.primary_mem_accesses.load() == 2,
+          "8 buscas sequenciais com linhas de 16 bytes -> 2 misses");
+    check(fetcher.memory_cycles.load() == 2 * fetcher.memWeights.primary + 6 * fetcher.memWeights.cache,
+          "custo modelado por linha, nao por palavra");
+}
+
+void prefetchTest() {
+    cout << "\n=== Prefetch ===\n";
+    uint32_t out[PrefetchConfig::MAX_DEGREE];
+    PrefetchConfig config;
+    config.degree = 2;
+
+    config.kind = PrefetchKind::NextLine;
+    Prefetcher nextLine(config, 16);
+    check(nextLine.observe(0, 40, true, false, out) == 2 && out[0] == 48 && out[1] == 64,
+          "next-line busca as duas linhas seguintes no miss");
+    check(nextLine.observe(0, 40, false, false, out) == 0, "next-line nao dispara em hit comum");
+
+    // RPT: o passo precisa se repetir (Initial -> Transient -> Steady)
+    config.kind = PrefetchKind::Stride;
+    Prefetcher stride(config, 16);
+    size_t issued = stride.observe(100, 0, true, false, out) + stride.observe(100, 64, true, false, out);
+    check(issued == 0, "stride ainda sem predicao apos dois acessos");
+    check(stride.observe(100, 128, true, false, out) == 2 && out[0] == 192 && out[1] == 256,
+          "stride confirmado preve endereco + passo * (distancia + i)");
+    check(stride.observe(104, 4, true, false, out) == 0, "outro PC tem entrada propria na RPT");
+
+    config.kind = PrefetchKind::Stream;
+    Prefetcher stream(config, 16);
+    stream.observe(0, 160, true, false, out);
+    issued = stream.observe(0, 176, true, false, out);
+    check(issued == 0 && stream.observe(0, 192, true, false, out) == 2 && out[0] == 208,
+          "stream confirmado por dois misses na mesma direcao");
+
+    // Hierarquia: com next-line, a segunda linha de um programa sequencial ja
+    // esta a caminho; a demanda chega antes e paga so o restante da busca
+    MemoryManager mem(1024, 1024);
+    PrefetchConfig nl;
+    nl.kind = PrefetchKind::NextLine;
+    nl.degree = 1;
+    mem.configurePrefetcher(nl);
+    for (uint32_t pc = 0; pc < 32; pc += 4) mem.writeToFile(pc, pc);
+    PCB fetcher;
+    for (uint32_t pc = 0; pc < 32; pc += 4) mem.read(pc, fetcher);
+    PrefetchStats stats = mem.prefetchStats();
+    const uint64_t stall = fetcher.memWeights.primary - 4 * fetcher.memWeights.cache;
+    check(fetcher.cache_misses.load() == 1 && stats.issued == 2 && stats.late == 1,
+          "linha seguinte trazida por prefetch: 1 miss, prefetch atrasado");
+    check(fetcher.memory_cycles.load() == fetcher.memWeights.primary + 7 * fetcher.memWeights.cache + stall,
+          "prefetch atrasado cobra so o restante da busca");
+    check(stats.saved_cycles == fetcher.memWeights.primary - fetcher.memWeights.cache - stall,
+          "ciclos economizados = miss evitado - hit - stall");
+
+    // A RPT usa o PC do lw, não o do processo (que já pode ter avançado):
+    // dois loads intercalados, um com passo fixo, treinam entradas separadas
+    PrefetchConfig rpt;
+    rpt.kind = PrefetchKind::Stride;
+    for (bool tagged : {true, false}) {
+        MemoryManager strided(1024, 1024);
+        strided.configurePrefetcher(rpt);
+        PCB loop;
+        const uint32_t irregular[] = {1024, 1100, 1300, 1212};
+        for (uint32_t i = 0; i < 4; ++i) {
+            strided.read(i * 64, loop, tagged ? 100 : MemoryManager::NO_PC);
+            strided.read(irregular[i], loop, tagged ? 200 : MemoryManager::NO_PC);
+        }
+        const uint64_t issued = strided.prefetchStats().issued;
+        check(tagged ? issued > 0 : issued == 0,
+              tagged ? "stride detectado pelo PC de cada load" : "sem o PC do load, os acessos se misturam na RPT");
+    }
+
+    bool rejected = false;
+    try {
+        nl.degree = 0;
+        mem.configurePrefetcher(nl);
+    } catch (const invalid_argument &) {
+        rejected = true;
+    }
+    check(rejected, "grau de prefetch invalido rejeitado");
+}
+
+void buffersTest() {
+    cout << "\n=== Victim cache e buffer de escrita ===\n";
+    bool coalesced = false;
+    WriteBuffer wb(2);
+    check(wb.push(0, 0, 10, coalesced) == 0 && wb.push(16, 0, 10, coalesced) == 0,
+          "duas escritas cabem no buffer sem espera");
+    check(wb.push(0, 5, 10, coalesced) == 0 && coalesced, "linha ainda pendente coalesce");
+    check(wb.push(32, 5, 10, coalesced) == 5 && !coalesced, "buffer cheio: espera a escrita mais antiga");
+    check(wb.pending(16, 15) && !wb.pending(0, 15), "escritas drenam uma de cada vez");
+
+    // L1 e L2 diretas de 2 conjuntos: 0 e 32 disputam o mesmo conjunto
+    CacheConfig tiny = geometry(32, 1, 16);
+    BufferConfig buffers;
+    buffers.victim_lines = 2;
+    MemoryManager mem(1024, 1024, tiny, 1, geometry(64, 1, 16));
+    mem.configureBuffers(buffers);
+    mem.writeToFile(0, 7);
+    mem.writeToFile(32, 8);
+    PCB p;
+    mem.read(0, p);
+    mem.read(32, p);
+    uint64_t before = p.memory_cycles.load();
+    check(mem.read(0, p) == 7 && p.memory_cycles.load() - before == p.memWeights.victim,
+          "miss de conflito atendido pela victim cache");
+    check(mem.bufferStats().victim_hits == 1 && mem.l1(0).lineState(0) == Mesi::Exclusive,
+          "linha volta a L1 com o estado que tinha");
+
+    // Outro núcleo pede a linha para escrita: a cópia na victim cache sai
+    MemoryManager shared(1024, 1024, tiny, 2, geometry(64, 1, 16));
+    shared.configureBuffers(buffers);
+    shared.writeToFile(0, 7);
+    shared.writeToFile(32, 8);
+    PCB a, b;
+    b.core_id = 1;
+    shared.read(0, a);
+    shared.read(32, a);
+    shared.write(0, 9, b);
+    check(shared.read(0, a) == 9 && shared.bufferStats().victim_hits == 0,
+          "RFO de outro nucleo invalida a copia da victim cache");
+
+    // L2 de 2 conjuntos: a linha suja 0 sai da L2 quando 32 chega
+    MemoryManager sync(1024, 1024, tiny, 1, tiny);
+    PCB s;
+    sync.write(0, 5, s);
+    before = s.memory_cycles.load();
+    sync.read(32, s);
+    BufferStats stats = sync.bufferStats();
+    check(stats.writebacks == 1 && s.memory_cycles.load() - before == 2 * s.memWeights.primary,
+          "sem buffer, o write-back da linha suja e sincrono");
+    check(sync.read(0, s) == 5, "linha escrita na memoria mantem o valor");
+
+    buffers.victim_lines = 0;
+    buffers.write_buffer_entries = 4;
+    MemoryManager buffered(1024, 1024, tiny, 1, tiny);
+    buffered.configureBuffers(buffers);
+    PCB w;
+    buffered.write(0, 5, w);
+    before = w.memory_cycles.load();
+    buffered.read(32, w);
+    check(w.memory_cycles.load() - before == w.memWeights.primary, "com buffer, a leitura nao espera o write-back");
+    before = w.memory_cycles.load();
+    check(buffered.read(0, w) == 5 && w.memory_cycles.load() - before == w.memWeights.l2 &&
+          buffered.bufferStats().forwards == 1,
+          "linha ainda no buffer atende a leitura");
+
+    bool rejected = false;
+    try {
+        buffers.write_buffer_entries = BufferConfig::MAX_ENTRIES + 1;
+        buffered.configureBuffers(buffers);
+    } catch (const invalid_argument &) {
+        rejected = true;
+    }
+    check(rejected, "buffer de escrita grande demais rejeitado");
+}
+
+void mshrTest() {
+    cout << "\n=== MSHRs (cache nao bloqueante) ===\n";
+    MemoryManager mem(1024, 1024);
+    mem.configureMshrs(2);
+    for (uint32_t a = 0; a < 64; a += 4) mem.writeToFile(a, a + 1);
+    PCB p;
+    const uint64_t hit = p.memWeights.cache;
+    const uint64_t miss = p.memWeights.primary;
+
+    uint64_t first = 0, second = 0, merged = 0, third = 0;
+    check(mem.readNonBlocking(0, p, first) == 1 && mem.readNonBlocking(16, p, second) == 17,
+          "miss nao bloqueante devolve o valor funcional");
+    check(first == miss && second == hit + miss && p.memory_cycles.load() == 2 * hit,
+          "dois misses em voo: o processo paga so as consultas");
+    check(mem.readNonBlocking(4, p, merged) == 5 && merged == first && mem.mshrStats().merged == 1,
+          "miss secundario junta-se ao pedido da mesma linha");
+
+    // Os dois MSHRs estao ocupados: o terceiro miss espera a primeira linha
+    mem.readNonBlocking(32, p, third);
+    check(mem.mshrStats().full_stalls == 1 && third == first + miss, "sem MSHR livre, espera a primeira linha");
+    uint64_t before = p.memory_cycles.load();
+    mem.waitForLoad(p, third);
+    check(p.memory_cycles.load() - before == miss - hit, "instrucao dependente espera o restante do miss");
+
+    uint64_t fourth = 0;
+    mem.readNonBlocking(48, p, fourth);
+    before = p.memory_cycles.load();
+    mem.read(52, p);
+    check(p.memory_cycles.load() - before == miss - hit, "acesso bloqueante a linha pendente espera a chegada");
+
+    MshrStats stats = mem.mshrStats();
+    check(stats.misses == 4 && stats.peak == 2 && stats.dependency_stalls == 2 && stats.miss_cycles == 4 * miss,
+          "contadores de misses, pico e esperas");
+    uint64_t sequential = 4 * miss + 2 * hit;  // mesma sequencia numa cache bloqueante
+    check(p.memory_cycles.load() < sequential, "misses sobrepostos custam menos que em sequencia");
+
+    bool rejected = false;
+    try {
+        mem.configureMshrs(MshrFile::MAX_ENTRIES + 1);
+    } catch (const invalid_argument &) {
+        rejected = true;
+    }
+    check(rejected, "numero de MSHRs grande demais rejeitado");
+}
+
+void invalidatePartialTest() {
+    cout << "\n=== Invalidacao parcial ===\n";
+    Cache cache(ReplacementPolicy::FIFO, geometry(4, 0));
+    for (size_t a = 0; a < 4; ++a) cache.put(a, a + 100, nullptr);
+    cache.invalidatePartial(0.5f);
+    int remaining = 0;
+    for (size_t a = 0; a < 4; ++a) remaining += (cache.get(a) != CACHE_MISS);
+    check(remaining == 2, "50% das linhas validas invalidadas");
+    check(cache.get(0) == CACHE_MISS && cache.get(3) == 103, "as primeiras linhas na ordem dos conjuntos saem");
+
+    MemoryManager mem(1024, 1024);
+    PCB pcb;
+    Cache dirty(ReplacementPolicy::FIFO, geometry(4, 0));
+    for (size_t a = 0; a < 4; ++a) dirty.put(a, a + 100, &mem);
+    dirty.update(0, 77);
+    check(dirty.invalidatePartial(0.5f, &mem) == 2 && mem.read(0, pcb) == 77,
+          "palavra suja invalidada segue para o nivel inferior");
+}
+
+void asidTest() {
+    cout << "\n=== ASID ===\n";
+    uint32_t words[16];
+    for (uint32_t i = 0; i < 16; ++i) words[i] = i;
+    Cache cache(ReplacementPolicy::FIFO, geometry(64, 0, 16));
+    cache.fillLine(0, words, 16, nullptr, Mesi::Exclusive, nullptr, 1);
+    cache.fillLine(16, words, 16, nullptr, Mesi::Exclusive, nullptr, 2);
+    cache.writeHit(20, 99);
+    check(cache.lineAsid(0) == 1 && cache.lineAsid(16) == 2, "linha guarda o ASID de quem a trouxe");
+
+    MemoryManager sink(1024, 1024);
+    PCB pcb;
+    check(cache.invalidateAsid(2, &sink) == 1 && cache.get(0) == 0 && cache.get(16) == CACHE_MISS,
+          "invalidacao seletiva remove so as linhas do ASID");
+    check(sink.read(20, pcb) == 99, "linha suja do ASID sai com write-back");
+
+    // Troca de contexto na L1 conforme a politica
+    MemoryManager mem(1024, 1024);
+    PCB first, second;
+    first.pid = 1;
+    second.pid = 2;
+    mem.setSwitchPolicy(SwitchPolicy::Asid);
+    mem.read(0, first);
+    mem.read(16, first);
+    mem.simulateContextSwitch(0, first.pid);
+    mem.simulateContextSwitchLight(0);
+    check(mem.l1(0).lineState(0) != Mesi::Invalid && mem.switchStats().invalidated_lines == 0,
+          "com ASID a troca nao invalida nada");
+
+    mem.setSwitchPolicy(SwitchPolicy::AsidFlush);
+    mem.read(32, second);
+    mem.simulateContextSwitch(0, first.pid);
+    check(mem.l1(0).lineState(0) == Mesi::Invalid && mem.l1(0).lineState(16) == Mesi::Invalid &&
+          mem.l1(0).lineState(32) != Mesi::Invalid,
+          "asid-flush descarta so as linhas do processo que sai");
+    SwitchStats stats = mem.switchStats();
+    check(stats.switches == 3 && stats.invalidated_lines == 2, "trocas e linhas invalidadas contadas");
+
+    SwitchPolicy parsed = SwitchPolicy::Partial;
+    check(parseSwitchPolicy("ASID_FLUSH", parsed) && parsed == SwitchPolicy::AsidFlush &&
+          !parseSwitchPolicy("tlb", parsed),
+          "nomes das politicas de troca de contexto");
+}
+
+// Nível inferior que só registra a ordem das escritas
+struct RecordingLower : CacheLowerLevel {
+    vector<uint32_t> addresses;
+    void writeBack(uint32_t address, uint32_t) override { addresses.push_back(address); }
+};
+
+void flushTest() {
+    cout << "\n=== Flush das linhas sujas ===\n";
+    uint32_t words[16] = {};
+    Cache cache(ReplacementPolicy::FIFO, geometry(64, 0, 16));
+    for (size_t base : {32u, 0u, 16u}) {
+        cache.fillLine(base, words, 16, nullptr);
+        cache.writeHit(base + 4, static_cast<uint32_t>(base));
+    }
+    auto dirty = cache.dirtyData();
+    check(dirty.size() == 3 && dirty[0].first == 4 && dirty[1].first == 20 && dirty[2].first == 36,
+          "dirtyData em ordem de endereco");
+
+    RecordingLower lower;
+    cache.flush(&lower);
+    check(lower.addresses == vector<uint32_t>({4, 20, 36}), "flush escreve em ordem de endereco");
+    check(cache.dirtyData().empty() && cache.lineState(0) == Mesi::Exclusive && cache.get(36) == 32,
+          "linhas ficam validas e limpas (M -> E)");
+    check(cache.flush(&lower).empty() && lower.addresses.size() == 3, "segundo flush nao escreve nada");
+
+    // Hierarquia: L1 -> L2 -> memória, em lotes de linhas consecutivas
+    MemoryManager mem(1024, 1024);
+    PCB pcb;
+    for (uint32_t address : {0u, 16u, 32u, 128u}) mem.write(address, address + 1, pcb);
+    mem.flushCaches();
+    FlushStats stats = mem.flushStats();
+    check(stats.flushes == 2 && stats.lines == 8 && stats.batches == 4,
+          "4 linhas em 2 lotes na L1 e na L2");
+    check(stats.cycles == (2 * 3 + 2) + (2 * 5 + 2) && stats.unbatched_cycles == 4 * 3 + 4 * 5,
+          "lote paga um acesso e as linhas seguintes so a transferencia");
+    check(mem.l1(0).dirtyData().empty(), "L1 limpa depois do flush");
+
+    mem.resetCache();  // descarta as caches sem write-back: o que resta está na memória
+    bool persisted = true;
+    for (uint32_t address : {0u, 16u, 32u, 128u}) persisted = persisted && mem.read(address, pcb) == address + 1;
+    check(persisted, "memoria tem o estado final depois do flush");
+
+    // A troca de contexto limpa a L1 do núcleo antes de invalidar
+    MemoryManager switching(1024, 1024);
+    switching.setSwitchPolicy(SwitchPolicy::Asid);
+    switching.write(64, 7, pcb);
+    switching.simulateContextSwitch(0, pcb.pid);
+    check(switching.l1(0).dirtyData().empty() && switching.l1(0).get(64) == 7 &&
+          switching.flushStats().lines == 1,
+          "troca de contexto faz flush da L1 sem perder a linha");
+
+    PCB heavy;
+    heavy.memWeights.l2 = 7;
+    switching.write(64, 8, heavy);
+    switching.simulateContextSwitch(0, heavy.pid, heavy.memWeights);
+    check(switching.flushStats().cycles == 3 + 7, "flush cobrado com os pesos do processo que sai");
+}
+
+void deviceTest() {
+    cout << "\n=== Memoria secundaria ===\n";
+    SECONDARY_MEMORY disk(1024);
+    disk.WriteMem(1000, 7);
+    check(disk.ReadMem(1000) == 7 && disk.ReadMem(4096) == MEMORY_ACCESS_ERROR, "acesso direto por indice");
+
+    DeviceConfig config;
+    config.kind = DeviceKind::Disk;
+    config.latency = 40;
+    config.bandwidth = 4;
+    disk.configureDevice(config);
+    check(disk.access(0, 16, 0) == 40 + 4, "disk: posicionamento + transferencia");
+    check(disk.access(16, 16, 100) == 4, "disk: acesso sequencial nao reposiciona");
+    check(disk.access(512, 16, 100) == 4 + 44, "disk: fila de um pedido espera o anterior");
+    DeviceStats stats = disk.deviceStats();
+    check(stats.requests == 3 && stats.sequential == 1 && stats.queued == 1 && stats.queue_cycles == 4,
+          "pedidos, sequenciais e esperas contados");
+
+    SECONDARY_MEMORY flash(1024);
+    config.kind = DeviceKind::Flash;
+    config.latency = 0;  // padrão do tipo
+    config.queue_depth = 2;
+    flash.configureDevice(config);
+    check(flash.access(0, 16, 0) == 12 + 4 && flash.access(16, 16, 0) == 12 + 4 &&
+          flash.access(32, 16, 0) == 16 + 16,
+          "flash: latencia fixa e dois pedidos em paralelo");
+    DeviceKind kind = DeviceKind::Flat;
+    check(parseDeviceKind("SSD", kind) && kind == DeviceKind::Flash && !parseDeviceKind("tape", kind),
+          "nomes dos dispositivos");
+
+    // Miss na memória secundária pelo MemoryManager
+    MemoryManager mem(1024, 1024);
+    PCB pcb;
+    mem.read(1024, pcb);
+    check(pcb.memory_cycles.load() == pcb.memWeights.secondary, "flat: peso fixo por linha");
+    config.kind = DeviceKind::Disk;
+    config.latency = 30;
+    config.queue_depth = 1;
+    mem.configureDevice(config);
+    PCB other;
+    mem.read(1040, other);
+    check(other.memory_cycles.load() == 30 + 4 && mem.deviceStats().sequential == 0,
+          "primeiro pedido ao disco: nao sequencial");
+    check(mem.deviceStats().requests == 1, "miss conta um pedido ao dispositivo");
+}
+
+void mappedSecondaryTest() {
+    cout << "\n=== Memoria secundaria em arquivo (mmap) ===\n";
+    const string path = "test_cache_secundaria.bin";
+    std::remove(path.c_str());
+    {
+        SECONDARY_MEMORY store(4096, path);
+        store.WriteMem(4000, 123);
+        check(store.mapped() && store.capacity() == 4096 && store.ReadMem(4000) == 123 &&
+              store.ReadMem(4096) == MEMORY_ACCESS_ERROR,
+              "arquivo mapeado com o tamanho pedido");
+    }
+    {
+        SECONDARY_MEMORY store(0, path);
+        check(store.capacity() == 4096 && store.ReadMem(4000) == 123, "conteudo persiste entre execucoes");
+    }
+
+    // Maior que a memória em RAM: o arquivo é esparso e as páginas vêm sob demanda
+    const size_t words = size_t(1) << 20;
+    MemoryManager mem(1024, 1024);
+    DeviceConfig config;
+    config.backing_file = path;
+    config.words = words;
+    mem.configureDevice(config);
+    PCB pcb;
+    const uint32_t last = static_cast<uint32_t>(1024 + words - 16);
+    mem.write(last, 77, pcb);
+    check(mem.read(last, pcb) == 77 && mem.getSecondaryCapacity() == words, "MemoryManager usa o arquivo");
+    mem.flushCaches();
+    mem.configureDevice(DeviceConfig{});  // volta à RAM e desmapeia o arquivo
+    {
+        SECONDARY_MEMORY store(0, path);
+        check(store.ReadMem(static_cast<uint32_t>(words - 16)) == 77, "flush grava o estado final no arquivo");
+    }
+    bool threw = false;
+    try {
+        SECONDARY_MEMORY missing(16, "/diretorio-inexistente/secundaria.bin");
+    } catch (const runtime_error &) {
+        threw = true;
+    }
+    check(threw, "arquivo que nao pode ser aberto lanca runtime_error");
+    std::remove(path.c_str());
+}
+
+void pagingTest() {
+    cout << "\n=== Memoria virtual paginada ===\n";
+    PageConfig config;
+    config.frames = 2;
+    config.page_size = 64;
+    config.tlb_entries = 2;
+
+    // Clock e aging escolhem vítimas diferentes para a mesma sequência
+    VirtualMemory clock;
+    clock.configure(config, 1);
+    VirtualMemory::Eviction victim;
+    uint32_t frame = 0;
+    check(clock.lookup(0, 0, false, frame) == VirtualMemory::Lookup::Fault, "pagina ausente -> falta");
+    check(clock.fault(0, 0, false, victim) == 0 && !victim.valid, "primeira falta usa quadro livre");
+    check(clock.lookup(0, 0, false, frame) == VirtualMemory::Lookup::TlbHit && frame == 0, "traducao na TLB");
+    clock.fault(0, 1, false, victim);
+    clock.fault(0, 2, false, victim);
+    check(victim.valid && victim.vpn == 0 && clock.stats().shootdowns == 1, "clock: expulsao com shootdown na TLB");
+    clock.lookup(0, 1, false, frame);
+    clock.fault(0, 3, false, victim);
+    check(victim.vpn == 1, "clock: segunda chance limpa R antes de escolher");
+
+    config.replacement = PageReplacement::Aging;
+    VirtualMemory aging;
+    aging.configure(config, 1);
+    aging.fault(0, 0, false, victim);
+    aging.fault(0, 1, false, victim);
+    aging.fault(0, 2, false, victim);
+    aging.lookup(0, 1, false, frame);
+    aging.fault(0, 3, false, victim);
+    check(victim.vpn == 2, "aging: expulsa a pagina com o menor contador");
+
+    // WSClock passa pela página suja antiga e prefere a limpa
+    config.frames = 3;
+    config.replacement = PageReplacement::WSClock;
+    config.wsclock_tau = 1;
+    VirtualMemory wsclock;
+    wsclock.configure(config, 1);
+    wsclock.fault(0, 0, true, victim);
+    wsclock.fault(0, 1, true, victim);
+    wsclock.fault(0, 2, false, victim);
+    wsclock.fault(0, 3, false, victim);
+    for (int i = 0; i < 3; ++i) wsclock.lookup(0, 9, false, frame);  // avança o tempo virtual
+    check(wsclock.fault(0, 4, false, victim) == 2 && victim.vpn == 2 && !victim.dirty,
+          "wsclock: pagina limpa fora da janela antes da suja");
+    PageReplacement policy = PageReplacement::Clock;
+    check(parsePageReplacement("LRU", policy) && policy == PageReplacement::Aging &&
+          parsePageReplacement("ws-clock", policy) && policy == PageReplacement::WSClock &&
+          !parsePageReplacement("fifo", policy),
+          "nomes das politicas de substituicao");
+
+    // Paginação sob demanda no MemoryManager: 3 páginas em 2 quadros
+    MemoryManager mem(1024, 1024);
+    PageConfig paged;
+    paged.frames = 2;
+    paged.page_size = 64;
+    mem.configurePaging(paged);
+    mem.writeToFile(0, 10);
+    mem.writeToFile(64, 20);
+    mem.writeToFile(128, 30);
+    PCB pcb;
+    pcb.pid = 1;
+    mem.write(0, 11, pcb);
+    check(mem.read(64, pcb) == 20 && mem.read(128, pcb) == 30, "paginas trazidas da memoria secundaria");
+    check(mem.read(0, pcb) == 11, "pagina suja expulsa volta com o dado escrito");
+    PagingStats stats = mem.pagingStats();
+    check(stats.faults == 4 && stats.evictions == 2 && stats.dirty_writebacks >= 1,
+          "faltas, expulsoes e paginas sujas contadas");
+    mem.read(4, pcb);
+    check(mem.pagingStats().tlb_hits == stats.tlb_hits + 1, "mesma pagina -> hit na TLB");
+
+    // Tabela global: outro processo no mesmo endereço virtual vê o mesmo quadro
+    PCB other;
+    other.pid = 2;
+    mem.write(0, 12, pcb);
+    uint64_t hits = mem.pagingStats().tlb_hits;
+    check(mem.read(0, other) == 12 && mem.pagingStats().faults == stats.faults,
+          "dois processos compartilham a pagina sem nova falta");
+    check(mem.pagingStats().tlb_hits == hits + 1, "TLB sem pid: a troca de processo aproveita a entrada");
+    mem.write(0, 13, other);
+    mem.read(64, pcb);
+    mem.read(128, pcb);  // expulsa a página 0 (suja)
+    mem.flushCaches();
+    check(mem.read(0, pcb) == 13 && mem.read(0, other) == 13, "escrita de um processo lida pelo outro apos a expulsao");
+
+    bool threw = false;
+    try {
+        paged.frames = 64;  // 64 * 64 > 1024 endereços da principal
+        mem.configurePaging(paged);
+    } catch (const invalid_argument &) {
+        threw = true;
+    }
+    check(threw, "quadros alem da memoria principal lancam invalid_argument");
+}
+
+void segmentationTest() {
+    cout << "\n=== Segmentacao com registradores de segmento ===\n";
+    SegmentTable table(1);
+    table.setSegment(SEG_CODE, 0, 16, true, "CODE");
+    table.setSegment(SEG_DATA, 64, 64, false, "DATA");
+    uint32_t linear = 0;
+    check(table.tryTranslate(SEG_DATA, 8, true, linear) == SegmentFault::None && linear == 72,
+          "tryTranslate soma a base do segmento");
+    check(table.tryTranslate(SEG_DATA, 64, false, linear) == SegmentFault::Limit &&
+          table.tryTranslate(SEG_CODE, 0, true, linear) == SegmentFault::ReadOnly &&
+          table.tryTranslate(SEG_HEAP, 0, false, linear) == SegmentFault::NotPresent &&
+          table.tryTranslate(7, 0, false, linear) == SegmentFault::Invalid,
+          "violacoes sem excecao");
+
+    MemoryManager mem(1024, 1024);
+    mem.configureSegmentation(true);
+    mem.writeToFile(0, 0xABC);
+    PCB pcb;
+    pcb.pid = 1;
+    pcb.segments = table;
+    mem.write(4, 7, pcb);
+    check(mem.read(4, pcb) == 7 && mem.fetch(0, pcb) == 0xABC, "dados relativos ao DS, busca no CS");
+    PCB kernel;  // sem segmentos: endereços lineares
+    check(mem.read(68, kernel) == 7, "o dado fica em base do DS + deslocamento");
+    SegmentStats stats = mem.segmentStats();
+    check(stats.descriptor_loads == 2 && stats.register_hits == 1 && stats.load_cycles == 2 * pcb.memWeights.primary,
+          "um descritor lido por segmento, depois so o limite");
+
+    mem.write(64, 9, pcb);
+    check(mem.fetch(16, pcb) == MEMORY_ACCESS_ERROR && mem.read(64, pcb) == MEMORY_ACCESS_ERROR &&
+          mem.read(128, kernel) != 9,
+          "acesso fora do limite negado e store descartado");
+    check(mem.segmentStats().limit_faults == 3, "violacoes de limite contadas");
+
+    pcb.segments.setSegment(SEG_DATA, 256, 64, false, "DATA");
+    mem.read(0, pcb);
+    PCB other;
+    other.pid = 2;
+    other.segments = SegmentTable(2);
+    other.segments.setSegment(SEG_DATA, 512, 64, false, "DATA");
+    mem.read(0, other);
+    check(mem.segmentStats().descriptor_loads == 4, "tabela alterada ou outro processo recarregam o registrador");
+
+    mem.configureSegmentation(false);
+    check(mem.read(68, pcb) == 7, "desligada: enderecos lineares");
+}
+
+void allocatorTest() {
+    cout << "\n=== Alocador de memoria fisica ===\n";
+    AllocConfig cfg;
+    cfg.policy = AllocPolicy::Buddy;
+    cfg.granule = 16;
+    PhysicalAllocator buddy;
+    buddy.configure(cfg, 256);
+    long a = buddy.allocate(20);
+    long b = buddy.allocate(60);
+    check(a == 0 && b == 64 && buddy.blockSize(0) == 32 && buddy.blockSize(64) == 64,
+          "buddy arredonda para potencia de 2 e divide o bloco");
+    AllocStats stats = buddy.stats();
+    check(stats.splits == 3 && stats.in_use == 96 && stats.free_blocks == 2 && stats.largest_free == 128,
+          "metades livres ficam nas listas por ordem");
+    check(stats.internalFragmentation() > 0.16 && stats.internalFragmentation() < 0.17,
+          "fragmentacao interna do arredondamento");
+    check(buddy.allocate(300) == -1 && buddy.stats().failures == 1, "pedido maior que a arena falha");
+    check(buddy.release(0) && buddy.release(64) && !buddy.release(64), "liberacao so de blocos em uso");
+    stats = buddy.stats();
+    check(stats.merges == 3 && stats.free_blocks == 1 && stats.largest_free == 256 &&
+          stats.externalFragmentation() == 0.0,
+          "irmaos livres unidos ate a arena inteira");
+
+    // Buracos de 64 (em 32) e 32 (em 112): first-fit pega o primeiro, best-fit o menor
+    for (AllocPolicy policy : {AllocPolicy::FirstFit, AllocPolicy::BestFit}) {
+        cfg.policy = policy;
+        PhysicalAllocator fit;
+        fit.configure(cfg, 256);
+        long blocks[] = {fit.allocate(32), fit.allocate(64), fit.allocate(16), fit.allocate(32), fit.allocate(112)};
+        check(blocks[4] == 144 && fit.allocate(1) == -1, string(allocPolicyName(policy)) + ": arena cheia");
+        fit.release(32);
+        fit.release(112);
+        stats = fit.stats();
+        check(stats.free_blocks == 2 && stats.externalFragmentation() > 0.33 && stats.externalFragmentation() < 0.34,
+              string(allocPolicyName(policy)) + ": fragmentacao externa dos buracos");
+        long chosen = fit.allocate(30);
+        check(chosen == (policy == AllocPolicy::FirstFit ? 32 : 112) && fit.blockSize(chosen) == 32,
+              string(allocPolicyName(policy)) + ": buraco escolhido pela politica");
+        fit.release(static_cast<uint32_t>(chosen));
+        for (long base : {blocks[0], blocks[2], blocks[3], blocks[4]}) fit.release(static_cast<uint32_t>(base));
+        stats = fit.stats();
+        check(stats.free_blocks == 1 && stats.largest_free == 256 && stats.allocations == 6 && stats.frees == 6 &&
+              stats.peak_in_use == 256,
+              string(allocPolicyName(policy)) + ": vizinhas livres unidas");
+    }
+
+    // Faixa baixa reservada (dados absolutos sem segmentação) nunca é entregue
+    cfg.reserved = 64;
+    for (AllocPolicy policy : {AllocPolicy::Buddy, AllocPolicy::FirstFit}) {
+        cfg.policy = policy;
+        PhysicalAllocator low;
+        low.configure(cfg, 256);
+        long first = low.allocate(16);
+        check(first == 64 && low.stats().arena == 192 && low.allocate(256) == -1,
+              string(allocPolicyName(policy)) + ": arena comeca depois da faixa reservada");
+        low.release(static_cast<uint32_t>(first));
+        check(low.stats().free_total == 192, string(allocPolicyName(policy)) + ": liberacao nao une com a faixa reservada");
+    }
+    cfg.reserved = 0;
+
+    MemoryManager mem(1024, 1024);
+    cfg.policy = AllocPolicy::BestFit;
+    mem.configureAllocator(cfg);
+    long image = mem.allocate(100);
+    check(image == 0 && mem.allocatorStats().arena == 2048 && mem.allocatorStats().in_use == 112,
+          "MemoryManager administra principal + secundaria");
+    mem.release(static_cast<uint32_t>(image));
+    check(mem.allocatorStats().in_use == 0 && mem.allocatorStats().frees == 1, "imagem devolvida ao alocador");
+
+    // Bloco reaproveitado: a nova imagem (writeToFile) não fica atrás das
+    // linhas do processo anterior nas caches
+    PCB previous;
+    mem.write(40, 1, previous);
+    mem.read(48, previous);
+    mem.discardLines(32, 32);
+    mem.writeToFile(40, 2);
+    mem.writeToFile(48, 3);
+    PCB next;
+    check(mem.read(40, next) == 2 && mem.read(48, next) == 3 && mem.l1(0).dirtyData().empty(),
+          "discardLines tira das caches as linhas do bloco");
+}
+
+void coherenceTest() {
+    cout << "\n=== Coerencia MESI entre L1 privadas ===\n";
+    MemoryManager mem(1024, 1024, CacheConfig{}, 2);
+    mem.writeToFile(0, 1);
+    PCB a, b;
+    a.core_id = 0;
+    b.core_id = 1;
+
+    mem.read(0, a);
+    check(mem.l1(0).lineState(0) == Mesi::Exclusive, "leitura sem outras copias -> Exclusive");
+    mem.write(0, 42, a);
+    check(mem.l1(0).lineState(0) == Mesi::Modified, "escrita local em Exclusive -> Modified");
+
+    check(mem.read(0, b) == 42, "outro nucleo le o valor modificado");
+    check(mem.l1(0).lineState(0) == Mesi::Shared && mem.l1(1).lineState(0) == Mesi::Shared,
+          "intervencao deixa as duas copias Shared");
+
+    mem.write(0, 43, b);
+    CoherenceStats stats = mem.coherenceStats();
+    check(mem.l1(0).lineState(0) == Mesi::Invalid && mem.l1(1).lineState(0) == Mesi::Modified,
+          "upgrade invalida a copia do outro nucleo");
+    check(mem.read(0, a) == 43, "nucleo invalidado le o valor novo");
+    check(stats.interventions == 1 && stats.upgrades == 1 && stats.invalidations == 1,
+          "contadores de intervencao, upgrade e invalidacao");
+    check(b.l2_mem_accesses.load() == 1, "miss na L1 com a linha na L2 e servido pela L2");
+}
+
+void inclusionTest() {
+    cout << "\n=== L2 inclusiva ===\n";
+    CacheConfig l2;
+    l2.capacity = 32;
+    l2.ways = 0;
+    l2.line_size = 16;
+    MemoryManager mem(1024, 1024, CacheConfig{}, 1, l2);
+    PCB pcb;
+    mem.write(0, 7, pcb);
+    mem.read(16, pcb);
+    mem.read(32, pcb); // L2 com 2 linhas: expulsa a linha 0, que sai da L1 tambem
+    check(mem.l1(0).lineState(0) == Mesi::Invalid, "expulsao na L2 remove a copia da L1");
+    check(mem.coherenceStats().back_invalidations == 1, "back-invalidacao contabilizada");
+    check(mem.read(0, pcb) == 7, "dado modificado da L1 preservado na memoria");
+}
+
+void shardedTest() {
+    cout << "\n=== Shards e estatisticas concorrentes ===\n";
+    CacheConfig config = geometry(1024, 4, 16);
+    config.shards = 8;
+    Cache cache(ReplacementPolicy::LRU, config);
+    check(cache.shardCount() == 8 && cache.shardOf(0) != cache.shardOf(16), "linhas vizinhas em shards diferentes");
+    CacheConfig fully = geometry(64, 0, 16);
+    fully.shards = 8;
+    Cache single(ReplacementPolicy::FIFO, fully);
+    check(single.shardCount() == 1, "shards limitados ao numero de conjuntos");
+
+    // 4 threads, cada uma lendo sua faixa de linhas: as estatísticas somam exato
+    const int threads = 4, rounds = 1000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cache, t] {
+            uint32_t words[16] = {};
+            for (int i = 0; i < rounds; ++i) {
+                size_t address = static_cast<size_t>(t) * 64 + static_cast<size_t>(i % 4) * 16;
+                if (cache.get(address) == CACHE_MISS) cache.fillLine(address, words, 16, nullptr);
+            }
+        });
+    }
+    for (auto &w : workers) w.join();
+    check(cache.get_hits() + cache.get_misses() == static_cast<uint64_t>(threads * rounds),
+          "hits + misses = acessos com varias threads");
+    check(cache.get_misses() == static_cast<uint64_t>(threads * 4), "cada linha falta uma unica vez");
+}
+
+int main() {
+    cout << "=========================================\n";
+    cout << "=== Iniciando Teste Unitario: Cache ===\n";
+    cout << "=========================================\n";
+
+    geometryTest();
+    directMappedTest();
+    replacementTest();
+    policiesTest();
+    writeBackTest();
+    sectorTest();
+    burstFillTest();
+    prefetchTest();
+    buffersTest();
+    mshrTest();
+    invalidatePartialTest();
+    asidTest();
+    flushTest();
+    deviceTest();
+    mappedSecondaryTest();
+    pagingTest();
+    segmentationTest();
+    allocatorTest();
+    coherenceTest();
+    inclusionTest();
+    shardedTest();
+
+    if (falhas > 0) {
+        cout << "\n!!! " << falhas << " verificacao(oes) falharam !!!\n";
+        return 1;
+    }
+    cout << "\n=== Todos os testes da Cache passaram com sucesso! ===\n";
+    return 0;
+}
@@ -0,0 +1,259 @@
+/*
+  test_decode_cache.cpp
+  Teste da pré-decodificação (Control_Unit::Predecode) e da DecodeCache por PC,
+  incluindo a invalidação em escritas na faixa de código, das superinstruções
+  do modo funcional (FusionTable), do motor de blocos básicos (BlockCache) e
+  do encerramento de um processo que busca fora do segmento de código.
+*/
+#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+#include "cpu/CONTROL_UNIT.hpp"
+#include "cpu/DecodeCache.hpp"
+#include "cpu/PCB.hpp"
+#include "cpu/BlockEngine.hpp"
+#include "memory/MemoryManager.hpp"
+#include "IO/IOManager.hpp"
+
+using namespace std;
+
+static int falhas = 0;
+
+static void check(bool cond, const string &msg) {
+    if (cond) {
+        cout << "  -> SUCESSO: " << msg << "\n";
+    } else {
+        cout << "  -> FALHA: " << msg << "\n";
+        falhas++;
+    }
+}
+
+static uint32_t makeR(uint8_t rs, uint8_t rt, uint8_t rd, uint8_t funct) {
+    return (static_cast<uint32_t>(rs) << 21) | (static_cast<uint32_t>(rt) << 16) |
+           (static_cast<uint32_t>(rd) << 11) | (funct & 0x3Fu);
+}
+static uint32_t makeI(uint8_t opcode, uint8_t rs, uint8_t rt, uint16_t imm) {
+    return (static_cast<uint32_t>(opcode & 0x3F) << 26) | (static_cast<uint32_t>(rs) << 21) |
+           (static_cast<uint32_t>(rt) << 16) | imm;
+}
+
+void predecodeTest() {
+    cout << "\n=== Predecode ===\n";
+    MicroOp add = Control_Unit::Predecode(makeR(8, 9, 10, 0x20));
+    check(add.op == Opcode::ADD && add.rs == 8 && add.rt == 9 && add.rd == 10,
+          "ADD t2, t0, t1 decodificado com indices de registradores");
+
+    MicroOp addi = Control_Unit::Predecode(makeI(0x08, 0, 8, 0xFFFF));
+    check(addi.op == Opcode::ADDI && addi.rt == 8 && addi.imm == -1 && addi.uimm == 0xFFFF,
+          "ADDI com imediato estendido com sinal");
+
+    MicroOp print = Control_Unit::Predecode(makeI(0x3E, 0, 10, 0));
+    check(print.op == Opcode::PRINT && print.has(FIELD_RT) && !print.has(FIELD_IMM),
+          "PRINT de registrador sem imediato");
+
+    check(Control_Unit::Predecode(0xFC000000u).op == Opcode::END, "END sentinel");
+    check(string(opcodeName(Opcode::MULT)) == "MULT", "mnemonico preservado para logs");
+}
+
+void cacheTest() {
+    cout << "\n=== DecodeCache ===\n";
+    DecodeCache cache;
+    cache.configure(100, 120);
+
+    uint32_t raw = makeR(8, 9, 10, 0x20);
+    check(cache.lookup(104, raw) == nullptr, "primeiro acesso e miss");
+    cache.insert(104, Control_Unit::Predecode(raw));
+    const MicroOp *hit = cache.lookup(104, raw);
+    check(hit != nullptr && hit->op == Opcode::ADD, "segundo acesso e hit");
+    check(cache.lookup(104, raw + 1) == nullptr, "palavra diferente no mesmo PC nao retorna decodificacao antiga");
+
+    cache.insert(200, Control_Unit::Predecode(raw));
+    check(cache.lookup(200, raw) == nullptr, "PC fora da faixa de codigo nao e armazenado");
+
+    PCB pcb;
+    MemoryManager mem(1024, 1024);
+    pcb.decode_cache.configure(0, 16);
+    mem.write(4, raw, pcb);
+    pcb.decode_cache.insert(4, Control_Unit::Predecode(raw));
+    mem.write(4, makeI(0x08, 0, 8, 1), pcb);
+    check(pcb.decode_cache.invalidations() == 1 && pcb.decode_cache.lookup(4, raw) == nullptr,
+          "escrita em endereco de codigo invalida a entrada");
+}
+
+// Programa de teste: li, li, 3x add, laço addi+bne (5 voltas), END
+static vector<uint32_t> fusionProgram() {
+    vector<uint32_t> p;
+    p.push_back(makeI(0x08, 0, 8, 5));          // 0:  li t0, 5
+    p.push_back(makeI(0x08, 0, 9, 3));          // 4:  li t1, 3
+    p.push_back(makeR(8, 9, 8, 0x20));          // 8:  add t0, t0, t1
+    p.push_back(makeR(8, 9, 8, 0x20));          // 12: add t0, t0, t1
+    p.push_back(makeR(8, 9, 8, 0x20));          // 16: add t0, t0, t1
+    p.push_back(makeI(0x08, 0, 10, 5));         // 20: li t2, 5
+    p.push_back(makeI(0x08, 10, 10, 0xFFFF));   // 24: addi t2, t2, -1
+    p.push_back(makeI(0x05, 10, 0, 24));        // 28: bne t2, zero, 24
+    p.push_back(0xFC000000u);                   // 32: END
+    return p;
+}
+
+void fusionAnalysisTest() {
+    cout << "\n=== FusionTable (analise) ===\n";
+    vector<uint32_t> words = fusionProgram();
+    vector<MicroOp> program;
+    for (uint32_t w : words) program.push_back(Control_Unit::Predecode(w));
+
+    FusionTable table;
+    table.configure(0, static_cast<uint32_t>(words.size() * 4));
+    table.build(program);
+    DecodeCache empty;
+
+    const FusedOp *li = table.lookup(0, empty);
+    check(li && li->kind == FusedKind::LI_LI && li->length == 2, "li + li fundidos");
+    const FusedOp *chain = table.lookup(8, empty);
+    check(chain && chain->kind == FusedKind::ADD_CHAIN && chain->length == 3, "cadeia de 3 add");
+    check(table.lookup(20, empty) == nullptr, "li seguido de addi comum nao e fundido");
+    const FusedOp *loop = table.lookup(24, empty);
+    check(loop && loop->kind == FusedKind::ADDI_BRANCH && loop->second.op == Opcode::BNE,
+          "addi + bne (fim de laco) fundidos");
+    check(table.lookup(32, empty) == nullptr, "END nao inicia superinstrucao");
+
+    table.invalidate(16);
+    check(table.lookup(8, empty) == nullptr && table.lookup(24, empty) != nullptr,
+          "escrita no codigo descarta so as sequencias que a contem");
+}
+
+// Executa o programa todo em modo funcional e devolve o PCB resultante
+static unique_ptr<PCB> runFunctional(bool fusion, FunctionalEngine engine = FunctionalEngine::Step) {
+    auto pcb = make_unique<PCB>();
+    pcb->quantum = 1000;
+    MemoryManager mem(1024, 1024);
+    vector<uint32_t> words = fusionProgram();
+    vector<MicroOp> program;
+    for (size_t i = 0; i < words.size(); ++i) {
+        mem.writeToFile(static_cast<uint32_t>(i * 4), words[i]);
+        program.push_back(Control_Unit::Predecode(words[i]));
+    }
+    pcb->decode_cache.configure(0, static_cast<uint32_t>(words.size() * 4));
+    pcb->fusion_table.configure(0, static_cast<uint32_t>(words.size() * 4));
+    pcb->fusion_table.build(program);
+    pcb->block_cache.configure(0, static_cast<uint32_t>(words.size() * 4), words);
+    DiscoverBlocks(pcb->block_cache);
+
+    CoreOptions options;
+    options.ff_instructions = 1000;
+    options.fusion = fusion;
+    options.engine = engine;
+    vector<unique_ptr<IORequest>> io;
+    bool printLock = false;
+    Core(mem, *pcb, &io, printLock, options);
+    return pcb;
+}
+
+void fusionExecutionTest() {
+    cout << "\n=== Superinstrucoes (execucao funcional) ===\n";
+    auto fused = runFunctional(true);
+    auto plain = runFunctional(false);
+
+    check(fused->state == State::Finished && fused->regBank.read(8) == 14 && fused->regBank.read(10) == 0,
+          "resultado correto com fusao (t0 = 14, t2 = 0)");
+    check(fused->regBank.read(8) == plain->regBank.read(8) && fused->regBank.read(10) == plain->regBank.read(10),
+          "mesmos registradores com e sem fusao");
+    check(fused->instruction_count == plain->instruction_count &&
+          fused->pipeline_cycles.load() == plain->pipeline_cycles.load(),
+          "mesmas instrucoes e ciclos de pipeline contabilizados");
+    check(fused->mem_accesses_total.load() == plain->mem_accesses_total.load(),
+          "mesmos acessos a memoria (cada instrucao ainda e buscada)");
+    check(fused->fusion_table.executions() > 0 && plain->fusion_table.executions() == 0,
+          "superinstrucoes usadas apenas com fusao habilitada");
+}
+
+void blockEngineTest() {
+    cout << "\n=== Motor de blocos basicos ===\n";
+    auto blocks = runFunctional(false, FunctionalEngine::Block);
+    auto plain = runFunctional(false);
+
+    check(blocks->state == State::Finished && blocks->regBank.read(8) == 14 && blocks->regBank.read(10) == 0,
+          "resultado correto no motor de blocos (t0 = 14, t2 = 0)");
+    check(blocks->instruction_count == plain->instruction_count &&
+          blocks->pipeline_cycles.load() == plain->pipeline_cycles.load(),
+          "mesmas instrucoes e ciclos que o passo a passo");
+    check(blocks->block_cache.translations() == 3,
+          "blocos descobertos na carga: [0,28], [24,28] (alvo) e [32] (apos o desvio)");
+    check(blocks->block_cache.chainedTransitions() == 2, "voltas do laco seguem o encadeamento");
+    check(blocks->mem_accesses_total.load() == 0, "instrucoes nao sao buscadas da memoria");
+
+    PCB pcb;
+    MemoryManager mem(1024, 1024);
+    vector<uint32_t> words = fusionProgram();
+    pcb.block_cache.configure(0, static_cast<uint32_t>(words.size() * 4), words);
+    DiscoverBlocks(pcb.block_cache);
+    mem.write(12, makeI(0x08, 0, 10, 1), pcb);
+    uint32_t raw = 0;
+    check(pcb.block_cache.invalidations() == 1 && pcb.block_cache.find(0) == TranslatedBlock::NO_BLOCK &&
+          pcb.block_cache.find(24) != TranslatedBlock::NO_BLOCK,
+          "escrita no codigo invalida apenas o bloco que contem o endereco");
+    check(pcb.block_cache.word(12, raw) && raw == makeI(0x08, 0, 10, 1),
+          "copia do codigo atualizada para a retraducao");
+}
+
+// Executa duas instruções (addi t0 = 5; addi t0 += 1) seguidas de END ou,
+// com segmentação, de nada: o CODE cobre só as duas
+static unique_ptr<PCB> runTwoInstructions(bool segmented, bool functional) {
+    auto pcb = make_unique<PCB>();
+    pcb->quantum = 1000;
+    MemoryManager mem(1024, 1024);
+    mem.writeToFile(0, makeI(0x08, 0, 8, 5));
+    mem.writeToFile(4, makeI(0x08, 8, 8, 1));
+    if (segmented) {
+        mem.configureSegmentation(true);
+        pcb->segments.setSegment(SEG_CODE, 0, 8, true, "CODE");
+        pcb->segments.setSegment(SEG_DATA, 64, 64, false, "DATA");
+    } else {
+        mem.writeToFile(8, 0xFC000000u);  // END
+    }
+    pcb->decode_cache.configure(0, 8);
+
+    CoreOptions options;
+    if (functional) options.ff_instructions = 1000;
+    vector<unique_ptr<IORequest>> io;
+    bool printLock = false;
+    Core(mem, *pcb, &io, printLock, options);
+    return pcb;
+}
+
+void segmentFetchTest() {
+    cout << "\n=== Busca fora do segmento de codigo ===\n";
+    for (bool functional : {false, true}) {
+        auto faulted = runTwoInstructions(true, functional);
+        auto ended = runTwoInstructions(false, functional);
+        const string mode = functional ? "funcional: " : "pipeline: ";
+        check(faulted->state == State::Finished && faulted->segment_fault &&
+              faulted->segment_violations.load() >= 1 && !ended->segment_fault,
+              mode + "busca fora do CODE encerra o processo");
+        check(faulted->regBank.read(8) == ended->regBank.read(8) &&
+              faulted->instruction_count == ended->instruction_count &&
+              faulted->regBank.pc.read() == 8 && ended->regBank.pc.read() == 8,
+              mode + "para no limite do codigo, como um END ali");
+    }
+}
+
+int main() {
+    cout << "==============================================\n";
+    cout << "=== Iniciando Teste Unitario: DecodeCache ===\n";
+    cout << "==============================================\n";
+
+    predecodeTest();
+    cacheTest();
+    fusionAnalysisTest();
+    fusionExecutionTest();
+    blockEngineTest();
+    segmentFetchTest();
+
+    if (falhas > 0) {
+        cout << "\n!!! " << falhas << " verificacao(oes) falharam !!!\n";
+        return 1;
+    }
+    cout << "\n=== Todos os testes da DecodeCache passaram com sucesso! ===\n";
+    return 0;
+}
@@ -86,6 +86,29 @@ void utilsTest_Bank(){
 }
 
 
+// Função para testar o acesso por índice (caminho usado pela Control Unit)
+void indexAccessTest_Bank(){
+    cout << "\n=== Index Access Test (REGISTER_BANK) ===\n";
+    REGISTER_BANK banco;
+
+    // Índice 8 = t0, 31 = ra (convenção MIPS)
+    banco.write(8, 77);
+    banco.writeRegister("ra", 5);
+    cout << "Lendo t0 por nome apos write(8, 77): " << banco.readRegister("t0") << " (esperado: 77)\n";
+    if (banco.readRegister("t0") == 77 && banco.read(31) == 5 && string(REGISTER_BANK::gprName(8)) == "t0"){
+        cout << "  -> SUCESSO: Acesso por indice e por nome sao consistentes.\n";
+    } else{
+        throw runtime_error("acesso por indice inconsistente com acesso por nome");
+    }
+
+    banco.write(0, 123);
+    if (banco.read(0) == 0){
+        cout << "  -> SUCESSO: write(0, ...) descartado, registrador zero permanece 0.\n";
+    } else{
+        throw runtime_error("registrador zero modificado via write(0, ...)");
+    }
+}
+
 int main(){
     cout << "===============================================\n";
     cout << "=== Iniciando Teste Unitario: REGISTER_BANK ===\n";
@@ -95,6 +118,7 @@ int main(){
         basicFunctionalityTest_Bank();
         rulesAndErrorHandlingTest_Bank();
         utilsTest_Bank();
+        indexAccessTest_Bank();
 
         cout << "\n=== Todos os testes do REGISTER_BANK passaram com sucesso! ===\n";
 